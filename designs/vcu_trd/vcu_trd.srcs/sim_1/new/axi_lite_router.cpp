@@ -0,0 +1,256 @@
+/*
+ * TLM model of the vcu_axi_lite_0 interconnect.
+ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <fstream>
+
+#include "axi_lite_router.h"
+
+using namespace sc_core;
+using namespace std;
+
+static bool range_before(const axi_lite_range &a, const axi_lite_range &b)
+{
+	return a.base < b.base;
+}
+
+static bool addr_before(uint64_t addr, const axi_lite_range &r)
+{
+	return addr < r.base;
+}
+
+/* Value of attribute name in an XML element on one line, or "".  */
+static string xml_attr(const string &line, const char *name)
+{
+	string key = string(" ") + name + "=\"";
+	size_t pos = line.find(key);
+	size_t end;
+
+	if (pos == string::npos)
+		return "";
+	pos += key.size();
+	end = line.find('"', pos);
+	if (end == string::npos)
+		return "";
+	return line.substr(pos, end - pos);
+}
+
+bool axi_lite_router_load_hwh(const char *path, const char *master,
+			      vector<axi_lite_range> &ranges)
+{
+	ifstream in(path);
+	size_t n = ranges.size();
+	axi_lite_range r;
+	string line;
+
+	if (!in)
+		return false;
+
+	/* Vivado writes every MEMRANGE element on a line of its own.  */
+	while (getline(in, line)) {
+		if (line.find("<MEMRANGE ") == string::npos
+		    || xml_attr(line, "MASTERBUSINTERFACE") != master)
+			continue;
+		r.instance = xml_attr(line, "INSTANCE");
+		r.base = strtoull(xml_attr(line, "BASEVALUE").c_str(), NULL, 0);
+		r.high = strtoull(xml_attr(line, "HIGHVALUE").c_str(), NULL, 0);
+		r.port = 0;
+		if (r.instance.empty() || r.high < r.base)
+			continue;
+		ranges.push_back(r);
+	}
+	return ranges.size() > n;
+}
+
+axi_lite_router::axi_lite_router(sc_module_name name,
+				 const vector<axi_lite_range> &ranges)
+	: sc_module(name),
+	  table(ranges),
+	  target_socket("target_socket")
+{
+	vector<string>::iterator it;
+	unsigned int i;
+
+	sort(table.begin(), table.end(), range_before);
+	for (i = 0; i < table.size(); i++) {
+		if (i && table[i].base <= table[i - 1].high) {
+			SC_REPORT_ERROR(this->name(), ("address range of "
+					+ table[i].instance + " overlaps "
+					+ table[i - 1].instance).c_str());
+		}
+
+		it = find(instances.begin(), instances.end(),
+			  table[i].instance);
+		if (it != instances.end()) {
+			table[i].port = it - instances.begin();
+			continue;
+		}
+		table[i].port = instances.size();
+		instances.push_back(table[i].instance);
+		connected.push_back(false);
+		initiator_socket.push_back(
+			new tlm_utils::simple_initiator_socket_tagged<
+				axi_lite_router>(table[i].instance.c_str()));
+		initiator_socket.back()->register_invalidate_direct_mem_ptr(
+			this, &axi_lite_router::invalidate_direct_mem_ptr,
+			table[i].port);
+	}
+
+	target_socket.register_b_transport(this,
+				&axi_lite_router::b_transport);
+	target_socket.register_transport_dbg(this,
+				&axi_lite_router::transport_dbg);
+	target_socket.register_get_direct_mem_ptr(this,
+				&axi_lite_router::get_direct_mem_ptr);
+}
+
+axi_lite_router::~axi_lite_router(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < initiator_socket.size(); i++)
+		delete initiator_socket[i];
+}
+
+bool axi_lite_router::bind(const string &instance,
+			   tlm::tlm_target_socket<> &tgt)
+{
+	vector<string>::iterator it;
+	unsigned int port;
+
+	it = find(instances.begin(), instances.end(), instance);
+	if (it == instances.end()) {
+		SC_REPORT_ERROR(name(), ("no address range for "
+				+ instance).c_str());
+		return false;
+	}
+	port = it - instances.begin();
+	initiator_socket[port]->bind(tgt);
+	connected[port] = true;
+	return true;
+}
+
+void axi_lite_router::before_end_of_elaboration(void)
+{
+	tlm_utils::simple_target_socket<axi_lite_router> *tieoff_sk;
+	unsigned int i;
+
+	for (i = 0; i < initiator_socket.size(); i++) {
+		if (connected[i])
+			continue;
+		tieoff_sk = new tlm_utils::simple_target_socket<
+				axi_lite_router>();
+		initiator_socket[i]->bind(*tieoff_sk);
+	}
+}
+
+/* The range holding addr, or NULL.  */
+const axi_lite_range *axi_lite_router::decode(uint64_t addr) const
+{
+	vector<axi_lite_range>::const_iterator it;
+
+	it = upper_bound(table.begin(), table.end(), addr, addr_before);
+	if (it == table.begin())
+		return NULL;
+	--it;
+	return addr <= it->high ? &*it : NULL;
+}
+
+/*
+ * Decodes trans and rebases its address into the target's range.  On a
+ * decode error the response is set and false returned.
+ */
+bool axi_lite_router::route(tlm::tlm_generic_payload &trans,
+			    const axi_lite_range *&r)
+{
+	uint64_t addr = trans.get_address();
+	uint64_t last = addr + trans.get_data_length() - 1;
+
+	r = decode(addr);
+	if (!r || !connected[r->port] || last < addr || last > r->high) {
+		trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+		return false;
+	}
+	trans.set_address(addr - r->base);
+	return true;
+}
+
+void axi_lite_router::b_transport(tlm::tlm_generic_payload &trans,
+				  sc_time &delay)
+{
+	const axi_lite_range *r;
+
+	if (!route(trans, r))
+		return;
+	(*initiator_socket[r->port])->b_transport(trans, delay);
+	trans.set_address(trans.get_address() + r->base);
+}
+
+unsigned int axi_lite_router::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	const axi_lite_range *r;
+	unsigned int len;
+
+	if (!route(trans, r))
+		return 0;
+	len = (*initiator_socket[r->port])->transport_dbg(trans);
+	trans.set_address(trans.get_address() + r->base);
+	return len;
+}
+
+bool axi_lite_router::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+					 tlm::tlm_dmi &dmi)
+{
+	uint64_t addr = trans.get_address();
+	const axi_lite_range *r = decode(addr);
+	uint64_t start, end;
+	bool ok;
+
+	if (!r || !connected[r->port]) {
+		/* Nothing here, deny DMI for the whole hole.  */
+		if (r) {
+			dmi.set_start_address(r->base);
+			dmi.set_end_address(r->high);
+		} else {
+			dmi.set_start_address(addr);
+			dmi.set_end_address(addr);
+		}
+		return false;
+	}
+
+	trans.set_address(addr - r->base);
+	ok = (*initiator_socket[r->port])->get_direct_mem_ptr(trans, dmi);
+	trans.set_address(addr);
+
+	/* Clamp to the range first, the target may cover all of 64 bits.  */
+	start = dmi.get_start_address();
+	end = dmi.get_end_address();
+	if (end > r->high - r->base)
+		end = r->high - r->base;
+	if (start > end)
+		start = end;
+	dmi.set_start_address(r->base + start);
+	dmi.set_end_address(r->base + end);
+	return ok;
+}
+
+void axi_lite_router::invalidate_direct_mem_ptr(int id, sc_dt::uint64 start,
+						sc_dt::uint64 end)
+{
+	unsigned int i;
+	uint64_t size;
+
+	/* An instance with several ranges had DMI through any of them.  */
+	for (i = 0; i < table.size(); i++) {
+		if (table[i].port != (unsigned int) id)
+			continue;
+		size = table[i].high - table[i].base;
+		if (start > size)
+			continue;
+		target_socket->invalidate_direct_mem_ptr(table[i].base + start,
+				table[i].base + (end > size ? size : end));
+	}
+}
@@ -0,0 +1,87 @@
+/*
+ * TLM model of the vcu_axi_lite_0 interconnect.
+ *
+ * vcu_axi_lite_0 (axi_interconnect 2.1) fans M_AXI_HPM0_LPD out to the
+ * VCU, the SDI RX and TX subsystems and vcu_clk_wiz0.  The model replaces
+ * it with a plain address decoder: one target socket for the PS side and
+ * one initiator socket per slave instance.
+ *
+ * The decode table is a vector of address ranges sorted by base address
+ * and looked up with a binary search.  Ranges normally come from the
+ * MEMRANGE entries of vcu_trd.hwh that belong to a master interface (see
+ * axi_lite_router_load_hwh()).  An instance with several address blocks
+ * gets one socket for all of them.
+ *
+ * Targets see the offset into their range, as with the PS wrapper's own
+ * ports, and DMI regions and invalidations are translated back into the
+ * PS address space.  DMI regions are clamped to the range they were
+ * granted through.  Addresses outside every range, and ranges whose
+ * instance is not modelled, answer with TLM_ADDRESS_ERROR_RESPONSE, as the
+ * interconnect's DECERR would.  There is no process and no added latency.
+ */
+
+#ifndef AXI_LITE_ROUTER_H__
+#define AXI_LITE_ROUTER_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+struct axi_lite_range {
+	std::string instance;
+	uint64_t base;
+	uint64_t high;			/* inclusive */
+	unsigned int port;		/* filled in by the router */
+};
+
+/*
+ * Appends the address ranges that master, e.g. M_AXI_HPM0_LPD, sees in
+ * the hardware handoff file at path.  Returns false if the file cannot be
+ * read or has no such ranges.
+ */
+bool axi_lite_router_load_hwh(const char *path, const char *master,
+			      std::vector<axi_lite_range> &ranges);
+
+class axi_lite_router
+: public sc_core::sc_module
+{
+private:
+	std::vector<axi_lite_range> table;	/* sorted by base */
+	std::vector<std::string> instances;	/* by port */
+	std::vector<bool> connected;		/* by port */
+
+	const axi_lite_range *decode(uint64_t addr) const;
+	bool route(tlm::tlm_generic_payload &trans,
+		   const axi_lite_range *&r);
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	void invalidate_direct_mem_ptr(int id, sc_dt::uint64 start,
+				       sc_dt::uint64 end);
+public:
+	tlm_utils::simple_target_socket<axi_lite_router> target_socket;
+	std::vector<tlm_utils::simple_initiator_socket_tagged<
+		axi_lite_router> *> initiator_socket;
+
+	axi_lite_router(sc_core::sc_module_name name,
+			const std::vector<axi_lite_range> &ranges);
+	~axi_lite_router(void);
+
+	/*
+	 * Connects instance's socket to tgt.  Reports an error and returns
+	 * false if the decode table has no such instance.
+	 */
+	bool bind(const std::string &instance, tlm::tlm_target_socket<> &tgt);
+
+	/* Ties off the sockets of instances that are not modelled.  */
+	void before_end_of_elaboration(void);
+};
+
+#endif
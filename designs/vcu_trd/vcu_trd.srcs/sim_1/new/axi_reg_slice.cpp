@@ -0,0 +1,85 @@
+/*
+ * TLM model of axi_register_slice.
+ */
+
+#include "axi_reg_slice.h"
+
+using namespace sc_core;
+
+/* Register stages of one channel for a REG_* setting.  */
+static unsigned int reg_stages(unsigned int type)
+{
+	switch (type) {
+	case 0:
+		return 0;
+	case 8:
+		return 2;
+	default:
+		return 1;
+	}
+}
+
+axi_reg_slice::axi_reg_slice(sc_module_name name,
+			     const axi_reg_slice_config &cfg)
+	: sc_module(name),
+	  clk_domain(cfg.clk_domain),
+	  scope(cfg.scope),
+	  domain(NULL),
+	  period(1.0 / cfg.freq_hz, SC_SEC),
+	  target_socket("target_socket"),
+	  initiator_socket("initiator_socket")
+{
+	unsigned int aw = reg_stages(cfg.reg_aw);
+	unsigned int w = reg_stages(cfg.reg_w);
+
+	rd_stages = reg_stages(cfg.reg_ar) + reg_stages(cfg.reg_r);
+	wr_stages = (aw > w ? aw : w) + reg_stages(cfg.reg_b);
+
+	target_socket.register_b_transport(this, &axi_reg_slice::b_transport);
+	target_socket.register_transport_dbg(this,
+				&axi_reg_slice::transport_dbg);
+	target_socket.register_get_direct_mem_ptr(this,
+				&axi_reg_slice::get_direct_mem_ptr);
+	initiator_socket.register_invalidate_direct_mem_ptr(this,
+				&axi_reg_slice::invalidate_direct_mem_ptr);
+}
+
+/* Clock owners have registered their domains by now.  */
+void axi_reg_slice::end_of_elaboration(void)
+{
+	domain = clock_domains::instance(scope).find(clk_domain);
+}
+
+sc_time axi_reg_slice::latency(unsigned int stages) const
+{
+	return (domain ? domain->period : period) * (double) stages;
+}
+
+void axi_reg_slice::b_transport(tlm::tlm_generic_payload &trans,
+				sc_time &delay)
+{
+	initiator_socket->b_transport(trans, delay);
+	delay += latency(trans.is_read() ? rd_stages : wr_stages);
+}
+
+unsigned int axi_reg_slice::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return initiator_socket->transport_dbg(trans);
+}
+
+bool axi_reg_slice::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				       tlm::tlm_dmi &dmi)
+{
+	if (!initiator_socket->get_direct_mem_ptr(trans, dmi))
+		return false;
+	dmi.set_read_latency(dmi.get_read_latency() + latency(rd_stages));
+	dmi.set_write_latency(dmi.get_write_latency()
+			      + latency(wr_stages));
+	return true;
+}
+
+void axi_reg_slice::invalidate_direct_mem_ptr(sc_dt::uint64 start,
+					      sc_dt::uint64 end)
+{
+	target_socket->invalidate_direct_mem_ptr(start, end);
+}
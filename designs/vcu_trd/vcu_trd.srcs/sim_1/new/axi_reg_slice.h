@@ -0,0 +1,83 @@
+/*
+ * TLM model of axi_register_slice.
+ *
+ * The VCU data paths each go through an axi_register_slice
+ * (vcu_enc0/enc1/dec0/dec1/mcu_reg_slice) on their way to the PS.  A
+ * register slice only delays the AXI channels by a cycle per stage, so
+ * the model forwards every transaction unchanged and annotates a fixed
+ * latency per transaction: the address (or, for writes, the slower of
+ * address and first data beat) stages plus the response stage.  There is
+ * no per beat activity and no process.  DMI is passed through with the
+ * same latencies added, so DMI capable targets stay DMI capable.
+ *
+ * Channel settings use the REG_AW, REG_AR, REG_W, REG_R and REG_B codes of
+ * the IP: 0 bypass, 1 fully registered, 7 light weight (one stage, half
+ * throughput; at one address per burst the bubble is never seen), 8 SI/MI
+ * separated (two stages).  Other codes count as one stage.
+ *
+ * The stages are clocked by clk_domain when clock_domains knows it (e.g.
+ * from a clk_wiz_model), so a reprogrammed clock changes the latency of
+ * the transactions that follow; DMI latencies are those at grant time.
+ * Otherwise freq_hz is used.
+ */
+
+#ifndef AXI_REG_SLICE_H__
+#define AXI_REG_SLICE_H__
+
+#include <string>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#include "clock_domains.h"
+
+/* Defaults follow the vcu_trd_vcu_*_reg_slice_1 configuration.  */
+struct axi_reg_slice_config {
+	double freq_hz;			/* S_AXI FREQ_HZ */
+	std::string clk_domain;		/* S_AXI CLK_DOMAIN */
+	std::string scope;		/* of clk_domain in clock_domains */
+	unsigned int reg_aw;
+	unsigned int reg_ar;
+	unsigned int reg_w;
+	unsigned int reg_r;
+	unsigned int reg_b;
+
+	axi_reg_slice_config(void)
+		: freq_hz(166838609),	/* vcu_clk_wiz0 clk_out1 */
+		  clk_domain("/vcu_clk_wiz0_clk_out1"),
+		  reg_aw(7), reg_ar(7), reg_w(1), reg_r(1), reg_b(7)
+	{}
+};
+
+class axi_reg_slice
+: public sc_core::sc_module
+{
+private:
+	std::string clk_domain;
+	std::string scope;
+	const clock_domain *domain;
+	sc_core::sc_time period;
+	unsigned int rd_stages;
+	unsigned int wr_stages;
+
+	sc_core::sc_time latency(unsigned int stages) const;
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	void invalidate_direct_mem_ptr(sc_dt::uint64 start,
+				       sc_dt::uint64 end);
+public:
+	tlm_utils::simple_target_socket<axi_reg_slice> target_socket;
+	tlm_utils::simple_initiator_socket<axi_reg_slice> initiator_socket;
+
+	axi_reg_slice(sc_core::sc_module_name name,
+		      const axi_reg_slice_config &cfg = axi_reg_slice_config());
+
+	void end_of_elaboration(void);
+};
+
+#endif
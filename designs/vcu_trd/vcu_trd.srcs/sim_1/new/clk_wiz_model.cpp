@@ -0,0 +1,313 @@
+/*
+ * Dynamic reconfiguration model of the clocking wizard (clk_wiz).
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include <iostream>
+#include <sstream>
+
+#include "clk_wiz_model.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define CLK_WIZ_REG_SPACE	0x800	/* C_S_AXI_ADDR_WIDTH 11 */
+
+#define CLK_WIZ_SRR		0x000
+#define CLK_WIZ_SR		0x004
+#define CLK_WIZ_CCR0		0x200
+#define CLK_WIZ_CCR1		0x204
+#define CLK_WIZ_CLKOUT		0x208	/* 12 bytes per output */
+#define CLK_WIZ_CCR23		0x25c
+
+#define SRR_RESET_KEY		0xa
+#define SR_LOCKED		(1U << 0)
+#define CCR23_LOAD		(1U << 0)
+#define CCR23_SADDR		(1U << 1)
+
+/* MMCME4 limits, speed grade -1 and up.  */
+#define VCO_MIN_HZ		800e6
+#define VCO_MAX_HZ		1600e6
+
+/* Integer part in [7:0], thousandths from bit shift.  */
+static uint32_t encode(double v, unsigned int shift)
+{
+	uint32_t i = (uint32_t) v;
+	uint32_t f = (uint32_t) ((v - i) * 1000 + 0.5);
+
+	return (i & 0xff) | (f << shift);
+}
+
+static double decode(uint32_t r, unsigned int shift)
+{
+	return (r & 0xff) + ((r >> shift) & 0x3ff) / 1000.0;
+}
+
+clk_wiz_model::clk_wiz_model(sc_module_name name,
+			     const clk_wiz_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  is_locked(false),
+	  relock(false),
+	  reconfigs(0),
+	  failed(0),
+	  socket("socket"),
+	  locked("locked")
+{
+	unsigned int i;
+
+	sc_assert(!cfg.divide.empty()
+		  && cfg.divide.size() <= CLK_WIZ_MAX_OUTPUTS);
+	socket.register_b_transport(this, &clk_wiz_model::b_transport);
+	socket.register_transport_dbg(this, &clk_wiz_model::transport_dbg);
+
+	memset(defaults, 0, sizeof defaults);
+	default_ccr0 = (cfg.divclk & 0xff) | (encode(cfg.mult, 8) << 8);
+	for (i = 0; i < cfg.divide.size(); i++) {
+		/* Only CLKOUT0 divides by a fraction.  */
+		defaults[i][0] = encode(i ? floor(cfg.divide[i])
+					  : cfg.divide[i], 8);
+		defaults[i][2] = 50000;		/* 50.000% duty */
+	}
+	reset_regs();
+	run_ccr0 = load_ccr0 = default_ccr0;
+	for (i = 0; i < CLK_WIZ_MAX_OUTPUTS; i++)
+		run_div[i] = load_div[i] = defaults[i][0];
+
+	for (i = 0; i < cfg.divide.size(); i++) {
+		ostringstream port;
+
+		if (i >= cfg.domains.size() || cfg.domains[i].empty()) {
+			outputs.push_back(NULL);
+			continue;
+		}
+		port << this->name() << ".clk_out" << i + 1;
+		outputs.push_back(clock_domains::instance(cfg.scope).add(
+					port.str(), cfg.domains[i], freq(i)));
+	}
+
+	/* Also runs at initialization to drive the locked state out.  */
+	SC_METHOD(lock_method);
+	sensitive << drop_ev << lock_ev;
+}
+
+double clk_wiz_model::out_freq(uint32_t c0, uint32_t div,
+			       unsigned int i) const
+{
+	double d = i ? (div & 0xff) : decode(div, 8);
+
+	if ((c0 & 0xff) == 0 || d == 0)
+		return 0;
+	return cfg.in_freq_hz * decode(c0 >> 8, 8) / (c0 & 0xff) / d;
+}
+
+double clk_wiz_model::freq(unsigned int i) const
+{
+	return out_freq(run_ccr0, run_div[i], i);
+}
+
+bool clk_wiz_model::valid(uint32_t c0, const uint32_t *div) const
+{
+	unsigned int divclk = c0 & 0xff;
+	double mult = decode(c0 >> 8, 8);
+	double vco;
+	unsigned int i;
+
+	if (divclk < 1 || divclk > 106 || mult < 2 || mult > 128)
+		return false;
+	vco = cfg.in_freq_hz * mult / divclk;
+	if (vco < VCO_MIN_HZ || vco > VCO_MAX_HZ)
+		return false;
+	for (i = 0; i < cfg.divide.size(); i++) {
+		if ((div[i] & 0xff) < (i ? 1U : 2U))
+			return false;
+	}
+	return true;
+}
+
+void clk_wiz_model::reset_regs(void)
+{
+	ccr0 = default_ccr0;
+	ccr1 = 0;
+	memcpy(clkout, defaults, sizeof clkout);
+	ccr23 = 0;
+}
+
+/*
+ * Reprograms the MMCM with the registers (user) or the defaults.  Lock
+ * drops at once; the outputs change when it comes back.
+ */
+void clk_wiz_model::start_load(bool user, const sc_time &delay)
+{
+	unsigned int i;
+
+	load_ccr0 = user ? ccr0 : default_ccr0;
+	for (i = 0; i < CLK_WIZ_MAX_OUTPUTS; i++)
+		load_div[i] = user ? clkout[i][0] : defaults[i][0];
+
+	/*
+	 * This runs in the initiator's thread, so only the state changes
+	 * here; lock_method drives the port.
+	 */
+	is_locked = false;
+	relock = false;
+	drop_ev.notify(delay);
+	/* A pending lock from an earlier load would be the earlier event.  */
+	lock_ev.cancel();
+	if (!valid(load_ccr0, load_div)) {
+		ostringstream msg;
+
+		msg << "CCR0 0x" << hex << load_ccr0
+		    << " puts the MMCM out of range, it will not lock";
+		SC_REPORT_WARNING(name(), msg.str().c_str());
+		failed++;
+		return;
+	}
+	relock = true;
+	lock_at = sc_time_stamp() + delay + cfg.lock_time;
+	lock_ev.notify(delay + cfg.lock_time);
+}
+
+/* Pushes the running frequencies to the clock domains.  */
+void clk_wiz_model::apply(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < outputs.size(); i++) {
+		if (outputs[i])
+			clock_domains::instance(cfg.scope).set_freq(
+				outputs[i]->name, freq(i));
+	}
+}
+
+/* The only writer of locked.  */
+void clk_wiz_model::lock_method(void)
+{
+	if (relock && sc_time_stamp() >= lock_at) {
+		run_ccr0 = load_ccr0;
+		memcpy(run_div, load_div, sizeof run_div);
+		apply();
+		reconfigs++;
+		relock = false;
+		is_locked = true;
+	}
+	locked.write(is_locked);
+}
+
+void clk_wiz_model::start_of_simulation(void)
+{
+	/* Comes out of configuration locked, at the default frequencies.  */
+	apply();
+	is_locked = true;
+}
+
+uint32_t clk_wiz_model::reg_read(uint32_t offset)
+{
+	uint32_t r;
+
+	switch (offset) {
+	case CLK_WIZ_SR:
+		return is_locked ? SR_LOCKED : 0;
+	case CLK_WIZ_CCR0:
+		return ccr0;
+	case CLK_WIZ_CCR1:
+		return ccr1;
+	case CLK_WIZ_CCR23:
+		return ccr23;
+	}
+	if (offset >= CLK_WIZ_CLKOUT && offset < CLK_WIZ_CCR23) {
+		r = (offset - CLK_WIZ_CLKOUT) / 4;
+		return clkout[r / 3][r % 3];
+	}
+	return 0;
+}
+
+void clk_wiz_model::reg_write(uint32_t offset, uint32_t val,
+			      const sc_time &delay)
+{
+	uint32_t r;
+
+	switch (offset) {
+	case CLK_WIZ_SRR:
+		if (val == SRR_RESET_KEY) {
+			reset_regs();
+			start_load(false, delay);
+		}
+		return;
+	case CLK_WIZ_CCR0:
+		ccr0 = val & 0x3ffffff;
+		return;
+	case CLK_WIZ_CCR1:
+		ccr1 = val;
+		return;
+	case CLK_WIZ_CCR23:
+		/* LOAD is self clearing.  */
+		ccr23 = val & CCR23_SADDR;
+		if (val & CCR23_LOAD)
+			start_load(val & CCR23_SADDR, delay);
+		return;
+	}
+	if (offset >= CLK_WIZ_CLKOUT && offset < CLK_WIZ_CCR23) {
+		r = (offset - CLK_WIZ_CLKOUT) / 4;
+		clkout[r / 3][r % 3] = val;
+	}
+}
+
+/* Side effects only happen for non-debug accesses.  */
+bool clk_wiz_model::access(tlm::tlm_generic_payload &trans, bool debug,
+			   const sc_time &delay)
+{
+	uint32_t offset = trans.get_address() & (CLK_WIZ_REG_SPACE - 1);
+	unsigned char *data = trans.get_data_ptr();
+	uint32_t v;
+
+	if (trans.get_byte_enable_ptr()) {
+		trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+		return false;
+	}
+	if (trans.get_data_length() != 4 || (offset & 3)) {
+		trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+		return false;
+	}
+
+	if (trans.is_read()) {
+		v = reg_read(offset);
+		memcpy(data, &v, 4);
+	} else if (!debug) {
+		memcpy(&v, data, 4);
+		reg_write(offset, v, delay);
+	}
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+	return true;
+}
+
+void clk_wiz_model::b_transport(tlm::tlm_generic_payload &trans,
+				sc_time &delay)
+{
+	/* Lock time counts from the initiator's local time.  */
+	access(trans, false, delay);
+	delay += cfg.access_latency;
+}
+
+unsigned int clk_wiz_model::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return access(trans, true, SC_ZERO_TIME) ?
+	       trans.get_data_length() : 0;
+}
+
+void clk_wiz_model::end_of_simulation(void)
+{
+	unsigned int i;
+
+	cout << name() << ": " << reconfigs << " reconfigurations, "
+	     << failed << " out of range, "
+	     << (is_locked ? "locked" : "not locked") << "\n";
+	for (i = 0; i < cfg.divide.size(); i++) {
+		cout << "  clk_out" << i + 1 << " " << freq(i) / 1e6 << " MHz";
+		if (outputs[i])
+			cout << " (" << outputs[i]->name << ")";
+		cout << "\n";
+	}
+}
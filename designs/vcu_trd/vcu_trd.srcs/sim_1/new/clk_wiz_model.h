@@ -0,0 +1,135 @@
+/*
+ * Dynamic reconfiguration model of the clocking wizard (clk_wiz).
+ *
+ * Stands in for vcu_clk_wiz0, the MMCM that clocks the VCU: clk_out1 is
+ * the 33 MHz VCU PLL reference and clk_out2 the 166.8 MHz AXI clock of
+ * the VCU ports and their register slices.  Its AXI4-Lite registers sit
+ * at 0x80110000 (64 KiB) behind vcu_axi_lite_0 and are laid out as
+ * xclk_wiz_hw.h expects:
+ *
+ *   0x000  SRR     write 0xa to reset the registers and relock
+ *   0x004  SR      bit 0 locked
+ *   0x200  CCR0    [7:0] DIVCLK_DIVIDE, [15:8] CLKFBOUT_MULT,
+ *                  [25:16] CLKFBOUT_FRAC (1/1000)
+ *   0x204  CCR1    CLKFBOUT_PHASE, stored
+ *   0x208 + 12*i   CLKOUTi_DIVIDE: [7:0] divide, [17:8] fraction (1/1000,
+ *                  CLKOUT0 only); then CLKOUTi_PHASE and _DUTY, stored
+ *   0x25c  CCR23   bit 0 LOAD, bit 1 SADDR: 1 loads the values above,
+ *                  0 the defaults
+ *
+ * A load (or reset) drops lock and the outputs keep their old frequency
+ * until the MMCM relocks lock_time later.  Then every output runs at
+ *
+ *   in_freq * (CLKFBOUT_MULT + FRAC / 1000) / DIVCLK_DIVIDE / CLKOUTi_DIVIDE
+ *
+ * and the clock domain it drives is updated in clock_domains.  Nothing is
+ * notified: consumers (beat_timing taps, axi_reg_slice models, ...) read
+ * the period each time they time a transfer, so the new one applies from
+ * their next transfer on.  A configuration that puts the VCO outside
+ * 800-1600 MHz never locks.  Clock monitor registers read as zero.
+ */
+
+#ifndef CLK_WIZ_MODEL_H__
+#define CLK_WIZ_MODEL_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#include "clock_domains.h"
+
+#define CLK_WIZ_MAX_OUTPUTS	7
+
+/* Defaults follow the vcu_trd_vcu_clk_wiz0_1 configuration.  */
+struct clk_wiz_config {
+	double in_freq_hz;		/* C_PRIM_IN_FREQ */
+	unsigned int divclk;		/* C_MMCM_DIVCLK_DIVIDE */
+	double mult;			/* C_MMCM_CLKFBOUT_MULT_F */
+	std::vector<double> divide;	/* C_MMCM_CLKOUT<i>_DIVIDE(_F) */
+	/* Clock domain each output drives, "" for none, in scope.  */
+	std::vector<std::string> domains;
+	std::string scope;
+	sc_core::sc_time lock_time;	/* MMCM T_LOCK */
+	sc_core::sc_time access_latency;
+
+	clk_wiz_config(void)
+		: in_freq_hz(99.999e6),
+		  divclk(8),
+		  mult(120.125),
+		  lock_time(100, sc_core::SC_US),
+		  access_latency(20, sc_core::SC_NS)
+	{
+		divide.push_back(45.5);		/* clk_out1, pll_ref_clk */
+		divide.push_back(9);		/* clk_out2, VCU AXI */
+		domains.push_back("");
+		/* The CLK_DOMAIN Vivado gives the ports clk_out2 clocks.  */
+		domains.push_back("/vcu_clk_wiz0_clk_out1");
+	}
+};
+
+class clk_wiz_model
+: public sc_core::sc_module
+{
+private:
+	clk_wiz_config cfg;
+	std::vector<clock_domain *> outputs;	/* by output, or NULL */
+
+	/* Registers.  */
+	uint32_t ccr0;
+	uint32_t ccr1;
+	uint32_t clkout[CLK_WIZ_MAX_OUTPUTS][3];
+	uint32_t ccr23;
+	uint32_t default_ccr0;
+	uint32_t defaults[CLK_WIZ_MAX_OUTPUTS][3];
+
+	/* Configuration the outputs run at, and the one being locked to.  */
+	uint32_t run_ccr0;
+	uint32_t run_div[CLK_WIZ_MAX_OUTPUTS];
+	uint32_t load_ccr0;
+	uint32_t load_div[CLK_WIZ_MAX_OUTPUTS];
+	bool is_locked;
+	/* A load is pending and locks at lock_at.  */
+	bool relock;
+	sc_core::sc_time lock_at;
+	/* lock_method drives locked; these wake it to drop or relock.  */
+	sc_core::sc_event drop_ev;
+	sc_core::sc_event lock_ev;
+
+	uint64_t reconfigs;
+	uint64_t failed;
+
+	double out_freq(uint32_t c0, uint32_t div, unsigned int i) const;
+	bool valid(uint32_t c0, const uint32_t *div) const;
+	void apply(void);
+
+	void reset_regs(void);
+	void start_load(bool user, const sc_core::sc_time &delay);
+	void lock_method(void);
+
+	uint32_t reg_read(uint32_t offset);
+	void reg_write(uint32_t offset, uint32_t val,
+		       const sc_core::sc_time &delay);
+	bool access(tlm::tlm_generic_payload &trans, bool debug,
+		    const sc_core::sc_time &delay);
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+public:
+	tlm_utils::simple_target_socket<clk_wiz_model> socket;
+	sc_core::sc_out<bool> locked;
+
+	SC_HAS_PROCESS(clk_wiz_model);
+	clk_wiz_model(sc_core::sc_module_name name,
+		      const clk_wiz_config &cfg = clk_wiz_config());
+
+	/* Current frequency of output i (clk_out<i+1>).  */
+	double freq(unsigned int i) const;
+
+	void start_of_simulation(void);
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,748 @@
+/*
+ * Multi-instance co-simulation launcher.
+ *
+ * Fans a regression list out across N independent ZynqMP PS instances
+ * living in one SystemC process, each connected to its own QEMU through
+ * its own remote-port endpoint.
+ *
+ * Regression list, one test per line:
+ *
+ *   # name        endpoint                          command line...
+ *   dec_4k60_0    unix:/tmp/cosim/dec0/qemu-rport   qemu-system-aarch64 ...
+ *
+ * The command is started through /bin/sh with COSIM_MACHINE_TCPIP_ADDRESS
+ * set to the test's endpoint.  A test without one is reported as an error.
+ *
+ * Each slot is a vcu_trd_zynq_ultra_ps_e_0_1, the generated PS wrapper,
+ * given its endpoint and *_TLM_MODE=1 for all its AXI ports as instance
+ * parameters.
+ *
+ * SystemC cannot elaborate twice in one process, so tests are run in
+ * batches of -j instances, one forked process per batch.  Files passed
+ * with --shared are mapped read-only before forking and are shared by all
+ * slots and batches.
+ *
+ * With --vcu-enc every slot also gets a vcu_enc_traffic model on HP0/HP1
+ * standing in for the VCU encoder, with --vcu-dec a vcu_dec_traffic model
+ * on HP2/HP3 standing in for the decoder and with --vcu-mcu a
+ * vcu_mcu_fetch model on HPC0 standing in for the MCU.  --vcu-regs puts
+ * the vcu_reg_model at 0x80000000, with its interrupt on pl_ps_irq0[0]
+ * through an irq_concat standing in for the vcu_interrupt xlconcat.
+ * --sdi-rx MODE:SOURCE adds a free running sdi_rx_model (for example
+ * 2160p60:bars or 1080p60:clip.y4m) streaming into an sdi_null_sink, with
+ * its control registers at 0x80100000.  The RX video and interrupt ports
+ * are not connected in vcu_trd, so this is a throughput harness for the
+ * model and whatever is put behind it.  With --sdi-loop the RX streams
+ * into an sdi_tx_model in the same mode instead, which checks the stream
+ * against the TX raster; its control registers are at 0x80120000 and it
+ * starts enabled.
+ *
+ * These register models sit behind an axi_lite_router standing in for
+ * vcu_axi_lite_0 on HPM0_LPD.  Its decode table is read from the
+ * M_AXI_HPM0_LPD address map of the hardware handoff given with --hwh
+ * (vcu_trd.hwh), or else is the vcu_trd map built in below.  Accesses to
+ * slaves that are not modelled get a decode error.
+ *
+ * --clk-wiz adds a clk_wiz_model of vcu_clk_wiz0 at 0x80110000.  Software
+ * that reprograms it changes the clock of the slot's register slices
+ * once the MMCM has relocked.
+ *
+ * --eth PORT adds a pcs_pma_model of gig_ethernet_pcs_pma_0 with the GEM
+ * in QEMU on its GMII side, through an eth_udp_netdev.  Slot i binds
+ * 127.0.0.1:PORT+2i and sends to PORT+2i+1; the command gets them as
+ * COSIM_ETH_UDP and COSIM_ETH_LOCALADDR, for
+ *
+ *   -netdev socket,id=eth0,udp=$COSIM_ETH_UDP,localaddr=$COSIM_ETH_LOCALADDR
+ *
+ * The link partner is an eth_pcap_sink that reports the RTP throughput
+ * it sees and, with --eth-pcap, writes <test>.pcap.  --eth-loopback puts
+ * the PCS/PMA in loopback instead and --eth-sgmii selects SGMII rather
+ * than 1000BASE-X.
+ *
+ * The VCU models reach the PS through axi_reg_slice models of
+ * vcu_enc0_reg_slice, vcu_enc1_reg_slice, vcu_dec0_reg_slice,
+ * vcu_dec1_reg_slice and vcu_mcu_reg_slice, as in the block design.
+ * --tlm-mode <instance>_TLM_MODE=0 leaves a slice out and binds the model
+ * straight to the PS; TLM_MODE=0 does so for all of them.
+ *
+ * Usage: cosim_farm [-j N] [-t ms] [--shared file]... [--vcu-enc]
+ *                   [--vcu-dec] [--vcu-mcu] [--vcu-regs]
+ *                   [--sdi-rx MODE:SOURCE] [--sdi-loop] [--clk-wiz]
+ *                   [--eth PORT] [--eth-pcap] [--eth-loopback]
+ *                   [--eth-sgmii]
+ *                   [--tlm-mode NAME=N]... [--hwh file]
+ *                   regression.list
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include <inttypes.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+using namespace sc_core;
+using namespace std;
+
+#include "cosim_farm.h"
+#include "axi_lite_router.h"
+#include "axi_reg_slice.h"
+#include "clk_wiz_model.h"
+#include "eth_link.h"
+#include "irq_concat.h"
+#include "vcu_enc_traffic.h"
+#include "vcu_dec_traffic.h"
+#include "vcu_mcu_fetch.h"
+#include "vcu_reg_model.h"
+#include "pcs_pma_model.h"
+#include "sdi_rx_model.h"
+#include "sdi_tx_model.h"
+
+struct cosim_test {
+	string name;
+	string endpoint;
+	string cmd;
+};
+
+/* PL side traffic models attached to every slot.  */
+struct cosim_models {
+	bool vcu_enc;
+	bool vcu_dec;
+	bool vcu_mcu;
+	bool vcu_regs;
+	bool sdi_rx;
+	bool sdi_loop;
+	bool clk_wiz;
+	unsigned int eth_port;		/* 0: no Ethernet */
+	bool eth_pcap;
+	sdi_rx_config sdi_rx_cfg;
+	pcs_pma_config pcs_cfg;
+	map<string, int> tlm_modes;	/* from --tlm-mode */
+	vector<axi_lite_range> lpd_map;	/* vcu_axi_lite_0 decode */
+};
+
+/* M_AXI_HPM0_LPD address map of vcu_trd.hwh.  */
+static const struct {
+	const char *instance;
+	uint64_t base;
+	uint64_t high;
+} vcu_trd_lpd_map[] = {
+	{ "vcu_0",			0x80000000, 0x800fffff },
+	{ "v_smpte_uhdsdi_rx_ss_0",	0x80100000, 0x8010ffff },
+	{ "vcu_clk_wiz0",		0x80110000, 0x8011ffff },
+	{ "v_smpte_uhdsdi_tx_ss_0",	0x80120000, 0x8013ffff },
+};
+
+struct shared_file {
+	const void *data;
+	size_t len;
+};
+
+static map<string, shared_file> shared_files;
+
+/* The wrapper's AXI ports, all used at TLM level.  */
+static const char *const ps_axi_ports[] = {
+	"M_AXI_HPM0_LPD", "S_AXI_HPC0_FPD", "S_AXI_HP0_FPD", "S_AXI_HP1_FPD",
+	"S_AXI_HP2_FPD", "S_AXI_HP3_FPD",
+};
+
+xsc::common::properties cosim_slot::instance_props(const char *sk_descr)
+{
+	xsc::common::properties props;
+	unsigned int i;
+
+	props._string_property_map["COSIM_MACHINE_TCPIP_ADDRESS"] = sk_descr;
+	for (i = 0; i < sizeof ps_axi_ports / sizeof ps_axi_ports[0]; i++)
+		props._long_property_map[string(ps_axi_ports[i])
+					 + "_TLM_MODE"] = 1;
+	return props;
+}
+
+/* Binds obj to a signal of its own if it is an sc_in<T> or sc_out<T>.  */
+template<typename T>
+bool cosim_slot::bind_pin(sc_object *obj)
+{
+	sc_in<T> *in = dynamic_cast<sc_in<T> *>(obj);
+	sc_out<T> *out = dynamic_cast<sc_out<T> *>(obj);
+	sc_signal<T> *sig;
+
+	if (!in && !out)
+		return false;
+	sig = new sc_signal<T>(obj->basename());
+	if (in)
+		in->bind(*sig);
+	else
+		out->bind(*sig);
+	return true;
+}
+
+cosim_slot::cosim_slot(sc_module_name name, const char *sk_descr)
+	: sc_module(name),
+	  ps("ps", instance_props(sk_descr)),
+	  irq("vcu_interrupt"),
+	  hpc0_fpd_used(false),
+	  hpm0_lpd_used(false)
+{
+	vector<sc_object *> pins = ps.get_child_objects();
+	unsigned int i;
+
+	hpc0_fpd = new xtlm::xaximm_tlm2xtlm("S_AXI_HPC0_FPD_tlm2xtlm", 32);
+	hpc0_fpd->wr_socket->bind(*ps.S_AXI_HPC0_FPD_wr_socket);
+	hpc0_fpd->rd_socket->bind(*ps.S_AXI_HPC0_FPD_rd_socket);
+
+	hp_fpd[0] = new xtlm::xaximm_tlm2xtlm("S_AXI_HP0_FPD_tlm2xtlm", 128);
+	hp_fpd[0]->wr_socket->bind(*ps.S_AXI_HP0_FPD_wr_socket);
+	hp_fpd[0]->rd_socket->bind(*ps.S_AXI_HP0_FPD_rd_socket);
+	hp_fpd[1] = new xtlm::xaximm_tlm2xtlm("S_AXI_HP1_FPD_tlm2xtlm", 128);
+	hp_fpd[1]->wr_socket->bind(*ps.S_AXI_HP1_FPD_wr_socket);
+	hp_fpd[1]->rd_socket->bind(*ps.S_AXI_HP1_FPD_rd_socket);
+	hp_fpd[2] = new xtlm::xaximm_tlm2xtlm("S_AXI_HP2_FPD_tlm2xtlm", 128);
+	hp_fpd[2]->wr_socket->bind(*ps.S_AXI_HP2_FPD_wr_socket);
+	hp_fpd[2]->rd_socket->bind(*ps.S_AXI_HP2_FPD_rd_socket);
+	hp_fpd[3] = new xtlm::xaximm_tlm2xtlm("S_AXI_HP3_FPD_tlm2xtlm", 128);
+	hp_fpd[3]->wr_socket->bind(*ps.S_AXI_HP3_FPD_wr_socket);
+	hp_fpd[3]->rd_socket->bind(*ps.S_AXI_HP3_FPD_rd_socket);
+	for (i = 0; i < 4; i++)
+		hp_fpd_used[i] = false;
+
+	hpm0_lpd = new xtlm::xaximm_xtlm2tlm("M_AXI_HPM0_LPD_xtlm2tlm", 32);
+	ps.M_AXI_HPM0_LPD_wr_socket->bind(*hpm0_lpd->wr_socket);
+	ps.M_AXI_HPM0_LPD_rd_socket->bind(*hpm0_lpd->rd_socket);
+
+	/* zynq_ultra_ps_e_tlm lets irq drive pl2ps_irq directly.  */
+	ps.pl_ps_irq0(irq);
+	for (i = 0; i < pins.size(); i++) {
+		if (pins[i] == &ps.pl_ps_irq0)
+			continue;
+		bind_pin<bool>(pins[i])
+			|| bind_pin<sc_dt::sc_bv<1> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<2> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<3> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<4> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<6> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<8> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<16> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<32> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<40> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<49> >(pins[i])
+			|| bind_pin<sc_dt::sc_bv<128> >(pins[i]);
+	}
+}
+
+tlm::tlm_target_socket<> &cosim_slot::s_axi_hpc0_fpd(void)
+{
+	hpc0_fpd_used = true;
+	return hpc0_fpd->target_socket;
+}
+
+tlm::tlm_target_socket<> &cosim_slot::s_axi_hp_fpd(unsigned int i)
+{
+	sc_assert(i < 4);
+	hp_fpd_used[i] = true;
+	return hp_fpd[i]->target_socket;
+}
+
+tlm::tlm_initiator_socket<> &cosim_slot::m_axi_hpm0_lpd(void)
+{
+	hpm0_lpd_used = true;
+	return hpm0_lpd->initiator_socket;
+}
+
+/* Nothing behind an unused M_AXI_HPM0_LPD.  */
+void cosim_slot::tieoff_b_transport(tlm::tlm_generic_payload &trans,
+				    sc_time &delay)
+{
+	trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+}
+
+/* Models bind to the slot during elaboration, tie off what is left.  */
+void cosim_slot::before_end_of_elaboration(void)
+{
+	tlm_utils::simple_initiator_socket<cosim_slot> *tieoff_init;
+	tlm_utils::simple_target_socket<cosim_slot> *tieoff_tgt;
+	unsigned int i;
+
+	if (!hpc0_fpd_used) {
+		tieoff_init = new tlm_utils::simple_initiator_socket<
+			cosim_slot>();
+		tieoff_init->bind(hpc0_fpd->target_socket);
+	}
+	for (i = 0; i < 4; i++) {
+		if (hp_fpd_used[i])
+			continue;
+		tieoff_init = new tlm_utils::simple_initiator_socket<
+			cosim_slot>();
+		tieoff_init->bind(hp_fpd[i]->target_socket);
+	}
+	if (!hpm0_lpd_used) {
+		tieoff_tgt = new tlm_utils::simple_target_socket<cosim_slot>();
+		tieoff_tgt->register_b_transport(this,
+			&cosim_slot::tieoff_b_transport);
+		hpm0_lpd->initiator_socket.bind(*tieoff_tgt);
+	}
+}
+
+const void *cosim_farm_shared(const char *path, size_t *len)
+{
+	map<string, shared_file>::const_iterator it;
+
+	it = shared_files.find(path);
+	if (it == shared_files.end())
+		return NULL;
+	if (len)
+		*len = it->second.len;
+	return it->second.data;
+}
+
+static bool map_shared(const char *path)
+{
+	struct stat st;
+	shared_file f;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		perror(path);
+		return false;
+	}
+	if (fstat(fd, &st) < 0) {
+		perror(path);
+		close(fd);
+		return false;
+	}
+	f.len = st.st_size;
+	f.data = mmap(NULL, f.len, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (f.data == MAP_FAILED) {
+		perror(path);
+		return false;
+	}
+	shared_files[path] = f;
+	return true;
+}
+
+static bool parse_list(const char *path, vector<cosim_test> &tests)
+{
+	ifstream in(path);
+	string line;
+	unsigned int lineno = 0;
+
+	if (!in) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+
+	while (getline(in, line)) {
+		istringstream ss(line);
+		cosim_test t;
+
+		lineno++;
+		if (!(ss >> t.name) || t.name[0] == '#')
+			continue;
+		if (!(ss >> t.endpoint)) {
+			fprintf(stderr, "%s:%u: missing endpoint for %s\n",
+				path, lineno, t.name.c_str());
+			return false;
+		}
+		getline(ss >> ws, t.cmd);
+		tests.push_back(t);
+	}
+	return true;
+}
+
+static pid_t spawn_cmd(const cosim_test &t, const eth_udp_config *eth)
+{
+	pid_t pid;
+
+	if (t.cmd.empty())
+		return -1;
+
+	pid = fork();
+	if (pid == 0) {
+		setenv("COSIM_MACHINE_TCPIP_ADDRESS", t.endpoint.c_str(), 1);
+		if (eth) {
+			/* QEMU's side of the socket is the other way round.  */
+			setenv("COSIM_ETH_UDP", eth->local.c_str(), 1);
+			setenv("COSIM_ETH_LOCALADDR", eth->remote.c_str(), 1);
+		}
+		execl("/bin/sh", "sh", "-c", t.cmd.c_str(), (char *) NULL);
+		_exit(127);
+	}
+	if (pid < 0)
+		perror(t.name.c_str());
+	return pid;
+}
+
+/* Slot addresses for --eth.  */
+static string udp_addr(unsigned int port)
+{
+	ostringstream addr;
+
+	addr << "127.0.0.1:" << port;
+	return addr.str();
+}
+
+/* <instance>_TLM_MODE, else TLM_MODE, else 1.  */
+static int tlm_mode(const cosim_models &models, const string &instance)
+{
+	map<string, int>::const_iterator it;
+
+	it = models.tlm_modes.find(instance + "_TLM_MODE");
+	if (it == models.tlm_modes.end())
+		it = models.tlm_modes.find("TLM_MODE");
+	return it == models.tlm_modes.end() ? 1 : it->second;
+}
+
+/* Binds a VCU port to the PS through its register slice, if modelled.  */
+template<typename INIT, typename TGT>
+static void bind_reg_slice(const cosim_models &models, const string &test,
+			   const char *slice, INIT &init, TGT &tgt)
+{
+	axi_reg_slice_config cfg;
+	axi_reg_slice *rs;
+
+	if (tlm_mode(models, slice) == 0) {
+		init.bind(tgt);
+		return;
+	}
+	/* Each slot has its own vcu_clk_wiz0, in the slot's scope.  */
+	cfg.scope = test;
+	rs = new axi_reg_slice((test + "_" + slice).c_str(), cfg);
+	init.bind(rs->target_socket);
+	rs->initiator_socket.bind(tgt);
+}
+
+/*
+ * Runs one batch inside a freshly forked process.
+ * Returns the number of failed tests.
+ */
+static int run_batch(const vector<cosim_test> &tests, size_t first,
+		     size_t count, double limit_ms,
+		     const cosim_models &models)
+{
+	vector<cosim_slot *> slots;
+	vector<pid_t> pids;
+	axi_lite_router *lpd;
+	int failed = 0;
+	size_t i;
+
+	for (i = 0; i < count; i++) {
+		const cosim_test &t = tests[first + i];
+		eth_udp_config eth_cfg;
+
+		if (models.eth_port) {
+			eth_cfg.local = udp_addr(models.eth_port + 2 * i);
+			eth_cfg.remote = udp_addr(models.eth_port + 2 * i + 1);
+		}
+		pids.push_back(spawn_cmd(t, models.eth_port ? &eth_cfg : NULL));
+		slots.push_back(new cosim_slot(t.name.c_str(),
+					       t.endpoint.c_str()));
+
+		if (models.vcu_enc) {
+			string name = t.name + "_vcu_enc";
+			vcu_enc_traffic *enc;
+
+			enc = new vcu_enc_traffic(name.c_str());
+			bind_reg_slice(models, t.name, "vcu_enc0_reg_slice",
+				       enc->enc_data0,
+				       slots.back()->s_axi_hp_fpd(0));
+			bind_reg_slice(models, t.name, "vcu_enc1_reg_slice",
+				       enc->enc_data1,
+				       slots.back()->s_axi_hp_fpd(1));
+		}
+		if (models.vcu_dec) {
+			string name = t.name + "_vcu_dec";
+			vcu_dec_traffic *dec;
+
+			dec = new vcu_dec_traffic(name.c_str());
+			bind_reg_slice(models, t.name, "vcu_dec0_reg_slice",
+				       dec->dec_data0,
+				       slots.back()->s_axi_hp_fpd(2));
+			bind_reg_slice(models, t.name, "vcu_dec1_reg_slice",
+				       dec->dec_data1,
+				       slots.back()->s_axi_hp_fpd(3));
+		}
+		if (models.vcu_mcu) {
+			string name = t.name + "_vcu_mcu";
+			vcu_mcu_fetch *mcu;
+
+			mcu = new vcu_mcu_fetch(name.c_str());
+			bind_reg_slice(models, t.name, "vcu_mcu_reg_slice",
+				       mcu->code_socket,
+				       slots.back()->s_axi_hpc0_fpd());
+		}
+		lpd = NULL;
+		if (models.vcu_regs || models.sdi_rx || models.clk_wiz) {
+			string name = t.name + "_vcu_axi_lite_0";
+
+			lpd = new axi_lite_router(name.c_str(), models.lpd_map);
+			slots.back()->m_axi_hpm0_lpd().bind(
+				lpd->target_socket);
+		}
+		if (models.vcu_regs) {
+			string name = t.name + "_vcu_regs";
+			vcu_reg_model *regs;
+
+			regs = new vcu_reg_model(name.c_str());
+			lpd->bind("vcu_0", regs->socket);
+			regs->irq(slots.back()->irq.in(0));
+		}
+		if (models.clk_wiz) {
+			string name = t.name + "_vcu_clk_wiz0";
+			clk_wiz_config cfg;
+			clk_wiz_model *wiz;
+
+			cfg.scope = t.name;
+			wiz = new clk_wiz_model(name.c_str(), cfg);
+			lpd->bind("vcu_clk_wiz0", wiz->socket);
+			wiz->locked(*new sc_signal<bool>((name
+							 + "_locked").c_str()));
+		}
+		if (models.eth_port) {
+			string name = t.name + "_gig_ethernet_pcs_pma_0";
+			pcs_pma_model *pcs;
+			eth_udp_netdev *gem;
+			eth_pcap_sink *partner;
+
+			pcs = new pcs_pma_model(name.c_str(), models.pcs_cfg);
+			gem = new eth_udp_netdev((t.name + "_gem").c_str(),
+						 eth_cfg);
+			gem->tx.bind(pcs->gmii_tx);
+			pcs->gmii_rx.bind(gem->rx);
+			partner = new eth_pcap_sink((t.name + "_link").c_str(),
+						    models.eth_pcap ?
+						    t.name + ".pcap" : "");
+			pcs->phy_tx.bind(partner->socket);
+		}
+		if (models.sdi_rx) {
+			string name = t.name + "_sdi_rx";
+			sdi_rx_model *rx;
+
+			rx = new sdi_rx_model(name.c_str(), models.sdi_rx_cfg);
+			lpd->bind("v_smpte_uhdsdi_rx_ss_0", rx->ctrl);
+			rx->irq(*new sc_signal<bool>((name + "_irq").c_str()));
+
+			if (models.sdi_loop) {
+				string tx_name = t.name + "_sdi_tx";
+				sdi_tx_config tx_cfg;
+				sdi_tx_model *tx;
+
+				tx_cfg.mode = models.sdi_rx_cfg.mode;
+				tx_cfg.autostart = true;
+				tx = new sdi_tx_model(tx_name.c_str(), tx_cfg);
+				rx->video_out.bind(tx->video_in);
+				lpd->bind("v_smpte_uhdsdi_tx_ss_0", tx->ctrl);
+				tx->irq(*new sc_signal<bool>((tx_name
+							     + "_irq").c_str()));
+			} else {
+				sdi_null_sink *sink;
+
+				sink = new sdi_null_sink((name + "_sink").c_str());
+				rx->video_out.bind(sink->socket);
+			}
+		}
+	}
+
+	if (limit_ms > 0)
+		sc_start(sc_time(limit_ms, SC_MS));
+	else
+		sc_start();
+	/*
+	 * sc_start() only pauses; stopping runs end_of_simulation, which is
+	 * where the models write their reports, traces and captures.
+	 */
+	if (sc_get_status() != SC_STOPPED)
+		sc_stop();
+
+	for (i = 0; i < count; i++) {
+		const cosim_test &t = tests[first + i];
+		int status = 0;
+
+		if (pids[i] > 0) {
+			if (waitpid(pids[i], &status, WNOHANG) == 0) {
+				kill(pids[i], SIGTERM);
+				waitpid(pids[i], &status, 0);
+			}
+		}
+		if (t.cmd.empty()) {
+			failed++;
+			printf("ERROR %s: no command\n", t.name.c_str());
+		} else if (pids[i] < 0) {
+			failed++;
+			printf("ERROR %s\n", t.name.c_str());
+		} else if (!(WIFEXITED(status) && WEXITSTATUS(status) == 0)) {
+			failed++;
+			printf("FAIL %s\n", t.name.c_str());
+		} else {
+			printf("PASS %s\n", t.name.c_str());
+		}
+	}
+	fflush(stdout);
+	return failed;
+}
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s [-j N] [-t ms] [--shared file]... [--vcu-enc]\n"
+		"          [--vcu-dec] [--vcu-mcu] [--vcu-regs]\n"
+		"          [--sdi-rx MODE:SOURCE] [--sdi-loop] [--clk-wiz]\n"
+		"          [--eth PORT] [--eth-pcap] [--eth-loopback]\n"
+		"          [--eth-sgmii]\n"
+		"          [--tlm-mode NAME=N]... [--hwh file]\n"
+		"          regression.list\n",
+		prog);
+}
+
+int sc_main(int argc, char *argv[])
+{
+	vector<cosim_test> tests;
+	cosim_models models;
+	axi_lite_range r;
+	const char *list = NULL;
+	const char *hwh = NULL;
+	unsigned int jobs = 4;
+	double limit_ms = 0;
+	int failed = 0;
+	size_t first;
+	int i;
+
+	models.vcu_enc = false;
+	models.vcu_dec = false;
+	models.vcu_mcu = false;
+	models.vcu_regs = false;
+	models.sdi_rx = false;
+	models.sdi_loop = false;
+	models.clk_wiz = false;
+	models.eth_port = 0;
+	models.eth_pcap = false;
+
+	for (i = 1; i < argc; i++) {
+		string arg = argv[i];
+
+		if (arg == "-j" && i + 1 < argc) {
+			jobs = strtoul(argv[++i], NULL, 0);
+		} else if (arg == "-t" && i + 1 < argc) {
+			limit_ms = strtod(argv[++i], NULL);
+		} else if (arg == "--shared" && i + 1 < argc) {
+			if (!map_shared(argv[++i]))
+				return 1;
+		} else if (arg == "--vcu-enc") {
+			models.vcu_enc = true;
+		} else if (arg == "--vcu-dec") {
+			models.vcu_dec = true;
+		} else if (arg == "--vcu-mcu") {
+			models.vcu_mcu = true;
+		} else if (arg == "--vcu-regs") {
+			models.vcu_regs = true;
+		} else if (arg == "--sdi-rx" && i + 1 < argc) {
+			string spec = argv[++i];
+			size_t colon = spec.find(':');
+
+			models.sdi_rx = true;
+			models.sdi_rx_cfg.mode = spec.substr(0, colon);
+			if (colon != string::npos)
+				models.sdi_rx_cfg.source = spec.substr(colon + 1);
+			models.sdi_rx_cfg.autostart = true;
+		} else if (arg == "--sdi-loop") {
+			models.sdi_loop = true;
+		} else if (arg == "--clk-wiz") {
+			models.clk_wiz = true;
+		} else if (arg == "--eth" && i + 1 < argc) {
+			models.eth_port = strtoul(argv[++i], NULL, 0);
+		} else if (arg == "--eth-pcap") {
+			models.eth_pcap = true;
+		} else if (arg == "--eth-loopback") {
+			models.pcs_cfg.loopback = true;
+		} else if (arg == "--eth-sgmii") {
+			models.pcs_cfg.sgmii = true;
+		} else if (arg == "--tlm-mode" && i + 1 < argc) {
+			string spec = argv[++i];
+			size_t eq = spec.find('=');
+
+			if (eq == string::npos) {
+				usage(argv[0]);
+				return 1;
+			}
+			models.tlm_modes[spec.substr(0, eq)] =
+				strtol(spec.c_str() + eq + 1, NULL, 0);
+		} else if (arg == "--hwh" && i + 1 < argc) {
+			hwh = argv[++i];
+		} else if (!list) {
+			list = argv[i];
+		} else {
+			usage(argv[0]);
+			return 1;
+		}
+	}
+	if (models.sdi_loop && !models.sdi_rx) {
+		models.sdi_rx = true;
+		models.sdi_rx_cfg.autostart = true;
+	}
+	if (hwh) {
+		if (!axi_lite_router_load_hwh(hwh, "M_AXI_HPM0_LPD",
+					      models.lpd_map)) {
+			fprintf(stderr, "%s: no M_AXI_HPM0_LPD address map\n",
+				hwh);
+			return 1;
+		}
+	} else {
+		for (i = 0; i < (int) (sizeof vcu_trd_lpd_map
+				       / sizeof vcu_trd_lpd_map[0]); i++) {
+			r.instance = vcu_trd_lpd_map[i].instance;
+			r.base = vcu_trd_lpd_map[i].base;
+			r.high = vcu_trd_lpd_map[i].high;
+			r.port = 0;
+			models.lpd_map.push_back(r);
+		}
+	}
+	if (!list || jobs == 0) {
+		usage(argv[0]);
+		return 1;
+	}
+	if (!parse_list(list, tests))
+		return 1;
+
+	for (first = 0; first < tests.size(); first += jobs) {
+		size_t count = min<size_t>(jobs, tests.size() - first);
+		int status;
+		pid_t pid;
+
+		fflush(stdout);
+		pid = fork();
+		if (pid == 0) {
+			int rc = run_batch(tests, first, count, limit_ms,
+					   models);
+
+			/* _exit() skips the stdio flush.  */
+			fflush(NULL);
+			_exit(rc);
+		}
+		if (pid < 0) {
+			perror("fork");
+			return 1;
+		}
+		waitpid(pid, &status, 0);
+		if (!WIFEXITED(status))
+			failed += count;
+		else
+			failed += WEXITSTATUS(status);
+	}
+
+	printf("%zu tests, %d failed\n", tests.size(), failed);
+	return failed ? 1 : 0;
+}
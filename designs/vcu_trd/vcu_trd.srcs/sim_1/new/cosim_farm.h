@@ -0,0 +1,67 @@
+/*
+ * Multi-instance co-simulation launcher.
+ *
+ * Several independent ZynqMP PS instances share one SystemC process,
+ * each with its own remote-port endpoint towards its own QEMU.
+ */
+
+#ifndef COSIM_FARM_H__
+#define COSIM_FARM_H__
+
+#include <stddef.h>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+#include "xtlm.h"
+#include "xtlm_adaptors/xaximm_xtlm2tlm.h"
+#include "xtlm_adaptors/xaximm_tlm2xtlm.h"
+#include "vcu_trd_zynq_ultra_ps_e_0_1.h"
+#include "irq_concat.h"
+
+/*
+ * One regression slot: the generated PS wrapper, with the slot's
+ * endpoint and every AXI port in TLM mode as instance parameters.
+ * PL side models for the test are attached by the caller to the TLM side
+ * of the AXI ports and to the lines of irq, the vcu_interrupt xlconcat on
+ * pl_ps_irq0.  AXI ports left unbound are tied off and the pins, unused
+ * in TLM mode, are bound to signals of their own.
+ */
+class cosim_slot
+: public sc_core::sc_module
+{
+public:
+	vcu_trd_zynq_ultra_ps_e_0_1 ps;
+	irq_concat<1> irq;
+
+	cosim_slot(sc_core::sc_module_name name, const char *sk_descr);
+	void before_end_of_elaboration(void);
+
+	tlm::tlm_target_socket<> &s_axi_hpc0_fpd(void);
+	tlm::tlm_target_socket<> &s_axi_hp_fpd(unsigned int i);
+	tlm::tlm_initiator_socket<> &m_axi_hpm0_lpd(void);
+
+private:
+	xtlm::xaximm_tlm2xtlm *hpc0_fpd;
+	xtlm::xaximm_tlm2xtlm *hp_fpd[4];
+	xtlm::xaximm_xtlm2tlm *hpm0_lpd;
+	bool hpc0_fpd_used;
+	bool hp_fpd_used[4];
+	bool hpm0_lpd_used;
+
+	static xsc::common::properties instance_props(const char *sk_descr);
+	template<typename T>
+	bool bind_pin(sc_core::sc_object *obj);
+	void tieoff_b_transport(tlm::tlm_generic_payload &trans,
+				sc_core::sc_time &delay);
+};
+
+/*
+ * Read-only files mapped once by the launcher and shared by every slot
+ * (and, since they are mapped before forking, by every batch).
+ * Returns NULL if path was not registered with --shared.
+ */
+const void *cosim_farm_shared(const char *path, size_t *len);
+
+#endif
@@ -0,0 +1,310 @@
+/*
+ * Common definitions for the Ethernet models.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <iostream>
+#include <vector>
+
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include "eth_link.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define PCAP_MAGIC_NS		0xa1b23c4d
+#define PCAP_LINKTYPE_ETHERNET	1
+
+#define ETHERTYPE_IPV4		0x0800
+#define ETHERTYPE_VLAN		0x8100
+
+#define RTP_HDR_LEN		12
+
+static uint16_t get16(const uint8_t *p)
+{
+	return p[0] << 8 | p[1];
+}
+
+static uint32_t get32(const uint8_t *p)
+{
+	return (uint32_t) get16(p) << 16 | get16(p + 2);
+}
+
+eth_pcap_sink::eth_pcap_sink(sc_module_name name, const string &path)
+	: sc_module(name),
+	  fp(NULL),
+	  frames(0),
+	  bytes(0),
+	  socket("socket")
+{
+	uint32_t hdr[6];
+
+	socket.register_b_transport(this, &eth_pcap_sink::b_transport);
+
+	if (path.empty())
+		return;
+	fp = fopen(path.c_str(), "wb");
+	if (!fp) {
+		SC_REPORT_ERROR(this->name(), ("cannot create "
+				+ path).c_str());
+		return;
+	}
+	/* Host byte order; readers go by the magic.  */
+	hdr[0] = PCAP_MAGIC_NS;
+	hdr[1] = 2 | 4 << 16;		/* version 2.4 */
+	hdr[2] = 0;			/* thiszone */
+	hdr[3] = 0;			/* sigfigs */
+	hdr[4] = 65535;			/* snaplen */
+	hdr[5] = PCAP_LINKTYPE_ETHERNET;
+	fwrite(hdr, 1, sizeof hdr, fp);
+}
+
+eth_pcap_sink::~eth_pcap_sink(void)
+{
+	if (fp)
+		fclose(fp);
+}
+
+void eth_pcap_sink::write_pcap(const uint8_t *data, unsigned int len,
+			       const sc_time &t)
+{
+	uint64_t ns = (uint64_t) (t.to_seconds() * 1e9 + 0.5);
+	uint32_t rec[4];
+
+	rec[0] = ns / 1000000000;
+	rec[1] = ns % 1000000000;
+	rec[2] = len;
+	rec[3] = len;
+	fwrite(rec, 1, sizeof rec, fp);
+	fwrite(data, 1, len, fp);
+}
+
+/* RTP over UDP over IPv4, optionally VLAN tagged.  RTCP is skipped.  */
+void eth_pcap_sink::count_rtp(const uint8_t *data, unsigned int len,
+			      const sc_time &t)
+{
+	unsigned int off = 12;
+	unsigned int ihl, ulen, plen, hlen, pad;
+	const uint8_t *udp, *hdr;
+	uint32_t ssrc;
+	uint16_t seq;
+	rtp_stream *s;
+
+	if (len < off + 2)
+		return;
+	if (get16(data + off) == ETHERTYPE_VLAN)
+		off += 4;
+	if (len < off + 2 + 20 || get16(data + off) != ETHERTYPE_IPV4)
+		return;
+	off += 2;
+	ihl = (data[off] & 0xf) * 4;
+	if ((data[off] >> 4) != 4 || data[off + 9] != IPPROTO_UDP
+	    || len < off + ihl + 8)
+		return;
+	/* Only first fragments carry the UDP header.  */
+	if (get16(data + off + 6) & 0x1fff)
+		return;
+	udp = data + off + ihl;
+	ulen = get16(udp + 4);
+	if (ulen < 8 + RTP_HDR_LEN || udp + ulen > data + len)
+		return;
+
+	hdr = udp + 8;
+	if ((hdr[0] >> 6) != 2 || (hdr[1] >= 200 && hdr[1] <= 204))
+		return;
+	/* Fixed header, CSRCs, then the extension if X is set.  */
+	plen = ulen - 8;
+	hlen = RTP_HDR_LEN + 4 * (hdr[0] & 0xf);
+	if (hdr[0] & 0x10) {
+		if (plen < hlen + 4)
+			return;
+		hlen += 4 + 4 * get16(hdr + hlen + 2);
+	}
+	/* With P set, the last byte counts the padding.  */
+	pad = (hdr[0] & 0x20) ? hdr[plen - 1] : 0;
+	if (plen < hlen + pad)
+		return;
+
+	seq = get16(hdr + 2);
+	ssrc = get32(hdr + 8);
+	if (!rtp.count(ssrc)) {
+		s = &rtp[ssrc];
+		s->packets = 0;
+		s->bytes = 0;
+		s->lost = 0;
+		s->first = t;
+	} else {
+		s = &rtp[ssrc];
+		if (seq != s->next_seq)
+			s->lost += (uint16_t) (seq - s->next_seq);
+	}
+	s->next_seq = seq + 1;
+	s->packets++;
+	s->bytes += plen - hlen - pad;
+	s->last = t;
+}
+
+void eth_pcap_sink::b_transport(tlm::tlm_generic_payload &trans,
+				sc_time &delay)
+{
+	const uint8_t *data = trans.get_data_ptr();
+	unsigned int len = trans.get_data_length();
+	sc_time t = sc_time_stamp() + delay;
+
+	if (!frames)
+		first = t;
+	last = t;
+	frames++;
+	bytes += len;
+	if (fp)
+		write_pcap(data, len, t);
+	count_rtp(data, len, t);
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void eth_pcap_sink::end_of_simulation(void)
+{
+	map<uint32_t, rtp_stream>::const_iterator it;
+	double secs;
+
+	/* The file is only closed by the destructor, which may never run.  */
+	if (fp)
+		fflush(fp);
+	cout << name() << ": " << frames << " frames, " << bytes
+	     << " bytes";
+	secs = (last - first).to_seconds();
+	if (frames > 1 && secs > 0)
+		cout << ", " << bytes * 8 / secs / 1e6 << " Mb/s";
+	cout << "\n";
+	for (it = rtp.begin(); it != rtp.end(); ++it) {
+		const rtp_stream &s = it->second;
+
+		secs = (s.last - s.first).to_seconds();
+		cout << "  RTP ssrc 0x" << hex << it->first << dec << ": "
+		     << s.packets << " packets, " << s.bytes
+		     << " payload bytes, " << s.lost << " lost";
+		if (s.packets > 1 && secs > 0)
+			cout << ", " << s.bytes * 8 / secs / 1e6 << " Mb/s";
+		cout << "\n";
+	}
+}
+
+/* "a.b.c.d:port", false if malformed.  */
+static bool parse_addr(const string &s, struct sockaddr_in &sa)
+{
+	size_t colon = s.rfind(':');
+
+	memset(&sa, 0, sizeof sa);
+	sa.sin_family = AF_INET;
+	if (colon == string::npos
+	    || inet_pton(AF_INET, s.substr(0, colon).c_str(),
+			 &sa.sin_addr) != 1)
+		return false;
+	sa.sin_port = htons(strtoul(s.c_str() + colon + 1, NULL, 10));
+	return true;
+}
+
+eth_udp_netdev::eth_udp_netdev(sc_module_name name,
+			       const eth_udp_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  fd(-1),
+	  frames_in(0),
+	  frames_out(0),
+	  send_errors(0),
+	  tx("tx"),
+	  rx("rx")
+{
+	struct sockaddr_in sa;
+
+	rx.register_b_transport(this, &eth_udp_netdev::b_transport);
+
+	if (!parse_addr(cfg.local, sa) || !parse_addr(cfg.remote, peer)) {
+		SC_REPORT_ERROR(this->name(), "bad address, want a.b.c.d:port");
+		return;
+	}
+	fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+	if (fd < 0 || bind(fd, (struct sockaddr *) &sa, sizeof sa) < 0) {
+		SC_REPORT_ERROR(this->name(), ("cannot bind " + cfg.local
+				+ ": " + strerror(errno)).c_str());
+		if (fd >= 0)
+			close(fd);
+		fd = -1;
+		return;
+	}
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+	SC_THREAD(poll_thread);
+}
+
+eth_udp_netdev::~eth_udp_netdev(void)
+{
+	if (fd >= 0)
+		close(fd);
+}
+
+/*
+ * Drains the socket, a frame at a time.  The receiver's delay paces the
+ * frames, so a backlog goes out at line rate.
+ */
+void eth_udp_netdev::poll_thread(void)
+{
+	tlm_utils::tlm_quantumkeeper qk;
+	tlm::tlm_generic_payload trans;
+	vector<uint8_t> buf(65536);
+	sc_time delay;
+	ssize_t n;
+
+	qk.reset();
+	while (true) {
+		n = recv(fd, &buf[0], buf.size(), 0);
+		if (n < 0) {
+			qk.sync();
+			wait(cfg.poll);
+			continue;
+		}
+
+		trans.set_command(tlm::TLM_WRITE_COMMAND);
+		trans.set_address(0);
+		trans.set_data_ptr(&buf[0]);
+		trans.set_data_length(n);
+		trans.set_streaming_width(n);
+		trans.set_byte_enable_ptr(NULL);
+		trans.set_dmi_allowed(false);
+		trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+		delay = qk.get_local_time();
+		tx->b_transport(trans, delay);
+		qk.set(delay);
+		frames_in++;
+		if (qk.need_sync())
+			qk.sync();
+	}
+}
+
+void eth_udp_netdev::b_transport(tlm::tlm_generic_payload &trans,
+				 sc_time &delay)
+{
+	if (fd < 0 || sendto(fd, trans.get_data_ptr(),
+			     trans.get_data_length(), 0,
+			     (struct sockaddr *) &peer, sizeof peer) < 0)
+		send_errors++;
+	else
+		frames_out++;
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void eth_udp_netdev::end_of_simulation(void)
+{
+	cout << name() << ": " << frames_in << " frames from QEMU, "
+	     << frames_out << " to it, " << send_errors
+	     << " send errors\n";
+}
@@ -0,0 +1,125 @@
+/*
+ * Common definitions for the Ethernet models.
+ *
+ * Frames travel as one TLM write each.  The payload holds the frame from
+ * the destination address to the end of the MAC client data, without
+ * preamble, SFD and FCS, the way QEMU network backends carry them.  The
+ * address is unused.  The delay a frame arrives with is the local time
+ * its last byte is received.  Ethernet has no backpressure, so receivers
+ * do not add to it.
+ *
+ * eth_pcap_sink is a link partner that writes every frame it receives to
+ * a pcap file, if given one, and counts the RTP over UDP/IPv4 in them, so
+ * the output rate of the encoded streams can be read off without a
+ * network.
+ *
+ * eth_udp_netdev connects to a QEMU network backend of the form
+ *
+ *   -netdev socket,id=eth0,udp=<local>,localaddr=<remote>
+ *
+ * (one frame per datagram).  Datagrams from QEMU leave on tx, frames
+ * written to rx are sent to QEMU.  The socket is polled every poll while
+ * idle.
+ */
+
+#ifndef ETH_LINK_H__
+#define ETH_LINK_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <netinet/in.h>
+#include <map>
+#include <string>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#define ETH_MIN_FRAME		60	/* without FCS */
+#define ETH_PREAMBLE		8	/* SFD included */
+#define ETH_FCS			4
+#define ETH_IFG			12
+
+/* Bytes a frame of len occupies on the wire, padding and IFG included.  */
+static inline unsigned int eth_wire_bytes(unsigned int len)
+{
+	return ETH_PREAMBLE + (len < ETH_MIN_FRAME ? ETH_MIN_FRAME : len)
+	       + ETH_FCS + ETH_IFG;
+}
+
+class eth_pcap_sink
+: public sc_core::sc_module
+{
+private:
+	/* One RTP stream, by SSRC.  */
+	struct rtp_stream {
+		uint64_t packets;
+		uint64_t bytes;		/* RTP payload */
+		uint64_t lost;		/* sequence gaps */
+		uint16_t next_seq;
+		sc_core::sc_time first;
+		sc_core::sc_time last;
+	};
+
+	FILE *fp;
+	uint64_t frames;
+	uint64_t bytes;
+	sc_core::sc_time first;
+	sc_core::sc_time last;
+	std::map<uint32_t, rtp_stream> rtp;
+
+	void write_pcap(const uint8_t *data, unsigned int len,
+			const sc_core::sc_time &t);
+	void count_rtp(const uint8_t *data, unsigned int len,
+		       const sc_core::sc_time &t);
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+public:
+	tlm_utils::simple_target_socket<eth_pcap_sink> socket;
+
+	/* An empty path only counts.  */
+	eth_pcap_sink(sc_core::sc_module_name name,
+		      const std::string &path = "");
+	~eth_pcap_sink(void);
+
+	void end_of_simulation(void);
+};
+
+struct eth_udp_config {
+	std::string local;		/* address:port to bind */
+	std::string remote;		/* address:port of QEMU */
+	sc_core::sc_time poll;
+
+	eth_udp_config(void)
+		: local("127.0.0.1:5555"), remote("127.0.0.1:5556"),
+		  poll(10, sc_core::SC_US)
+	{}
+};
+
+class eth_udp_netdev
+: public sc_core::sc_module
+{
+private:
+	eth_udp_config cfg;
+	int fd;
+	struct sockaddr_in peer;
+	uint64_t frames_in;
+	uint64_t frames_out;
+	uint64_t send_errors;
+
+	void poll_thread(void);
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+public:
+	SC_HAS_PROCESS(eth_udp_netdev);
+
+	tlm_utils::simple_initiator_socket<eth_udp_netdev> tx;
+	tlm_utils::simple_target_socket<eth_udp_netdev> rx;
+
+	eth_udp_netdev(sc_core::sc_module_name name,
+		       const eth_udp_config &cfg = eth_udp_config());
+	~eth_udp_netdev(void);
+
+	void end_of_simulation(void);
+};
+
+#endif
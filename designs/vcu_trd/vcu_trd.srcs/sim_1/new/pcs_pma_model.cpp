@@ -0,0 +1,352 @@
+/*
+ * Packet level model of the 1G/2.5G Ethernet PCS/PMA or SGMII core.
+ */
+
+#include <iostream>
+
+#include "pcs_pma_model.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define MII_CTRL		0
+#define MII_STATUS		1
+#define MII_ADV			4
+#define MII_LPA			5
+#define MII_EXPANSION		6
+#define MII_ESTATUS		15
+#define MII_AN_IRQ		16	/* vendor specific */
+
+#define CTRL_RESET		(1 << 15)
+#define CTRL_LOOPBACK		(1 << 14)
+#define CTRL_AN_ENABLE		(1 << 12)
+#define CTRL_POWER_DOWN		(1 << 11)
+#define CTRL_ISOLATE		(1 << 10)
+#define CTRL_RESTART_AN		(1 << 9)
+#define CTRL_DEFAULT		0x0140	/* full duplex, 1000 Mb/s */
+
+#define STATUS_EXT		(1 << 8)
+#define STATUS_AN_COMPLETE	(1 << 5)
+#define STATUS_AN_ABLE		(1 << 3)
+#define STATUS_LINK		(1 << 2)
+
+#define ADV_BASEX_FD		(1 << 5)
+#define ADV_SGMII		(1 << 0)
+#define LPA_ACK			(1 << 14)
+/* SGMII PHY: link up, acknowledge, full duplex, 1000 Mb/s.  */
+#define LPA_SGMII_1000FD	0xd801
+
+#define EXPANSION_PAGE_RX	(1 << 1)
+#define ESTATUS_1000X_FD	(1 << 15)
+
+#define AN_IRQ_ENABLE		(1 << 0)
+#define AN_IRQ_STATUS		(1 << 1)
+
+/* status_vector bits.  */
+#define SV_LINK			(1 << 0)
+#define SV_SYNC			(1 << 1)
+#define SV_RUDI_I		(1 << 3)
+#define SV_PHY_LINK		(1 << 7)
+#define SV_SPEED_1000		(2 << 10)
+#define SV_FULL_DUPLEX		(1 << 12)
+
+pcs_pma_model::pcs_pma_model(sc_module_name name, const pcs_pma_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  byte_time(8.0 / cfg.rate_bps, SC_SEC),
+	  link_timer(cfg.link_timer),
+	  link_failed(false),
+	  page_received(false),
+	  an_complete(false),
+	  signal_detect(true),
+	  state(LINK_DOWN),
+	  tx_frames(0),
+	  tx_bytes(0),
+	  tx_lost(0),
+	  rx_frames(0),
+	  rx_bytes(0),
+	  rx_lost(0),
+	  link_ups(0),
+	  gmii_tx("gmii_tx"),
+	  gmii_rx("gmii_rx"),
+	  phy_tx("phy_tx"),
+	  phy_rx("phy_rx")
+{
+	gmii_tx.register_b_transport(this, &pcs_pma_model::gmii_b_transport);
+	phy_rx.register_b_transport(this, &pcs_pma_model::phy_b_transport);
+
+	if (link_timer == SC_ZERO_TIME)
+		link_timer = cfg.sgmii ? sc_time(1.6, SC_MS)
+				       : sc_time(10, SC_MS);
+	reset_regs();
+
+	SC_METHOD(link_method);
+	sensitive << link_ev;
+	dont_initialize();
+}
+
+void pcs_pma_model::before_end_of_elaboration(void)
+{
+	tlm_utils::simple_initiator_socket<pcs_pma_model> *tieoff_init;
+	tlm_utils::simple_target_socket<pcs_pma_model> *tieoff_tgt;
+
+	/* A MAC that only transmits, a partner that only listens.  */
+	if (!gmii_rx.size()) {
+		tieoff_tgt = new tlm_utils::simple_target_socket<
+				pcs_pma_model>();
+		tieoff_tgt->register_b_transport(this,
+				&pcs_pma_model::drop_b_transport);
+		gmii_rx.bind(*tieoff_tgt);
+	}
+	if (!phy_tx.size()) {
+		tieoff_tgt = new tlm_utils::simple_target_socket<
+				pcs_pma_model>();
+		tieoff_tgt->register_b_transport(this,
+				&pcs_pma_model::drop_b_transport);
+		phy_tx.bind(*tieoff_tgt);
+	}
+	if (!phy_rx.size()) {
+		tieoff_init = new tlm_utils::simple_initiator_socket<
+				pcs_pma_model>();
+		tieoff_init->bind(phy_rx);
+	}
+}
+
+void pcs_pma_model::reset_regs(void)
+{
+	ctrl = CTRL_DEFAULT;
+	if (cfg.an_enable)
+		ctrl |= CTRL_AN_ENABLE;
+	if (cfg.loopback)
+		ctrl |= CTRL_LOOPBACK;
+	adv = cfg.sgmii ? ADV_SGMII : ADV_BASEX_FD;
+	an_irq = 0;
+}
+
+bool pcs_pma_model::passing(void) const
+{
+	return state == LINK_UP && !(ctrl & CTRL_ISOLATE);
+}
+
+/*
+ * Puts a frame of len on a channel, no earlier than at and once the
+ * previous frame is through.  Returns when its last byte has crossed.
+ */
+sc_time pcs_pma_model::serialize(sc_time &free, const sc_time &at,
+				 unsigned int len, sc_time &busy)
+{
+	sc_time start = at > free ? at : free;
+	unsigned int n = eth_wire_bytes(len);
+
+	free = start + byte_time * (double) n;
+	busy += byte_time * (double) n;
+	stalled += start - at;
+	return start + byte_time * (double) (n - ETH_IFG) + cfg.latency;
+}
+
+/* Drops the link and brings it up again if it can.  */
+void pcs_pma_model::restart_link(void)
+{
+	sc_time t = cfg.sync_time;
+
+	if (state == LINK_UP)
+		link_failed = true;
+	link_ev.cancel();
+	an_complete = false;
+	if ((ctrl & CTRL_POWER_DOWN)
+	    || (!signal_detect && !(ctrl & CTRL_LOOPBACK))) {
+		state = LINK_DOWN;
+		return;
+	}
+	state = LINK_SYNC;
+	if (ctrl & CTRL_AN_ENABLE)
+		t += link_timer * 2.0;
+	link_ev.notify(t);
+}
+
+void pcs_pma_model::link_method(void)
+{
+	state = LINK_UP;
+	link_ups++;
+	if (ctrl & CTRL_AN_ENABLE) {
+		an_complete = true;
+		page_received = true;
+		if (an_irq & AN_IRQ_ENABLE)
+			an_irq |= AN_IRQ_STATUS;
+	}
+}
+
+void pcs_pma_model::start_of_simulation(void)
+{
+	restart_link();
+}
+
+uint16_t pcs_pma_model::mdio_read(unsigned int phyad, unsigned int reg)
+{
+	uint16_t v;
+
+	if (phyad != cfg.phyad)
+		return 0xffff;
+
+	switch (reg) {
+	case MII_CTRL:
+		return ctrl;
+	case MII_STATUS:
+		v = STATUS_EXT | STATUS_AN_ABLE;
+		if (an_complete)
+			v |= STATUS_AN_COMPLETE;
+		if (state == LINK_UP && !link_failed)
+			v |= STATUS_LINK;
+		link_failed = false;
+		return v;
+	case MII_ADV:
+		return adv;
+	case MII_LPA:
+		if (!an_complete)
+			return 0;
+		if (cfg.sgmii)
+			return LPA_SGMII_1000FD;
+		/* Looped back, the partner is ourselves.  */
+		return LPA_ACK | ((ctrl & CTRL_LOOPBACK) ? adv : ADV_BASEX_FD);
+	case MII_EXPANSION:
+		v = page_received ? EXPANSION_PAGE_RX : 0;
+		page_received = false;
+		return v;
+	case MII_ESTATUS:
+		return ESTATUS_1000X_FD;
+	case MII_AN_IRQ:
+		return an_irq;
+	}
+	return 0;
+}
+
+void pcs_pma_model::mdio_write(unsigned int phyad, unsigned int reg,
+			       uint16_t val)
+{
+	uint16_t old = ctrl;
+
+	if (phyad != cfg.phyad)
+		return;
+
+	switch (reg) {
+	case MII_CTRL:
+		if (val & CTRL_RESET) {
+			reset_regs();
+			restart_link();
+			return;
+		}
+		ctrl = val & ~CTRL_RESTART_AN;
+		if ((val & CTRL_RESTART_AN)
+		    || ((old ^ ctrl) & (CTRL_LOOPBACK | CTRL_AN_ENABLE
+					| CTRL_POWER_DOWN)))
+			restart_link();
+		break;
+	case MII_ADV:
+		adv = val;
+		break;
+	case MII_AN_IRQ:
+		/* The status bit can only be cleared.  */
+		an_irq = (val & AN_IRQ_ENABLE) | (an_irq & val & AN_IRQ_STATUS);
+		break;
+	}
+}
+
+void pcs_pma_model::set_signal_detect(bool detect)
+{
+	if (detect == signal_detect)
+		return;
+	signal_detect = detect;
+	if (!(ctrl & CTRL_LOOPBACK))
+		restart_link();
+}
+
+bool pcs_pma_model::link_up(void) const
+{
+	return state == LINK_UP;
+}
+
+uint16_t pcs_pma_model::status_vector(void) const
+{
+	uint16_t v = 0;
+
+	if (state != LINK_DOWN)
+		v |= SV_SYNC;
+	if (state == LINK_UP) {
+		v |= SV_LINK | SV_RUDI_I;
+		if (cfg.sgmii)
+			v |= SV_PHY_LINK | SV_SPEED_1000 | SV_FULL_DUPLEX;
+	}
+	return v;
+}
+
+/* From the MAC.  The GMII clocks on with or without a link.  */
+void pcs_pma_model::gmii_b_transport(tlm::tlm_generic_payload &trans,
+				     sc_time &delay)
+{
+	unsigned int len = trans.get_data_length();
+	sc_time now = sc_time_stamp();
+	sc_time d;
+
+	d = serialize(tx_free, now + delay, len, tx_busy) - now;
+	if (!passing()) {
+		tx_lost++;
+	} else {
+		tx_frames++;
+		tx_bytes += len;
+		if (ctrl & CTRL_LOOPBACK) {
+			rx_frames++;
+			rx_bytes += len;
+			gmii_rx->b_transport(trans, d);
+		} else {
+			phy_tx->b_transport(trans, d);
+		}
+	}
+	delay = tx_free - now;
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+/* From the link partner.  */
+void pcs_pma_model::phy_b_transport(tlm::tlm_generic_payload &trans,
+				    sc_time &delay)
+{
+	unsigned int len = trans.get_data_length();
+	sc_time now = sc_time_stamp();
+	sc_time d;
+
+	d = serialize(rx_free, now + delay, len, rx_busy) - now;
+	if (!passing() || (ctrl & CTRL_LOOPBACK)) {
+		rx_lost++;
+	} else {
+		rx_frames++;
+		rx_bytes += len;
+		gmii_rx->b_transport(trans, d);
+	}
+	delay = rx_free - now;
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void pcs_pma_model::drop_b_transport(tlm::tlm_generic_payload &trans,
+				     sc_time &delay)
+{
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void pcs_pma_model::end_of_simulation(void)
+{
+	sc_time now = sc_time_stamp();
+
+	cout << name() << ": " << (cfg.sgmii ? "SGMII" : "1000BASE-X")
+	     << ", link " << (state == LINK_UP ? "up" : "down")
+	     << ((ctrl & CTRL_LOOPBACK) ? " in loopback" : "") << ", "
+	     << link_ups << " link ups\n";
+	cout << "  TX " << tx_frames << " frames, " << tx_bytes
+	     << " bytes, " << tx_lost << " lost; RX " << rx_frames
+	     << " frames, " << rx_bytes << " bytes, " << rx_lost
+	     << " lost\n";
+	if (now > SC_ZERO_TIME) {
+		cout << "  TX busy " << 100.0 * (tx_busy / now)
+		     << "%, RX busy " << 100.0 * (rx_busy / now)
+		     << "%, TX " << tx_bytes * 8 / now.to_seconds() / 1e6
+		     << " Mb/s, stalled " << stalled << "\n";
+	}
+}
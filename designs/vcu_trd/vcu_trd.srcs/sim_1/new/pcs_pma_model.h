@@ -0,0 +1,162 @@
+/*
+ * Packet level model of the 1G/2.5G Ethernet PCS/PMA or SGMII core
+ * (gig_ethernet_pcs_pma).
+ *
+ * Stands in for gig_ethernet_pcs_pma_0 so Ethernet traffic from the GEM
+ * can be pushed through the PCS/PMA at line rate.  In vcu_trd the core's
+ * GMII is tied off and only its SFP and MDIO are wired, so like the SDI
+ * models this is a harness: the MAC side is whatever is bound to the GMII
+ * sockets, typically an eth_udp_netdev talking to the GEM in QEMU, and
+ * the PHY side a link partner such as an eth_pcap_sink (see eth_link.h).
+ *
+ *   gmii_tx  frames from the MAC     phy_tx  frames to the link partner
+ *   gmii_rx  frames to the MAC       phy_rx  frames from the link partner
+ *
+ * Each direction is a 1 Gb/s channel.  A frame occupies it for preamble,
+ * frame (padded to the minimum), FCS and inter frame gap, and starts once
+ * the previous one is through, so a sender annotated with the returned
+ * delay is held to line rate.  The receiver sees the frame when its last
+ * byte has crossed the link, plus latency.
+ *
+ * The link comes up sync_time after reset, power up or a signal detect
+ * change, plus two link timer periods with auto-negotiation enabled
+ * (ability, acknowledge and idle detect, IEEE 802.3 clause 37; SGMII uses
+ * the same exchange with a 1.6 ms timer).  Frames sent while the link is
+ * down, or isolated, are lost.  With loopback (register 0 bit 14) the
+ * transmitted frames come back on gmii_rx and nothing goes to or comes
+ * from the partner; the link comes up without a partner.
+ *
+ * The management registers are reachable with mdio_read() and
+ * mdio_write() at phyad, from C++ only.  The core's MDIO pins are not
+ * connected to the GEM in QEMU, so software running there cannot read
+ * the link or auto-negotiation state:
+ *
+ *   0   control         bit 15 reset, 14 loopback, 12 AN enable,
+ *                       11 power down, 10 isolate, 9 restart AN
+ *   1   status          bit 5 AN complete, 2 link status (latching low)
+ *   4   AN advertisement
+ *   5   AN link partner ability
+ *   6   AN expansion    bit 1 page received (clears on read)
+ *   15  extended status
+ *   16  AN interrupt    bit 0 enable, bit 1 status (write 0 to clear)
+ *
+ * status_vector() gives the core's status_vector output.  Sockets left
+ * unbound are tied off; frames sent to them are dropped.
+ */
+
+#ifndef PCS_PMA_MODEL_H__
+#define PCS_PMA_MODEL_H__
+
+#include <stdint.h>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#include "eth_link.h"
+
+/* Defaults follow the vcu_trd_gig_ethernet_pcs_pma_0_1 configuration.  */
+struct pcs_pma_config {
+	bool sgmii;			/* basex_or_sgmii, tied low */
+	unsigned int phyad;		/* phyaddr, tied to 0 */
+	bool an_enable;			/* Auto_Negotiation */
+	bool loopback;			/* register 0 bit 14 out of reset */
+	double rate_bps;		/* MaxDataRate 1G */
+	/* 0: 10 ms for 1000BASE-X, 1.6 ms for SGMII.  */
+	sc_core::sc_time link_timer;
+	sc_core::sc_time sync_time;	/* comma alignment and sync */
+	sc_core::sc_time latency;	/* PCS and transceiver, each way */
+
+	pcs_pma_config(void)
+		: sgmii(false), phyad(0), an_enable(true), loopback(false),
+		  rate_bps(1e9),
+		  link_timer(sc_core::SC_ZERO_TIME),
+		  sync_time(10, sc_core::SC_US),
+		  latency(200, sc_core::SC_NS)
+	{}
+};
+
+class pcs_pma_model
+: public sc_core::sc_module
+{
+private:
+	enum link_state {
+		LINK_DOWN,
+		LINK_SYNC,		/* sync, then autonegotiation */
+		LINK_UP,
+	};
+
+	pcs_pma_config cfg;
+	sc_core::sc_time byte_time;
+	sc_core::sc_time link_timer;
+
+	/* Management registers.  */
+	uint16_t ctrl;
+	uint16_t adv;
+	uint16_t an_irq;
+	bool link_failed;		/* status link bit latched low */
+	bool page_received;
+	bool an_complete;
+
+	bool signal_detect;
+	enum link_state state;
+	sc_core::sc_event link_ev;
+
+	/* Channels, each way.  */
+	sc_core::sc_time tx_free;
+	sc_core::sc_time rx_free;
+
+	/* Stats.  */
+	uint64_t tx_frames;
+	uint64_t tx_bytes;
+	uint64_t tx_lost;
+	uint64_t rx_frames;
+	uint64_t rx_bytes;
+	uint64_t rx_lost;
+	uint64_t link_ups;
+	sc_core::sc_time tx_busy;
+	sc_core::sc_time rx_busy;
+	sc_core::sc_time stalled;
+
+	void reset_regs(void);
+	bool passing(void) const;
+	sc_core::sc_time serialize(sc_core::sc_time &free,
+				   const sc_core::sc_time &at,
+				   unsigned int len, sc_core::sc_time &busy);
+	void restart_link(void);
+	void link_method(void);
+
+	void gmii_b_transport(tlm::tlm_generic_payload &trans,
+			      sc_time &delay);
+	void drop_b_transport(tlm::tlm_generic_payload &trans,
+			      sc_time &delay);
+	void phy_b_transport(tlm::tlm_generic_payload &trans,
+			     sc_time &delay);
+public:
+	SC_HAS_PROCESS(pcs_pma_model);
+
+	tlm_utils::simple_target_socket<pcs_pma_model> gmii_tx;
+	tlm_utils::simple_initiator_socket<pcs_pma_model> gmii_rx;
+	tlm_utils::simple_initiator_socket<pcs_pma_model> phy_tx;
+	tlm_utils::simple_target_socket<pcs_pma_model> phy_rx;
+
+	pcs_pma_model(sc_core::sc_module_name name,
+		      const pcs_pma_config &cfg = pcs_pma_config());
+
+	/* MDIO, clause 22.  Other addresses read as all ones.  */
+	uint16_t mdio_read(unsigned int phyad, unsigned int reg);
+	void mdio_write(unsigned int phyad, unsigned int reg, uint16_t val);
+
+	/* The signal_detect input, tied high in vcu_trd.  */
+	void set_signal_detect(bool detect);
+
+	bool link_up(void) const;
+	uint16_t status_vector(void) const;
+
+	void before_end_of_elaboration(void);
+	void start_of_simulation(void);
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,610 @@
+/*
+ * Loosely timed model of the UHD-SDI RX subsystem (v_smpte_uhdsdi_rx_ss).
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <iostream>
+#include <sstream>
+
+#include "sdi_rx_model.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define SDI_RX_WINDOW_SIZE	0x10000
+
+#define RX_RST_CTRL		0x00
+#define RX_MDL_CTRL		0x04
+#define RX_GIER			0x0c
+#define RX_ISR			0x10
+#define RX_IER			0x14
+#define RX_ST352_VALID		0x18
+#define RX_ST352_0		0x1c
+#define RX_ST352_7		0x38
+#define RX_VERSION		0x3c
+#define RX_SYS_CONFIG		0x40
+#define RX_MODE_DET_STS		0x44
+#define RX_TS_DET_STS		0x48
+#define RX_EDH_STS		0x4c
+#define RX_EDH_ERRCNT_EN	0x50
+#define RX_EDH_ERRCNT		0x54
+#define RX_CRC_ERRCNT		0x58
+#define RX_VID_LOCK_WINDOW	0x5c
+#define RX_SB_RX_STS		0x60
+
+#define RST_CTRL_SS_EN		(1 << 0)
+#define RST_CTRL_SRST		(1 << 1)
+#define RST_CTRL_BRIDGE_EN	(1 << 8)
+#define RST_CTRL_AXI4S_EN	(1 << 9)
+#define RST_CTRL_STREAM		(RST_CTRL_BRIDGE_EN | RST_CTRL_AXI4S_EN)
+
+#define ISR_VIDEO_LOCK		(1 << 0)
+#define ISR_VIDEO_UNLOCK	(1 << 1)
+#define ISR_OVERFLOW		(1 << 2)
+#define ISR_UNDERFLOW		(1 << 3)
+
+#define MODE_DET_LOCKED		(1 << 3)
+#define TS_DET_LOCKED		(1 << 0)
+#define TS_DET_INTERLACED	(1 << 1)
+#define SB_RX_GT_LOCKED		(1 << 0)
+#define SB_RX_RESET_DONE	(1 << 4)
+
+#define SDI_RX_VERSION		0x02000000
+#define SDI_RX_SYS_CONFIG_EDH	(1 << 0)
+
+static double wall_time(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/* Move the keeper's local time forward to t, never back.  */
+static void advance_to(tlm_utils::tlm_quantumkeeper &qk, const sc_time &t)
+{
+	if (qk.get_current_time() < t)
+		qk.set(t - sc_time_stamp());
+}
+
+sdi_rx_model::sdi_rx_model(sc_module_name name, const sdi_rx_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  rst_ctrl(0),
+	  mdl_ctrl(0),
+	  gier(0),
+	  isr(0),
+	  ier(0),
+	  edh_errcnt_en(0),
+	  lock_window(0),
+	  locked(false),
+	  irq_level(false),
+	  y4m(NULL),
+	  y4m_len(0),
+	  packed_frame(-1),
+	  stride(0),
+	  frames_sent(0),
+	  frames_dropped(0),
+	  lines_sent(0),
+	  lines_overflowed(0),
+	  overflows(0),
+	  errors(0),
+	  wall_start(0),
+	  video_out("video_out"),
+	  ctrl("ctrl"),
+	  irq("irq")
+{
+	const string &src = cfg.source;
+
+	ctrl.register_b_transport(this, &sdi_rx_model::b_transport);
+	ctrl.register_transport_dbg(this, &sdi_rx_model::transport_dbg);
+
+	if (!sdi_find_mode(cfg.mode.c_str(), mode)) {
+		SC_REPORT_ERROR(this->name(), ("unknown SDI mode "
+				+ cfg.mode).c_str());
+		sdi_find_mode("2160p60", mode);
+	}
+
+	if (src.size() > 4 && src.compare(src.size() - 4, 4, ".y4m") == 0) {
+		if (!open_y4m(src.c_str())) {
+			this->cfg.source = "bars";
+			make_pattern();
+		}
+	} else {
+		make_pattern();
+	}
+
+	if (cfg.autostart)
+		rst_ctrl = RST_CTRL_SS_EN | RST_CTRL_STREAM;
+
+	SC_THREAD(rx_thread);
+	SC_METHOD(irq_method);
+	sensitive << irq_ev;
+}
+
+sdi_rx_model::~sdi_rx_model(void)
+{
+	if (y4m)
+		munmap((void *) y4m, y4m_len);
+}
+
+/* 75% colour bars, ITU-R BT.709, 10 bit.  */
+static const uint16_t bars[8][3] = {
+	{ 721, 512, 512 },	/* white */
+	{ 674, 176, 543 },	/* yellow */
+	{ 581, 589, 176 },	/* cyan */
+	{ 534, 253, 207 },	/* green */
+	{ 251, 771, 817 },	/* magenta */
+	{ 204, 435, 848 },	/* red */
+	{ 111, 848, 481 },	/* blue */
+	{ 64, 512, 512 },	/* black */
+};
+
+void sdi_rx_model::make_pattern(void)
+{
+	vector<uint16_t> y(mode.width), c(mode.width);
+	unsigned int x;
+
+	if (cfg.source != "bars" && cfg.source != "ramp"
+	    && cfg.source != "black")
+		SC_REPORT_ERROR(name(), ("unknown source " + cfg.source
+					 + ", using bars").c_str());
+
+	for (x = 0; x < mode.width; x++) {
+		const uint16_t *bar = bars[x * 8 / mode.width];
+
+		if (cfg.source == "ramp") {
+			y[x] = 64 + x * 876 / mode.width;
+			c[x] = 512;
+		} else if (cfg.source == "black") {
+			y[x] = 64;
+			c[x] = 512;
+		} else {
+			/* Cb on even pixels, Cr on odd, per pair.  */
+			y[x] = bar[0];
+			c[x] = bar[1 + (x & 1)];
+		}
+	}
+
+	packed.resize(mode.line_bytes());
+	sdi_pack_line(&y[0], &c[0], mode.width, &packed[0]);
+	stride = 0;
+}
+
+/*
+ * Maps a Y4M file whose frames match the mode.  Frames must have bare
+ * "FRAME\n" headers.  Returns false, with an error reported, otherwise.
+ */
+bool sdi_rx_model::open_y4m(const char *path)
+{
+	const char *hdr;
+	const char *eol;
+	string colorspace = "420jpeg";
+	unsigned int w = 0, h = 0;
+	size_t luma, chroma;
+	struct stat st;
+	string tok;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		SC_REPORT_ERROR(name(), (string(path) + ": "
+					 + strerror(errno)).c_str());
+		if (fd >= 0)
+			close(fd);
+		return false;
+	}
+	y4m_len = st.st_size;
+	y4m = (const uint8_t *) mmap(NULL, y4m_len, PROT_READ, MAP_SHARED,
+				     fd, 0);
+	close(fd);
+	if (y4m == MAP_FAILED) {
+		y4m = NULL;
+		SC_REPORT_ERROR(name(), (string(path)
+					 + ": mmap failed").c_str());
+		return false;
+	}
+
+	hdr = (const char *) y4m;
+	eol = (const char *) memchr(hdr, '\n', y4m_len);
+	if (y4m_len < 10 || memcmp(hdr, "YUV4MPEG2 ", 10) || !eol) {
+		SC_REPORT_ERROR(name(), (string(path) + ": not Y4M").c_str());
+		goto fail;
+	}
+
+	{
+		istringstream ss(string(hdr + 10, eol));
+
+		while (ss >> tok) {
+			if (tok[0] == 'W')
+				w = strtoul(tok.c_str() + 1, NULL, 10);
+			else if (tok[0] == 'H')
+				h = strtoul(tok.c_str() + 1, NULL, 10);
+			else if (tok[0] == 'C')
+				colorspace = tok.substr(1);
+		}
+	}
+
+	if (colorspace == "422" || colorspace == "422p10") {
+		y4m_420 = false;
+	} else if (colorspace == "420" || colorspace == "420jpeg"
+		   || colorspace == "420mpeg2" || colorspace == "420paldv"
+		   || colorspace == "420p10") {
+		y4m_420 = true;
+	} else {
+		SC_REPORT_ERROR(name(), (string(path) + ": colorspace "
+					 + colorspace
+					 + " not supported").c_str());
+		goto fail;
+	}
+	y4m_depth = colorspace.find("p10") != string::npos ? 10 : 8;
+
+	if (w != mode.width || h != mode.height) {
+		SC_REPORT_ERROR(name(), (string(path) + ": frame size "
+					 "does not match " + cfg.mode).c_str());
+		goto fail;
+	}
+
+	luma = (size_t) w * h;
+	chroma = y4m_420 ? luma / 2 : luma;
+	y4m_first = eol + 1 - hdr;
+	y4m_frame_len = 6 + (luma + chroma) * (y4m_depth > 8 ? 2 : 1);
+	y4m_frames = (y4m_len - y4m_first) / y4m_frame_len;
+	if (y4m_frames == 0
+	    || memcmp(y4m + y4m_first, "FRAME\n", 6)) {
+		SC_REPORT_ERROR(name(), (string(path)
+					 + ": no plain FRAME found").c_str());
+		goto fail;
+	}
+
+	packed.resize((size_t) mode.line_bytes() * mode.height);
+	stride = mode.line_bytes();
+	return true;
+
+fail:
+	munmap((void *) y4m, y4m_len);
+	y4m = NULL;
+	return false;
+}
+
+static uint16_t y4m_sample(const uint8_t *p, size_t i, unsigned int depth)
+{
+	if (depth > 8)
+		return p[2 * i] | p[2 * i + 1] << 8;
+	return p[i] << 2;
+}
+
+/* Packed frame data, line l at l * stride.  */
+const uint8_t *sdi_rx_model::frame_data(uint64_t frame)
+{
+	unsigned int idx, l, x;
+	unsigned int cw = mode.width / 2;
+	const uint8_t *f, *py, *pu, *pv;
+	size_t luma;
+
+	if (!y4m)
+		return &packed[0];
+
+	idx = frame % y4m_frames;
+	if ((int) idx == packed_frame)
+		return &packed[0];
+
+	vector<uint16_t> y(mode.width), c(mode.width);
+	unsigned int bps = y4m_depth > 8 ? 2 : 1;
+
+	luma = (size_t) mode.width * mode.height;
+	f = y4m + y4m_first + (size_t) y4m_frame_len * idx + 6;
+	pu = f + luma * bps;
+	pv = pu + luma / (y4m_420 ? 4 : 2) * bps;
+	for (l = 0; l < mode.height; l++) {
+		unsigned int cl = y4m_420 ? l / 2 : l;
+
+		py = f + (size_t) l * mode.width * bps;
+		for (x = 0; x < mode.width; x++)
+			y[x] = y4m_sample(py, x, y4m_depth);
+		for (x = 0; x < cw; x++) {
+			c[2 * x] = y4m_sample(pu, (size_t) cl * cw + x,
+					      y4m_depth);
+			c[2 * x + 1] = y4m_sample(pv, (size_t) cl * cw + x,
+						  y4m_depth);
+		}
+		sdi_pack_line(&y[0], &c[0], mode.width,
+			      &packed[(size_t) l * stride]);
+	}
+	packed_frame = idx;
+	return &packed[0];
+}
+
+/*
+ * One frame on the wire starting at start: vertical blanking, then the
+ * active lines.  Line l is complete, and goes out, at the end of its
+ * line period.
+ */
+void sdi_rx_model::send_frame(tlm_utils::tlm_quantumkeeper &qk,
+			      const sc_time &start, uint64_t frame)
+{
+	sc_time lp = mode.line_period();
+	sc_time slack = lp * (double) cfg.fifo_lines;
+	unsigned int vblank = mode.total_height - mode.height;
+	unsigned int len = mode.line_bytes();
+	tlm::tlm_generic_payload trans;
+	sdi_video_ext ext;
+	const uint8_t *data;
+	bool overflowed = false;
+	unsigned int l;
+
+	if ((rst_ctrl & RST_CTRL_STREAM) != RST_CTRL_STREAM) {
+		frames_dropped++;
+		advance_to(qk, start + mode.frame_period());
+		qk.sync();
+		return;
+	}
+
+	data = frame_data(frame);
+	ext.frame = frame;
+	trans.set_extension(&ext);
+	for (l = 0; l < mode.height; l++) {
+		sc_time due = start + lp * (double) (vblank + l + 1);
+		sc_time delay;
+		sc_time lag;
+
+		advance_to(qk, due);
+		if (qk.get_current_time() > due + slack) {
+			/* The FIFO is still full, the line is lost.  */
+			lines_overflowed++;
+			continue;
+		}
+
+		ext.sof = l == 0;
+		ext.eol = true;
+		ext.line = l;
+		trans.set_command(tlm::TLM_WRITE_COMMAND);
+		trans.set_address((uint64_t) l * len);
+		trans.set_data_ptr((unsigned char *) data + (size_t) l * stride);
+		trans.set_data_length(len);
+		trans.set_streaming_width(len);
+		trans.set_byte_enable_ptr(NULL);
+		trans.set_dmi_allowed(false);
+		trans.set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+
+		delay = qk.get_local_time();
+		video_out->b_transport(trans, delay);
+		qk.set(delay);
+		if (trans.get_response_status() != tlm::TLM_OK_RESPONSE)
+			errors++;
+		lines_sent++;
+
+		lag = qk.get_current_time() - due;
+		if (lag > worst_lag)
+			worst_lag = lag;
+		if (lag > slack && !overflowed) {
+			overflowed = true;
+			overflows++;
+			isr |= ISR_OVERFLOW;
+			update_irq();
+		}
+		if (qk.need_sync())
+			qk.sync();
+	}
+	trans.clear_extension(&ext);
+	frames_sent++;
+}
+
+void sdi_rx_model::rx_thread(void)
+{
+	tlm_utils::tlm_quantumkeeper qk;
+	sc_time period = mode.frame_period();
+	sc_time t0, until;
+	uint64_t frame;
+
+	while (true) {
+		if ((rst_ctrl & (RST_CTRL_SS_EN | RST_CTRL_SRST))
+		    != RST_CTRL_SS_EN) {
+			set_lock(false);
+			wait(ctrl_ev);
+			continue;
+		}
+
+		/* Lock takes lock_delay, unless the core is stopped.  */
+		until = sc_time_stamp() + cfg.lock_delay;
+		while ((rst_ctrl & (RST_CTRL_SS_EN | RST_CTRL_SRST))
+		       == RST_CTRL_SS_EN && sc_time_stamp() < until)
+			wait(until - sc_time_stamp(), ctrl_ev);
+		if ((rst_ctrl & (RST_CTRL_SS_EN | RST_CTRL_SRST))
+		    != RST_CTRL_SS_EN)
+			continue;
+		set_lock(true);
+
+		qk.reset();
+		t0 = sc_time_stamp();
+		for (frame = 0; (rst_ctrl & (RST_CTRL_SS_EN | RST_CTRL_SRST))
+				== RST_CTRL_SS_EN; frame++)
+			send_frame(qk, t0 + period * (double) frame, frame);
+		qk.sync();
+	}
+}
+
+void sdi_rx_model::set_lock(bool lock)
+{
+	if (lock == locked)
+		return;
+	locked = lock;
+	isr |= lock ? ISR_VIDEO_LOCK : ISR_VIDEO_UNLOCK;
+	update_irq();
+}
+
+/*
+ * Called from rx_thread and from the ctrl b_transport; irq_method is the
+ * only writer of the port.
+ */
+void sdi_rx_model::update_irq(void)
+{
+	irq_level = (gier & 1) && (isr & ier);
+	irq_ev.notify(SC_ZERO_TIME);
+}
+
+void sdi_rx_model::irq_method(void)
+{
+	irq.write(irq_level);
+}
+
+uint32_t sdi_rx_model::reg_read(uint32_t offset)
+{
+	uint32_t v;
+
+	switch (offset) {
+	case RX_RST_CTRL:
+		return rst_ctrl;
+	case RX_MDL_CTRL:
+		return mdl_ctrl;
+	case RX_GIER:
+		return gier;
+	case RX_ISR:
+		return isr;
+	case RX_IER:
+		return ier;
+	case RX_ST352_VALID:
+		/* 12G-SDI 8DS carries the payload on every stream.  */
+		if (!locked)
+			return 0;
+		return mode.rate >= SDI_RATE_12G ? 0xff
+		       : mode.rate == SDI_RATE_6G ? 0x0f : 0x01;
+	case RX_VERSION:
+		return SDI_RX_VERSION;
+	case RX_SYS_CONFIG:
+		return SDI_RX_SYS_CONFIG_EDH;
+	case RX_MODE_DET_STS:
+		if (!locked)
+			return 0;
+		/* Active streams: 0 one, 2 four, 3 eight.  */
+		v = mode.rate >= SDI_RATE_12G ? 3
+		    : mode.rate == SDI_RATE_6G ? 2 : 0;
+		return mode.rate | MODE_DET_LOCKED | v << 4;
+	case RX_TS_DET_STS:
+		if (!locked)
+			return 0;
+		v = TS_DET_LOCKED | mode.t_family << 4 | mode.t_rate() << 8;
+		if (mode.interlaced)
+			v |= TS_DET_INTERLACED;
+		return v;
+	case RX_EDH_STS:
+	case RX_EDH_ERRCNT:
+	case RX_CRC_ERRCNT:
+		return 0;
+	case RX_EDH_ERRCNT_EN:
+		return edh_errcnt_en;
+	case RX_VID_LOCK_WINDOW:
+		return lock_window;
+	case RX_SB_RX_STS:
+		return SB_RX_GT_LOCKED | SB_RX_RESET_DONE;
+	default:
+		if (offset >= RX_ST352_0 && offset <= RX_ST352_7)
+			return locked ? mode.st352() : 0;
+		return 0;
+	}
+}
+
+void sdi_rx_model::reg_write(uint32_t offset, uint32_t val)
+{
+	switch (offset) {
+	case RX_RST_CTRL:
+		if ((rst_ctrl ^ val) & (RST_CTRL_SS_EN | RST_CTRL_SRST))
+			ctrl_ev.notify(SC_ZERO_TIME);
+		/* The error counter clears are self clearing.  */
+		rst_ctrl = val & ~0xcU;
+		break;
+	case RX_MDL_CTRL:
+		mdl_ctrl = val;
+		break;
+	case RX_GIER:
+		gier = val & 1;
+		update_irq();
+		break;
+	case RX_ISR:
+		isr &= ~val;
+		update_irq();
+		break;
+	case RX_IER:
+		ier = val & (ISR_VIDEO_LOCK | ISR_VIDEO_UNLOCK
+			     | ISR_OVERFLOW | ISR_UNDERFLOW);
+		update_irq();
+		break;
+	case RX_EDH_ERRCNT_EN:
+		edh_errcnt_en = val;
+		break;
+	case RX_VID_LOCK_WINDOW:
+		lock_window = val;
+		break;
+	default:
+		break;
+	}
+}
+
+/* Side effects only happen for non-debug accesses.  */
+bool sdi_rx_model::access(tlm::tlm_generic_payload &trans, bool debug)
+{
+	uint32_t offset = trans.get_address() & (SDI_RX_WINDOW_SIZE - 1);
+	unsigned char *data = trans.get_data_ptr();
+	uint32_t v;
+
+	if (trans.get_byte_enable_ptr()) {
+		trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+		return false;
+	}
+	if (trans.get_data_length() != 4 || (offset & 3)) {
+		trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+		return false;
+	}
+
+	if (trans.is_read()) {
+		v = reg_read(offset);
+		memcpy(data, &v, 4);
+	} else if (!debug) {
+		memcpy(&v, data, 4);
+		reg_write(offset, v);
+	}
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+	return true;
+}
+
+void sdi_rx_model::b_transport(tlm::tlm_generic_payload &trans,
+			       sc_time &delay)
+{
+	access(trans, false);
+	delay += cfg.access_latency;
+}
+
+unsigned int sdi_rx_model::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return access(trans, true) ? trans.get_data_length() : 0;
+}
+
+void sdi_rx_model::start_of_simulation(void)
+{
+	wall_start = wall_time();
+}
+
+void sdi_rx_model::end_of_simulation(void)
+{
+	double wall = wall_time() - wall_start;
+
+	cout << name() << ": " << mode.name
+	     << (mode.fractional ? "/1.001" : "") << " from " << cfg.source
+	     << ", " << (locked ? "locked" : "not locked") << "\n";
+	cout << "  " << frames_sent << " frames sent, " << frames_dropped
+	     << " dropped (bridge disabled), " << lines_sent << " lines\n";
+	cout << "  " << overflows << " overflows, " << lines_overflowed
+	     << " lines lost, " << errors << " sink errors, worst lag "
+	     << worst_lag << "\n";
+	if (wall > 0) {
+		cout << "  " << (uint64_t) (frames_sent * 60 / wall)
+		     << " frames per wall clock minute\n";
+	}
+}
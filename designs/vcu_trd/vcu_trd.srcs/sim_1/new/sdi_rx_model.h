@@ -0,0 +1,158 @@
+/*
+ * Loosely timed model of the UHD-SDI RX subsystem (v_smpte_uhdsdi_rx_ss).
+ *
+ * Stands in for v_smpte_uhdsdi_rx_ss_0 so SDI ingest paths can be run
+ * without the GT and SDI RTL.  The "received" signal is a fixed SDI mode
+ * carrying a pattern or the frames of a Y4M file, looped.  Video leaves on
+ * video_out as one write per active line (see sdi_video.h), paced on the
+ * wire cadence of the mode: every line of the raster takes one line period
+ * and the vertical blanking is spent before the first active line.  Lines
+ * stay in the quantum keeper's local time, so a 2160p60 stream costs one
+ * b_transport per line and a context switch per quantum.
+ *
+ * The sink's annotated delay is its backpressure.  When a line comes back
+ * more than fifo_lines line periods behind the wire, the bridge FIFO has
+ * overflowed: ISR OVERFLOW is set and lines are dropped until the stream
+ * catches up with the wire again.
+ *
+ * A pattern is a single packed line sent for every line of every frame.
+ * A Y4M file (4:2:2 or 4:2:0, 8 or 10 bit, the size of the mode) is
+ * mapped, and the frame about to be sent is packed into a single cached
+ * frame unless it is already there.  A one frame file is packed once;
+ * longer files are packed again for every frame sent.
+ *
+ * ctrl is the S_AXI_CTRL register space at 0x80100000 (64 KiB), laid out
+ * as xv_sdirx_hw.h expects:
+ *
+ *   0x00  RST_CTRL      bit 0 SS_EN, bit 1 SRST, bit 2/3 clear EDH/CRC
+ *                       error counters, bit 8 BRIDGE_EN,
+ *                       bit 9 VID_IN_AXI4S_MDL_EN
+ *   0x04  MDL_CTRL      mode search settings, stored
+ *   0x0c  GIER          bit 0 global interrupt enable
+ *   0x10  ISR           bit 0 VIDEO_LOCK, bit 1 VIDEO_UNLOCK,
+ *                       bit 2 OVERFLOW, bit 3 UNDERFLOW; write 1 to clear
+ *   0x14  IER
+ *   0x18  ST352_VALID   one bit per data stream
+ *   0x1c-0x38  ST352_0-7 received ST 352 payloads
+ *   0x3c  VERSION
+ *   0x40  SYS_CONFIG    bit 0 EDH included (C_INCLUDE_EDH)
+ *   0x44  MODE_DET_STS  [2:0] mode, bit 3 locked, [6:4] active streams
+ *   0x48  TS_DET_STS    bit 0 locked, bit 1 interlaced, [7:4] family,
+ *                       [11:8] rate
+ *   0x4c  EDH_STS, 0x54 EDH_ERRCNT, 0x58 CRC_ERRCNT  always clean
+ *   0x50  EDH_ERRCNT_EN, 0x5c VID_LOCK_WINDOW  stored
+ *   0x60  SB_RX_STS     bit 0 GT locked, bit 4 reset done
+ *
+ * Setting SS_EN starts the receiver, which locks lock_delay later.
+ * Frames start going out at the next frame boundary once BRIDGE_EN and
+ * VID_IN_AXI4S_MDL_EN are both set; frames received without them are
+ * counted as dropped.  With everything disabled the model's thread sleeps
+ * on the register event and costs nothing.
+ */
+
+#ifndef SDI_RX_MODEL_H__
+#define SDI_RX_MODEL_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include "sdi_video.h"
+
+/* Defaults follow the vcu_trd_v_smpte_uhdsdi_rx_ss_0_0 configuration.  */
+struct sdi_rx_config {
+	std::string mode;		/* C_LINE_RATE 12G_SDI_8DS: 2160p60 */
+	std::string source;		/* bars, ramp, black or a .y4m file */
+	unsigned int fifo_lines;	/* bridge FIFO depth in lines */
+	bool autostart;			/* come out of reset enabled */
+	sc_core::sc_time lock_delay;
+	sc_core::sc_time access_latency;
+
+	sdi_rx_config(void)
+		: mode("2160p60"), source("bars"), fifo_lines(2),
+		  autostart(false),
+		  lock_delay(1, sc_core::SC_MS),
+		  access_latency(20, sc_core::SC_NS)
+	{}
+};
+
+class sdi_rx_model
+: public sc_core::sc_module
+{
+private:
+	sdi_rx_config cfg;
+	sdi_mode mode;
+
+	/* Registers.  */
+	uint32_t rst_ctrl;
+	uint32_t mdl_ctrl;
+	uint32_t gier;
+	uint32_t isr;
+	uint32_t ier;
+	uint32_t edh_errcnt_en;
+	uint32_t lock_window;
+	bool locked;
+	sc_core::sc_event ctrl_ev;
+	bool irq_level;
+	sc_core::sc_event irq_ev;
+
+	/* Source: a mapped Y4M file or one packed pattern line.  */
+	const uint8_t *y4m;
+	size_t y4m_len;
+	size_t y4m_first;		/* offset of the first FRAME */
+	size_t y4m_frame_len;		/* header included */
+	unsigned int y4m_frames;
+	unsigned int y4m_depth;
+	bool y4m_420;
+	int packed_frame;		/* y4m frame held in packed, -1 none */
+	std::vector<uint8_t> packed;
+	unsigned int stride;		/* 0: patterns repeat one line */
+
+	/* Stats.  */
+	uint64_t frames_sent;
+	uint64_t frames_dropped;
+	uint64_t lines_sent;
+	uint64_t lines_overflowed;
+	uint64_t overflows;
+	uint64_t errors;
+	sc_core::sc_time worst_lag;
+	double wall_start;
+
+	bool open_y4m(const char *path);
+	void make_pattern(void);
+	const uint8_t *frame_data(uint64_t frame);
+
+	void send_frame(tlm_utils::tlm_quantumkeeper &qk,
+			const sc_core::sc_time &start, uint64_t frame);
+	void rx_thread(void);
+
+	void set_lock(bool lock);
+	void update_irq(void);
+	void irq_method(void);
+	uint32_t reg_read(uint32_t offset);
+	void reg_write(uint32_t offset, uint32_t val);
+	bool access(tlm::tlm_generic_payload &trans, bool debug);
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+public:
+	SC_HAS_PROCESS(sdi_rx_model);
+
+	tlm_utils::simple_initiator_socket<sdi_rx_model> video_out;
+	tlm_utils::simple_target_socket<sdi_rx_model> ctrl;
+	sc_core::sc_out<bool> irq;
+
+	sdi_rx_model(sc_core::sc_module_name name,
+		     const sdi_rx_config &cfg = sdi_rx_config());
+	~sdi_rx_model(void);
+
+	void start_of_simulation(void);
+	void end_of_simulation(void);
+};
+
+#endif
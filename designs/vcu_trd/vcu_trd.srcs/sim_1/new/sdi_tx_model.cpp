@@ -0,0 +1,376 @@
+/*
+ * Paced sink model of the UHD-SDI TX subsystem (v_smpte_uhdsdi_tx_ss).
+ */
+
+#include <string.h>
+
+#include <iostream>
+
+#include "sdi_tx_model.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define SDI_TX_WINDOW_SIZE	0x20000
+
+#define TX_RST_CTRL		0x00
+#define TX_MDL_CTRL		0x04
+#define TX_GIER			0x0c
+#define TX_ISR			0x10
+#define TX_IER			0x14
+#define TX_ST352_LINE		0x18
+#define TX_ST352_DATA_CH0	0x1c
+#define TX_ST352_DATA_CH7	0x38
+#define TX_VERSION		0x3c
+#define TX_SYS_CONFIG		0x40
+#define TX_SB_TX_STS		0x60
+
+#define RST_CTRL_SS_EN		(1 << 0)
+#define RST_CTRL_SRST		(1 << 1)
+#define RST_CTRL_BRIDGE_EN	(1 << 8)
+#define RST_CTRL_AXI4S_EN	(1 << 9)
+#define RST_CTRL_RUN		(RST_CTRL_SS_EN | RST_CTRL_BRIDGE_EN \
+				 | RST_CTRL_AXI4S_EN)
+
+#define MDL_CTRL_MODE_SHIFT	4
+#define MDL_CTRL_MODE_MASK	(7 << MDL_CTRL_MODE_SHIFT)
+
+#define ISR_GTTX_RSTDONE	(1 << 0)
+#define ISR_OVERFLOW		(1 << 1)
+#define ISR_UNDERFLOW		(1 << 2)
+#define ISR_ALL			(ISR_GTTX_RSTDONE | ISR_OVERFLOW \
+				 | ISR_UNDERFLOW)
+
+#define SB_TX_GT_RESETDONE	(1 << 0)
+#define SB_TX_GT_LOCKED		(1 << 1)
+
+#define SDI_TX_VERSION		0x02000000
+#define SDI_TX_SYS_CONFIG_EDH	(1 << 0)
+
+sdi_tx_model::sdi_tx_model(sc_module_name name, const sdi_tx_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  rst_ctrl(0),
+	  mdl_ctrl(0),
+	  gier(0),
+	  isr(0),
+	  ier(0),
+	  st352_line(0),
+	  irq_level(false),
+	  running(false),
+	  frame(0),
+	  next_frame(0),
+	  next_line(0),
+	  in_frame(false),
+	  mode_mismatch(false),
+	  frames(0),
+	  lines(0),
+	  late(0),
+	  underruns(0),
+	  held(0),
+	  slips(0),
+	  short_frames(0),
+	  discarded(0),
+	  sof_hist(cfg.hist_bins + 2),
+	  video_in("video_in"),
+	  ctrl("ctrl"),
+	  irq("irq")
+{
+	video_in.register_b_transport(this, &sdi_tx_model::video_b_transport);
+	ctrl.register_b_transport(this, &sdi_tx_model::b_transport);
+	ctrl.register_transport_dbg(this, &sdi_tx_model::transport_dbg);
+
+	if (!sdi_find_mode(cfg.mode.c_str(), mode)) {
+		SC_REPORT_ERROR(this->name(), ("unknown SDI mode "
+				+ cfg.mode).c_str());
+		sdi_find_mode("2160p60", mode);
+	}
+	line_period = mode.line_period();
+	frame_period = mode.frame_period();
+	memset(st352_data, 0, sizeof st352_data);
+
+	if (cfg.autostart) {
+		rst_ctrl = RST_CTRL_RUN;
+		isr = ISR_GTTX_RSTDONE;
+	}
+
+	SC_METHOD(irq_method);
+	sensitive << irq_ev;
+}
+
+/* When line l of raster frame f has to be in the FIFO.  */
+sc_time sdi_tx_model::due(uint64_t f, unsigned int l) const
+{
+	return start0 + frame_period * (double) f + line_period * (double) l;
+}
+
+bool sdi_tx_model::enabled(void) const
+{
+	return (rst_ctrl & (RST_CTRL_RUN | RST_CTRL_SRST)) == RST_CTRL_RUN;
+}
+
+/*
+ * A start of frame at arrival.  The first one after enabling starts the
+ * raster with line 0 due once the FIFO would be primed.
+ */
+void sdi_tx_model::start_frame(const sc_time &arrival)
+{
+	sc_time d0;
+	uint64_t f;
+	double lead;
+
+	if (in_frame)
+		short_frames++;
+
+	if (!running) {
+		running = true;
+		start0 = arrival + line_period * (double) cfg.fifo_lines;
+		next_frame = 0;
+	}
+
+	f = next_frame;
+	d0 = due(f, 0);
+	if (arrival > d0) {
+		/* Line 0 went out empty; take the next slot it can make.  */
+		f += (uint64_t) ((arrival - d0) / frame_period) + 1;
+		slips += f - next_frame;
+		sof_hist[0]++;
+	} else {
+		lead = (d0 - arrival) / line_period;
+		if (lead >= cfg.hist_bins)
+			sof_hist[cfg.hist_bins + 1]++;
+		else
+			sof_hist[1 + (unsigned int) lead]++;
+	}
+
+	frame = f;
+	next_frame = f + 1;
+	next_line = 0;
+	in_frame = true;
+}
+
+void sdi_tx_model::video_b_transport(tlm::tlm_generic_payload &trans,
+				     sc_time &delay)
+{
+	sc_time arrival = sc_time_stamp() + delay;
+	sc_time room = line_period * (double) cfg.fifo_lines;
+	sdi_video_ext *ext;
+	unsigned int l;
+	sc_time d;
+	bool sof;
+
+	if (!trans.is_write()) {
+		trans.set_response_status(tlm::TLM_COMMAND_ERROR_RESPONSE);
+		return;
+	}
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+
+	if (!enabled()) {
+		discarded++;
+		return;
+	}
+
+	/* Without the extension lines are numbered as they come.  */
+	trans.get_extension(ext);
+	if (ext) {
+		sof = ext->sof;
+		l = ext->line;
+	} else {
+		sof = !in_frame || next_line >= mode.height;
+		l = sof ? 0 : next_line;
+	}
+
+	if (sof)
+		start_frame(arrival);
+	if (!in_frame || l >= mode.height) {
+		/* Waiting for a start of frame.  */
+		discarded++;
+		return;
+	}
+
+	d = due(frame, l);
+	if (arrival > d) {
+		underruns++;
+		if (arrival - d > worst_underrun)
+			worst_underrun = arrival - d;
+		isr |= ISR_UNDERFLOW;
+		update_irq();
+	} else if (d - arrival < line_period) {
+		late++;
+	} else if (d - arrival > room) {
+		/* The FIFO is full, hold the line until it has room.  */
+		delay += d - room - arrival;
+		held++;
+	}
+	lines++;
+
+	next_line = l + 1;
+	if (next_line == mode.height) {
+		frames++;
+		in_frame = false;
+	}
+}
+
+/*
+ * Called from both the video and the ctrl b_transport; irq_method is the
+ * only writer of the port.
+ */
+void sdi_tx_model::update_irq(void)
+{
+	irq_level = (gier & 1) && (isr & ier);
+	irq_ev.notify(SC_ZERO_TIME);
+}
+
+void sdi_tx_model::irq_method(void)
+{
+	irq.write(irq_level);
+}
+
+uint32_t sdi_tx_model::reg_read(uint32_t offset)
+{
+	switch (offset) {
+	case TX_RST_CTRL:
+		return rst_ctrl;
+	case TX_MDL_CTRL:
+		return mdl_ctrl;
+	case TX_GIER:
+		return gier;
+	case TX_ISR:
+		return isr;
+	case TX_IER:
+		return ier;
+	case TX_ST352_LINE:
+		return st352_line;
+	case TX_VERSION:
+		return SDI_TX_VERSION;
+	case TX_SYS_CONFIG:
+		return SDI_TX_SYS_CONFIG_EDH;
+	case TX_SB_TX_STS:
+		return SB_TX_GT_RESETDONE | SB_TX_GT_LOCKED;
+	default:
+		if (offset >= TX_ST352_DATA_CH0
+		    && offset <= TX_ST352_DATA_CH7)
+			return st352_data[(offset - TX_ST352_DATA_CH0) / 4];
+		return 0;
+	}
+}
+
+void sdi_tx_model::reg_write(uint32_t offset, uint32_t val)
+{
+	unsigned int m;
+
+	switch (offset) {
+	case TX_RST_CTRL:
+		if ((val & RST_CTRL_SS_EN) && !(rst_ctrl & RST_CTRL_SS_EN))
+			isr |= ISR_GTTX_RSTDONE;
+		rst_ctrl = val;
+		if (!enabled()) {
+			/* The raster restarts with the next frame.  */
+			running = false;
+			in_frame = false;
+		}
+		update_irq();
+		break;
+	case TX_MDL_CTRL:
+		mdl_ctrl = val;
+		m = (val & MDL_CTRL_MODE_MASK) >> MDL_CTRL_MODE_SHIFT;
+		if (m != (unsigned int) mode.rate && !mode_mismatch) {
+			mode_mismatch = true;
+			SC_REPORT_WARNING(name(), "MDL_CTRL mode differs from "
+					  "the configured SDI mode");
+		}
+		break;
+	case TX_GIER:
+		gier = val & 1;
+		update_irq();
+		break;
+	case TX_ISR:
+		isr &= ~val;
+		update_irq();
+		break;
+	case TX_IER:
+		ier = val & ISR_ALL;
+		update_irq();
+		break;
+	case TX_ST352_LINE:
+		st352_line = val;
+		break;
+	default:
+		if (offset >= TX_ST352_DATA_CH0
+		    && offset <= TX_ST352_DATA_CH7)
+			st352_data[(offset - TX_ST352_DATA_CH0) / 4] = val;
+		break;
+	}
+}
+
+/* Side effects only happen for non-debug accesses.  */
+bool sdi_tx_model::access(tlm::tlm_generic_payload &trans, bool debug)
+{
+	uint32_t offset = trans.get_address() & (SDI_TX_WINDOW_SIZE - 1);
+	unsigned char *data = trans.get_data_ptr();
+	uint32_t v;
+
+	if (trans.get_byte_enable_ptr()) {
+		trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+		return false;
+	}
+	if (trans.get_data_length() != 4 || (offset & 3)) {
+		trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+		return false;
+	}
+
+	if (trans.is_read()) {
+		v = reg_read(offset);
+		memcpy(data, &v, 4);
+	} else if (!debug) {
+		memcpy(&v, data, 4);
+		reg_write(offset, v);
+	}
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+	return true;
+}
+
+void sdi_tx_model::b_transport(tlm::tlm_generic_payload &trans,
+			       sc_time &delay)
+{
+	access(trans, false);
+	delay += cfg.access_latency;
+}
+
+unsigned int sdi_tx_model::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return access(trans, true) ? trans.get_data_length() : 0;
+}
+
+void sdi_tx_model::end_of_simulation(void)
+{
+	uint64_t idle = 0;
+	unsigned int i;
+
+	/* Raster slots that went by with nothing after the last frame.  */
+	if (running && !in_frame && sc_time_stamp() > due(next_frame, 0)) {
+		idle = (uint64_t) ((sc_time_stamp() - due(next_frame, 0))
+				   / frame_period) + 1;
+	}
+
+	cout << name() << ": " << mode.name
+	     << (mode.fractional ? "/1.001" : "") << ", " << frames
+	     << " frames, " << lines << " lines, " << discarded
+	     << " discarded\n";
+	cout << "  " << underruns << " underruns (worst " << worst_underrun
+	     << "), " << late << " late lines, " << held
+	     << " held by backpressure\n";
+	cout << "  " << slips << " frame slips, " << short_frames
+	     << " short frames, " << idle << " empty slots at the end\n";
+	cout << "  SOF lead in lines:";
+	if (sof_hist[0])
+		cout << " late " << sof_hist[0];
+	for (i = 0; i < cfg.hist_bins; i++) {
+		if (sof_hist[i + 1])
+			cout << " " << i << ":" << sof_hist[i + 1];
+	}
+	if (sof_hist[cfg.hist_bins + 1])
+		cout << " " << cfg.hist_bins << "+:"
+		     << sof_hist[cfg.hist_bins + 1];
+	cout << "\n";
+}
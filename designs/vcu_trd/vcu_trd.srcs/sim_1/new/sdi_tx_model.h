@@ -0,0 +1,149 @@
+/*
+ * Paced sink model of the UHD-SDI TX subsystem (v_smpte_uhdsdi_tx_ss).
+ *
+ * Stands in for v_smpte_uhdsdi_tx_ss_0, the display end of the pipeline,
+ * to show whether decode and frame buffer reads keep SDI output fed.
+ * video_in takes AXI4-Stream video as one write per line (see
+ * sdi_video.h) and checks every line against the raster of the mode.
+ *
+ * The raster starts with the first start of frame accepted after the
+ * core is enabled: its line 0 is due, i.e. has to be in the bridge FIFO,
+ * once fifo_lines line periods have primed the FIFO, at start0.  From
+ * then on line l of raster frame f is due at
+ *
+ *   start0 + f * frame_period + l * line_period
+ *
+ * so the vertical blanking of every following frame is the source's time
+ * to fetch the next one.
+ *
+ * Arrival is the initiator's local time (sc_time_stamp() + delay).  A line
+ * arriving after its due time is an underrun (ISR UNDERFLOW).  One
+ * arriving with less than a line period to spare is late.  A line more
+ * than fifo_lines line periods early finds the FIFO full and is held: the
+ * delay is annotated until it fits, which is the backpressure tready would
+ * apply.  A start of frame arriving after line 0 of its raster frame was
+ * due lost that frame slot; it moves to the next slot it can make and the
+ * skipped slots are counted as frame slips (the display repeated a
+ * frame).  Every start of frame is also binned by its lead on line 0 into
+ * a histogram of line periods.
+ *
+ * Everything happens in b_transport: the model has no process, so it
+ * costs nothing while no video arrives.  Slots that elapsed after the last
+ * frame are accounted for at the end of simulation.
+ *
+ * ctrl is the S_AXI_CTRL register space at 0x80120000 (128 KiB), laid out
+ * as xv_sditx_hw.h expects:
+ *
+ *   0x00  RST_CTRL      bit 0 SS_EN, bit 1 SRST, bit 8 BRIDGE_EN,
+ *                       bit 9 VID_IN_AXI4S_MDL_EN
+ *   0x04  MDL_CTRL      [6:4] MODE, bit 7 fractional, rest stored
+ *   0x0c  GIER          bit 0 global interrupt enable
+ *   0x10  ISR           bit 0 GTTX_RSTDONE, bit 1 OVERFLOW,
+ *                       bit 2 UNDERFLOW; write 1 to clear
+ *   0x14  IER
+ *   0x18  ST352_LINE    stored
+ *   0x1c-0x38  ST352_DATA_CH0-7 stored
+ *   0x3c  VERSION
+ *   0x40  SYS_CONFIG    bit 0 EDH included (C_INCLUDE_EDH)
+ *   0x60  SB_TX_STS     bit 0 GT reset done, bit 1 GT locked
+ *
+ * The raster comes from the configured mode.  The MODE written by the
+ * driver is kept and a mismatch with the configured mode is reported.
+ */
+
+#ifndef SDI_TX_MODEL_H__
+#define SDI_TX_MODEL_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#include "sdi_video.h"
+
+/* Defaults follow the vcu_trd_v_smpte_uhdsdi_tx_ss_0_0 configuration.  */
+struct sdi_tx_config {
+	std::string mode;		/* C_LINE_RATE 12G_SDI_8DS: 2160p60 */
+	unsigned int fifo_lines;	/* bridge FIFO depth in lines */
+	unsigned int hist_bins;		/* SOF lead histogram, line periods */
+	bool autostart;			/* come out of reset enabled */
+	sc_core::sc_time access_latency;
+
+	sdi_tx_config(void)
+		: mode("2160p60"), fifo_lines(2), hist_bins(16),
+		  autostart(false),
+		  access_latency(20, sc_core::SC_NS)
+	{}
+};
+
+class sdi_tx_model
+: public sc_core::sc_module
+{
+private:
+	sdi_tx_config cfg;
+	sdi_mode mode;
+	sc_core::sc_time line_period;
+	sc_core::sc_time frame_period;
+
+	/* Registers.  */
+	uint32_t rst_ctrl;
+	uint32_t mdl_ctrl;
+	uint32_t gier;
+	uint32_t isr;
+	uint32_t ier;
+	uint32_t st352_line;
+	uint32_t st352_data[8];
+	bool irq_level;
+	sc_core::sc_event irq_ev;
+
+	/* Raster.  */
+	bool running;		/* start0 is valid */
+	sc_core::sc_time start0;
+	uint64_t frame;		/* raster frame of the current input frame */
+	uint64_t next_frame;
+	unsigned int next_line;	/* expected input line */
+	bool in_frame;
+	bool mode_mismatch;
+
+	/* Stats.  */
+	uint64_t frames;
+	uint64_t lines;
+	uint64_t late;
+	uint64_t underruns;
+	uint64_t held;
+	uint64_t slips;
+	uint64_t short_frames;
+	uint64_t discarded;	/* lines while disabled */
+	sc_core::sc_time worst_underrun;
+	std::vector<uint64_t> sof_hist;	/* [0] late, then one per line */
+
+	sc_core::sc_time due(uint64_t f, unsigned int l) const;
+	void start_frame(const sc_core::sc_time &arrival);
+	void video_b_transport(tlm::tlm_generic_payload &trans,
+			       sc_time &delay);
+
+	bool enabled(void) const;
+	void update_irq(void);
+	void irq_method(void);
+	uint32_t reg_read(uint32_t offset);
+	void reg_write(uint32_t offset, uint32_t val);
+	bool access(tlm::tlm_generic_payload &trans, bool debug);
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+public:
+	SC_HAS_PROCESS(sdi_tx_model);
+
+	tlm_utils::simple_target_socket<sdi_tx_model> video_in;
+	tlm_utils::simple_target_socket<sdi_tx_model> ctrl;
+	sc_core::sc_out<bool> irq;
+
+	sdi_tx_model(sc_core::sc_module_name name,
+		     const sdi_tx_config &cfg = sdi_tx_config());
+
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,202 @@
+/*
+ * Common definitions for the UHD-SDI subsystem models.
+ */
+
+#include <string.h>
+#include <iostream>
+
+#include "sdi_video.h"
+
+using namespace sc_core;
+using namespace std;
+
+/* Transport families as reported in TS_DET_STS.  */
+#define SDI_FAMILY_1920		0
+#define SDI_FAMILY_1280		1
+#define SDI_FAMILY_2048		2
+
+static const struct sdi_mode sdi_modes[] = {
+	{ "720p60", 1280, 720, 1650, 750, 60, false,
+	  SDI_RATE_HD, 0x84, SDI_FAMILY_1280, false },
+	{ "720p50", 1280, 720, 1980, 750, 50, false,
+	  SDI_RATE_HD, 0x84, SDI_FAMILY_1280, false },
+	{ "1080i60", 1920, 1080, 2200, 1125, 30, true,
+	  SDI_RATE_HD, 0x85, SDI_FAMILY_1920, false },
+	{ "1080i50", 1920, 1080, 2640, 1125, 25, true,
+	  SDI_RATE_HD, 0x85, SDI_FAMILY_1920, false },
+	{ "1080p30", 1920, 1080, 2200, 1125, 30, false,
+	  SDI_RATE_HD, 0x85, SDI_FAMILY_1920, false },
+	{ "1080p25", 1920, 1080, 2640, 1125, 25, false,
+	  SDI_RATE_HD, 0x85, SDI_FAMILY_1920, false },
+	{ "1080p24", 1920, 1080, 2750, 1125, 24, false,
+	  SDI_RATE_HD, 0x85, SDI_FAMILY_1920, false },
+	{ "1080p60", 1920, 1080, 2200, 1125, 60, false,
+	  SDI_RATE_3G, 0x89, SDI_FAMILY_1920, false },
+	{ "1080p50", 1920, 1080, 2640, 1125, 50, false,
+	  SDI_RATE_3G, 0x89, SDI_FAMILY_1920, false },
+	{ "2160p30", 3840, 2160, 4400, 2250, 30, false,
+	  SDI_RATE_6G, 0xc0, SDI_FAMILY_1920, false },
+	{ "2160p25", 3840, 2160, 5280, 2250, 25, false,
+	  SDI_RATE_6G, 0xc0, SDI_FAMILY_1920, false },
+	{ "2160p24", 3840, 2160, 5500, 2250, 24, false,
+	  SDI_RATE_6G, 0xc0, SDI_FAMILY_1920, false },
+	{ "2160p60", 3840, 2160, 4400, 2250, 60, false,
+	  SDI_RATE_12G, 0xce, SDI_FAMILY_1920, false },
+	{ "2160p50", 3840, 2160, 5280, 2250, 50, false,
+	  SDI_RATE_12G, 0xce, SDI_FAMILY_1920, false },
+	{ "4096x2160p60", 4096, 2160, 4400, 2250, 60, false,
+	  SDI_RATE_12G, 0xce, SDI_FAMILY_2048, false },
+	{ "4096x2160p50", 4096, 2160, 5280, 2250, 50, false,
+	  SDI_RATE_12G, 0xce, SDI_FAMILY_2048, false },
+};
+
+/* Fractional rates are looked up as their integer counterpart.  */
+static const struct {
+	const char *frac;
+	const char *integer;
+} sdi_frac_rates[] = {
+	{ "59.94", "60" },
+	{ "29.97", "30" },
+	{ "23.98", "24" },
+};
+
+bool sdi_find_mode(const char *name, sdi_mode &mode)
+{
+	string n = name;
+	bool frac = false;
+	unsigned int i;
+
+	for (i = 0; i < sizeof sdi_frac_rates / sizeof sdi_frac_rates[0];
+	     i++) {
+		size_t len = strlen(sdi_frac_rates[i].frac);
+
+		if (n.size() > len
+		    && n.compare(n.size() - len, len,
+				 sdi_frac_rates[i].frac) == 0) {
+			n.replace(n.size() - len, len,
+				  sdi_frac_rates[i].integer);
+			frac = true;
+			break;
+		}
+	}
+
+	for (i = 0; i < sizeof sdi_modes / sizeof sdi_modes[0]; i++) {
+		if (n != sdi_modes[i].name)
+			continue;
+		mode = sdi_modes[i];
+		mode.fractional = frac;
+		if (frac && mode.rate == SDI_RATE_12G)
+			mode.rate = SDI_RATE_12G_FRAC;
+		return true;
+	}
+	return false;
+}
+
+sc_time sdi_mode::frame_period(void) const
+{
+	double s = 1.0 / fps;
+
+	if (fractional)
+		s = s * 1001 / 1000;
+	return sc_time(s, SC_SEC);
+}
+
+sc_time sdi_mode::line_period(void) const
+{
+	return frame_period() / total_height;
+}
+
+unsigned int sdi_mode::line_bytes(void) const
+{
+	return width / SDI_AXIS_PIXELS_PER_BEAT * SDI_AXIS_BEAT_BYTES;
+}
+
+/* XV_SDIRX frame rate codes.  */
+unsigned int sdi_mode::t_rate(void) const
+{
+	switch (fps) {
+	case 24:
+		return fractional ? 2 : 3;
+	case 25:
+		return 5;
+	case 30:
+		return fractional ? 6 : 7;
+	case 50:
+		return 9;
+	case 60:
+		return fractional ? 10 : 11;
+	default:
+		return 0;
+	}
+}
+
+/*
+ * Byte 1 payload id, byte 2 scan and picture rate, byte 3 sampling
+ * (0: 4:2:2 YCbCr), byte 4 bit depth (1: 10 bit).
+ */
+uint32_t sdi_mode::st352(void) const
+{
+	uint32_t b2 = t_rate();
+
+	if (!interlaced)
+		b2 |= 0xc0;
+	return st352_id | b2 << 8 | 1 << 24;
+}
+
+void sdi_pack_line(const uint16_t *y, const uint16_t *c, unsigned int width,
+		   uint8_t *out)
+{
+	unsigned int x;
+
+	for (x = 0; x < width; x += 2) {
+		uint64_t beat;
+
+		beat = (uint64_t) (y[x] & 0x3ff)
+		       | (uint64_t) (c[x] & 0x3ff) << 10
+		       | (uint64_t) (y[x + 1] & 0x3ff) << 20
+		       | (uint64_t) (c[x + 1] & 0x3ff) << 30;
+		memcpy(out, &beat, SDI_AXIS_BEAT_BYTES);
+		out += SDI_AXIS_BEAT_BYTES;
+	}
+}
+
+tlm::tlm_extension_base *sdi_video_ext::clone(void) const
+{
+	return new sdi_video_ext(*this);
+}
+
+void sdi_video_ext::copy_from(const tlm::tlm_extension_base &ext)
+{
+	*this = static_cast<const sdi_video_ext &>(ext);
+}
+
+sdi_null_sink::sdi_null_sink(sc_module_name name, const sc_time &latency)
+	: sc_module(name),
+	  latency(latency),
+	  lines(0),
+	  frames(0),
+	  bytes(0),
+	  socket("socket")
+{
+	socket.register_b_transport(this, &sdi_null_sink::b_transport);
+}
+
+void sdi_null_sink::b_transport(tlm::tlm_generic_payload &trans,
+				sc_time &delay)
+{
+	sdi_video_ext *ext;
+
+	trans.get_extension(ext);
+	if (ext && ext->sof)
+		frames++;
+	lines++;
+	bytes += trans.get_data_length();
+	delay += latency;
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+}
+
+void sdi_null_sink::end_of_simulation(void)
+{
+	cout << name() << ": " << frames << " frames, " << lines
+	     << " lines, " << bytes << " bytes\n";
+}
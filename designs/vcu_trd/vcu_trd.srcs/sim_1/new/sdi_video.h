@@ -0,0 +1,111 @@
+/*
+ * Common definitions for the UHD-SDI subsystem models.
+ *
+ * Video between the SDI subsystems and the rest of the PL is AXI4-Stream
+ * video (UG934).  The models carry it as one TLM write per active line:
+ * the payload holds the line's beats and a sdi_video_ext carries tuser
+ * (start of frame) and tlast (end of line) along with the line and frame
+ * numbers.  Both subsystems in vcu_trd carry 2 pixels per clock
+ * (C_PIXELS_PER_CLOCK 2) of 10 bit YCbCr 4:2:2, so a beat is 8 bytes:
+ *
+ *   [9:0] Y0  [19:10] Cb  [29:20] Y1  [39:30] Cr  [63:40] zero
+ *
+ * sdi_mode describes an SDI video format: active and total raster, frame
+ * rate and the codes the SDI cores report for it.  sdi_null_sink is an
+ * AXI4-Stream video sink that only counts, for throughput runs where the
+ * stream goes nowhere.
+ */
+
+#ifndef SDI_VIDEO_H__
+#define SDI_VIDEO_H__
+
+#include <stdint.h>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#define SDI_AXIS_BEAT_BYTES	8
+#define SDI_AXIS_PIXELS_PER_BEAT 2
+
+/* MODE field of the SDI RX/TX cores.  */
+enum sdi_rate {
+	SDI_RATE_HD = 0,
+	SDI_RATE_SD = 1,
+	SDI_RATE_3G = 2,
+	SDI_RATE_6G = 4,
+	SDI_RATE_12G = 5,
+	SDI_RATE_12G_FRAC = 6,
+};
+
+struct sdi_mode {
+	const char *name;
+	unsigned int width;
+	unsigned int height;
+	unsigned int total_width;	/* samples per line, with blanking */
+	unsigned int total_height;	/* lines per frame, with blanking */
+	unsigned int fps;		/* frames, not fields */
+	bool interlaced;
+	enum sdi_rate rate;
+	uint8_t st352_id;		/* SMPTE ST 352 payload byte 1 */
+	unsigned int t_family;		/* transport family */
+	bool fractional;		/* rates / 1.001 */
+
+	/* Line and frame cadence on the wire.  */
+	sc_core::sc_time frame_period(void) const;
+	sc_core::sc_time line_period(void) const;
+	/* Bytes of one active line on AXI4-Stream.  */
+	unsigned int line_bytes(void) const;
+	/* T_RATE code of the transport detector.  */
+	unsigned int t_rate(void) const;
+	/* ST 352 payload as the cores present it, byte 1 in bits [7:0].  */
+	uint32_t st352(void) const;
+};
+
+/*
+ * Look a mode up by name ("1080p60", "2160p60", "2160p59.94", ...).
+ * Fractional names map to the integer entry with fractional set.
+ * Returns false if unknown.
+ */
+bool sdi_find_mode(const char *name, sdi_mode &mode);
+
+/* Pack width 10 bit 4:2:2 pixels (interleaved Cb/Cr in c) as beats.  */
+void sdi_pack_line(const uint16_t *y, const uint16_t *c, unsigned int width,
+		   uint8_t *out);
+
+class sdi_video_ext
+: public tlm::tlm_extension<sdi_video_ext>
+{
+public:
+	bool sof;		/* tuser on the first beat */
+	bool eol;		/* tlast on the last beat */
+	unsigned int line;	/* active line, 0 based */
+	uint64_t frame;
+
+	sdi_video_ext(void) : sof(false), eol(true), line(0), frame(0) {}
+
+	tlm::tlm_extension_base *clone(void) const;
+	void copy_from(const tlm::tlm_extension_base &ext);
+};
+
+/* Accepts every line, after latency per line.  */
+class sdi_null_sink
+: public sc_core::sc_module
+{
+private:
+	sc_core::sc_time latency;
+	uint64_t lines;
+	uint64_t frames;
+	uint64_t bytes;
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+public:
+	tlm_utils::simple_target_socket<sdi_null_sink> socket;
+
+	sdi_null_sink(sc_core::sc_module_name name,
+		      const sc_core::sc_time &latency = sc_core::SC_ZERO_TIME);
+
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,227 @@
+/*
+ * TLM traffic model of the VCU decoder AXI masters DecData0/DecData1.
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include <iostream>
+
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include "vcu_dec_traffic.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define DEC_BITSTREAM_SIZE (16 << 20)
+
+vcu_dec_traffic::vcu_dec_traffic(sc_module_name name,
+				 const vcu_dec_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  cores_done(0),
+	  dec_data0("dec_data0"),
+	  dec_data1("dec_data1")
+{
+	unsigned int core;
+
+	port[0] = new vcu_axi_master("DecData0", dec_data0, cfg.burst_bytes);
+	port[1] = new vcu_axi_master("DecData1", dec_data1, cfg.burst_bytes);
+
+	for (core = 0; core < 2; core++) {
+		sc_spawn(sc_bind(&vcu_dec_traffic::core_thread, this, core),
+			 sc_gen_unique_name("core"));
+	}
+}
+
+vcu_dec_traffic::~vcu_dec_traffic(void)
+{
+	delete port[0];
+	delete port[1];
+}
+
+/*
+ * Byte offset of pixel x in a line, laid out as in vcu_enc_traffic: 10 bit
+ * samples pack three to a word (linear XV15; the 64x4 tiled layout of
+ * tools/vcu_tile packs four to five bytes instead, so this is the larger
+ * of the two).
+ */
+uint64_t vcu_dec_traffic::line_offset(unsigned int x) const
+{
+	if (cfg.bit_depth > 8)
+		return (uint64_t) (x / 3) * 4;
+	return x;
+}
+
+/* Bytes holding pixels [x0, x1) of a line.  */
+uint64_t vcu_dec_traffic::line_bytes(unsigned int x0, unsigned int x1) const
+{
+	if (cfg.bit_depth > 8)
+		x1 += 2;
+	return line_offset(x1) - line_offset(x0);
+}
+
+/* 4:2:0, luma lines then half as many chroma lines.  */
+uint64_t vcu_dec_traffic::frame_bytes(void) const
+{
+	return line_bytes(0, cfg.width) * (cfg.height + (cfg.height + 1) / 2);
+}
+
+/* Moves pixels [x0, x1) x [y0, y1) of the picture at pic, both planes.  */
+void vcu_dec_traffic::transfer_block(tlm_utils::tlm_quantumkeeper &qk,
+				     vcu_axi_master *m, tlm::tlm_command cmd,
+				     uint64_t pic,
+				     unsigned int x0, unsigned int y0,
+				     unsigned int x1, unsigned int y1)
+{
+	uint64_t stride = line_bytes(0, cfg.width);
+	uint64_t chroma = pic + stride * cfg.height;
+	uint64_t off = line_offset(x0);
+	uint64_t len = line_bytes(x0, x1);
+
+	if (x0 >= x1 || y0 >= y1)
+		return;
+	m->transfer_2d(qk, cmd, pic + stride * y0 + off, len, y1 - y0,
+		       stride);
+	m->transfer_2d(qk, cmd, chroma + stride * (y0 / 2) + off, len,
+		       (y1 + 1) / 2 - y0 / 2, stride);
+}
+
+void vcu_dec_traffic::core_thread(unsigned int core)
+{
+	tlm_utils::tlm_quantumkeeper qk;
+	vcu_axi_master *m = port[core];
+	uint64_t fb = frame_bytes();
+	uint64_t bs_base = cfg.base + fb * cfg.dpb_frames;
+	unsigned int ctbs_x = (cfg.width + cfg.ctb_size - 1) / cfg.ctb_size;
+	unsigned int ctbs_y = (cfg.height + cfg.ctb_size - 1) / cfg.ctb_size;
+	unsigned int nr_ctbs = ctbs_x * ctbs_y;
+	sc_time period(1.0 / cfg.fps, SC_SEC);
+	/* Both cores run in parallel, each on half of the CTBs.  */
+	sc_time ctb_compute = period * cfg.compute_load * 2 / nr_ctbs;
+	double ref_miss = 0;
+	uint64_t bs_per_ctb = (uint64_t) cfg.bitrate_kbps * 1000 / 8
+			      / cfg.fps / nr_ctbs;
+	uint64_t bs_off = 0;
+	uint64_t bs_pending = 0;
+	unsigned int last_ref = 0;
+	uint64_t frame;
+
+	/* Each core reads its own half of the bitstream buffer.  */
+	bs_base += core * (DEC_BITSTREAM_SIZE / 2);
+
+	qk.reset();
+	for (frame = 0; ; frame++) {
+		sc_time release = period * (double) frame;
+		unsigned int pos = frame ? (frame - 1) % (cfg.bframes + 1) : 0;
+		bool is_i = frame == 0;
+		bool is_p = !is_i && pos == 0;
+		unsigned int refs = is_i ? 0 : (is_p ? 1 : 2);
+		unsigned int out = (last_ref + 1) % cfg.dpb_frames;
+		unsigned int x, y, r;
+		unsigned int x0, y0, x1, y1;
+		unsigned int wx0, wy0, wx1, wy1;
+		sc_time start;
+
+		/* A picture is decoded once released, never ahead.  */
+		if (qk.get_current_time() < release)
+			qk.set(release - sc_time_stamp());
+		qk.sync();
+		start = sc_time_stamp();
+
+		for (y = core; y < ctbs_y; y += 2) {
+			y0 = y * cfg.ctb_size;
+			y1 = min(y0 + cfg.ctb_size, cfg.height);
+			wy0 = y0 > cfg.ref_margin ? y0 - cfg.ref_margin : 0;
+			wy1 = min(y1 + cfg.ref_margin, cfg.height);
+			for (x = 0; x < ctbs_x; x++) {
+				x0 = x * cfg.ctb_size;
+				x1 = min(x0 + cfg.ctb_size, cfg.width);
+				wx0 = x0 > cfg.ref_margin
+				      ? x0 - cfg.ref_margin : 0;
+				wx1 = min(x1 + cfg.ref_margin, cfg.width);
+
+				bs_pending += bs_per_ctb;
+				if (bs_pending >= cfg.burst_bytes) {
+					if (bs_off + bs_pending
+					    > DEC_BITSTREAM_SIZE / 2)
+						bs_off = 0;
+					m->transfer(qk, tlm::TLM_READ_COMMAND,
+						    bs_base + bs_off,
+						    bs_pending);
+					bs_off += bs_pending;
+					bs_pending = 0;
+				}
+				for (r = 0; r < refs; r++) {
+					unsigned int ref =
+						(last_ref + cfg.dpb_frames - r)
+						% cfg.dpb_frames;
+
+					/* Cache hits fetch nothing.  */
+					ref_miss += 1.0 - cfg.ref_hit_rate;
+					if (ref_miss < 1.0)
+						continue;
+					ref_miss -= 1.0;
+					transfer_block(qk, m,
+						       tlm::TLM_READ_COMMAND,
+						       cfg.base + fb * ref,
+						       wx0, wy0, wx1, wy1);
+				}
+				transfer_block(qk, m, tlm::TLM_WRITE_COMMAND,
+					       cfg.base + fb * out,
+					       x0, y0, x1, y1);
+
+				qk.inc(ctb_compute);
+				if (qk.need_sync())
+					qk.sync();
+			}
+		}
+		if (is_i || is_p)
+			last_ref = out;
+
+		/* Wait for the other core to finish the picture.  */
+		qk.sync();
+		core_finish[core] = sc_time_stamp();
+		if (++cores_done < 2) {
+			wait(frame_done);
+		} else {
+			frame_record rec;
+
+			cores_done = 0;
+			rec.start = start;
+			rec.took = max(core_finish[0], core_finish[1]) - start;
+			frames.push_back(rec);
+			frame_done.notify(SC_ZERO_TIME);
+			wait(frame_done);
+		}
+	}
+}
+
+void vcu_dec_traffic::end_of_simulation(void)
+{
+	sc_time budget(1.0 / cfg.fps, SC_SEC);
+	sc_time worst = SC_ZERO_TIME;
+	unsigned int late = 0;
+	size_t i;
+
+	cout << name() << ": " << cfg.width << "x" << cfg.height << "@"
+	     << cfg.fps << " decode, reference margin " << cfg.ref_margin
+	     << ", hit rate " << cfg.ref_hit_rate << ", budget " << budget
+	     << "\n";
+	port[0]->report(cout, sc_time_stamp());
+	port[1]->report(cout, sc_time_stamp());
+
+	for (i = 0; i < frames.size(); i++) {
+		bool ok = frames[i].took <= budget;
+
+		cout << "  frame " << i << " @ " << frames[i].start << ": "
+		     << frames[i].took << (ok ? " ok" : " OVER BUDGET")
+		     << "\n";
+		if (!ok)
+			late++;
+		if (frames[i].took > worst)
+			worst = frames[i].took;
+	}
+	cout << "  " << frames.size() << " frames, " << late
+	     << " over budget, worst " << worst << "\n";
+}
@@ -0,0 +1,97 @@
+/*
+ * TLM traffic model of the VCU decoder AXI masters DecData0/DecData1.
+ *
+ * Stands in for the VCU decoder on S_AXI_HP2_FPD/S_AXI_HP3_FPD (see
+ * vcu_trd_bd.tcl).  The two decoder cores take alternate CTB rows of each
+ * picture, one core per port.  Per CTB a core spends its share of the
+ * compute budget and issues:
+ *
+ *   - bitstream reads at the configured bit rate,
+ *   - reference fetches, reduced by the configured cache hit rate,
+ *   - output (and reference) frame writes.
+ *
+ * Pictures use the same layout as vcu_enc_traffic.h, and pixel data is
+ * moved as the same 2-D blocks, so figures from the two models compare
+ * directly.  The reference block of a CTB is the CTB grown by ref_margin
+ * pixels on each side for the interpolation taps and the motion vector
+ * spread, clamped to the picture.  There is no search window to slide:
+ * the cache hit rate skips that share of the blocks, spread evenly over
+ * the picture.
+ *
+ * Memory latency stalls the core, so a frame finishes late when the
+ * simulated memory system cannot keep up.  Frames are released at the
+ * configured frame rate and each one is checked against its 1/fps budget.
+ */
+
+#ifndef VCU_DEC_TRAFFIC_H__
+#define VCU_DEC_TRAFFIC_H__
+
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+
+#include "vcu_traffic.h"
+
+/* Defaults follow the vcu_trd_vcu_0_1 configuration.  */
+struct vcu_dec_config {
+	unsigned int width;		/* HDL_DEC_FRAME_SIZE_X 4096 */
+	unsigned int height;		/* HDL_DEC_FRAME_SIZE_Y 2160 */
+	unsigned int fps;		/* HDL_DEC_FPS 60 */
+	unsigned int bit_depth;		/* HDL_DEC_COLOR_DEPTH 1: 10 bit */
+	unsigned int ctb_size;
+	unsigned int bframes;		/* 0: IPPP.. */
+	unsigned int dpb_frames;
+	unsigned int ref_margin;	/* interpolation taps, MV spread */
+	double ref_hit_rate;		/* reference cache hit rate */
+	double compute_load;		/* share of the budget spent computing */
+	unsigned int bitrate_kbps;
+	unsigned int burst_bytes;	/* 16 beats of 128 bits */
+	uint64_t base;			/* frame buffers in DDR_LOW */
+
+	vcu_dec_config(void)
+		: width(4096), height(2160), fps(60), bit_depth(10),
+		  ctb_size(64), bframes(0), dpb_frames(5),
+		  ref_margin(8), ref_hit_rate(0.5), compute_load(0.75),
+		  bitrate_kbps(60000), burst_bytes(256),
+		  base(0x50000000)
+	{}
+};
+
+class vcu_dec_traffic
+: public sc_core::sc_module
+{
+private:
+	struct frame_record {
+		sc_core::sc_time start;
+		sc_core::sc_time took;
+	};
+
+	vcu_dec_config cfg;
+	vcu_axi_master *port[2];
+	sc_core::sc_event frame_done;
+	sc_core::sc_time core_finish[2];
+	unsigned int cores_done;
+	std::vector<frame_record> frames;
+
+	void core_thread(unsigned int core);
+	uint64_t line_offset(unsigned int x) const;
+	uint64_t line_bytes(unsigned int x0, unsigned int x1) const;
+	uint64_t frame_bytes(void) const;
+	void transfer_block(tlm_utils::tlm_quantumkeeper &qk,
+			    vcu_axi_master *m, tlm::tlm_command cmd,
+			    uint64_t pic, unsigned int x0, unsigned int y0,
+			    unsigned int x1, unsigned int y1);
+public:
+	tlm_utils::simple_initiator_socket<vcu_dec_traffic> dec_data0;
+	tlm_utils::simple_initiator_socket<vcu_dec_traffic> dec_data1;
+
+	vcu_dec_traffic(sc_core::sc_module_name name,
+			const vcu_dec_config &cfg = vcu_dec_config());
+	~vcu_dec_traffic(void);
+
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,213 @@
+/*
+ * TLM traffic model of the VCU encoder AXI masters EncData0/EncData1.
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include <algorithm>
+#include <iostream>
+
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include "vcu_enc_traffic.h"
+
+using namespace sc_core;
+using namespace std;
+
+/* Per stream: 3 source frames, bframes + 2 reference/recon frames.  */
+#define ENC_SRC_FRAMES 3
+#define ENC_BITSTREAM_SIZE (8 << 20)
+
+vcu_enc_traffic::vcu_enc_traffic(sc_module_name name,
+				 const vcu_enc_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  stats(cfg.streams),
+	  enc_data0("enc_data0"),
+	  enc_data1("enc_data1")
+{
+	unsigned int s;
+
+	port[0] = new vcu_axi_master("EncData0", enc_data0, cfg.burst_bytes);
+	port[1] = new vcu_axi_master("EncData1", enc_data1, cfg.burst_bytes);
+
+	for (s = 0; s < cfg.streams; s++) {
+		stats[s].frames = 0;
+		stats[s].late = 0;
+		sc_spawn(sc_bind(&vcu_enc_traffic::stream_thread, this, s),
+			 sc_gen_unique_name("stream"));
+	}
+}
+
+vcu_enc_traffic::~vcu_enc_traffic(void)
+{
+	delete port[0];
+	delete port[1];
+}
+
+/*
+ * Byte offset of pixel x in a line, 10 bit samples pack three to a word
+ * (linear XV15; the 64x4 tiled layout of tools/vcu_tile packs four to
+ * five bytes instead, so this is the larger of the two).
+ */
+uint64_t vcu_enc_traffic::line_offset(unsigned int x) const
+{
+	if (cfg.bit_depth > 8)
+		return (uint64_t) (x / 3) * 4;
+	return x;
+}
+
+/* Bytes holding pixels [x0, x1) of a line.  */
+uint64_t vcu_enc_traffic::line_bytes(unsigned int x0, unsigned int x1) const
+{
+	if (cfg.bit_depth > 8)
+		x1 += 2;
+	return line_offset(x1) - line_offset(x0);
+}
+
+/* 4:2:0, luma lines then half as many chroma lines.  */
+uint64_t vcu_enc_traffic::frame_bytes(void) const
+{
+	return line_bytes(0, cfg.width) * (cfg.height + (cfg.height + 1) / 2);
+}
+
+/* Moves pixels [x0, x1) x [y0, y1) of the picture at pic, both planes.  */
+void vcu_enc_traffic::transfer_block(tlm_utils::tlm_quantumkeeper &qk,
+				     vcu_axi_master *m, tlm::tlm_command cmd,
+				     uint64_t pic,
+				     unsigned int x0, unsigned int y0,
+				     unsigned int x1, unsigned int y1)
+{
+	uint64_t stride = line_bytes(0, cfg.width);
+	uint64_t chroma = pic + stride * cfg.height;
+	uint64_t off = line_offset(x0);
+	uint64_t len = line_bytes(x0, x1);
+
+	if (x0 >= x1 || y0 >= y1)
+		return;
+	m->transfer_2d(qk, cmd, pic + stride * y0 + off, len, y1 - y0,
+		       stride);
+	m->transfer_2d(qk, cmd, chroma + stride * (y0 / 2) + off, len,
+		       (y1 + 1) / 2 - y0 / 2, stride);
+}
+
+void vcu_enc_traffic::stream_thread(unsigned int s)
+{
+	tlm_utils::tlm_quantumkeeper qk;
+	vcu_axi_master *m = port[s % 2];
+	uint64_t fb = frame_bytes();
+	unsigned int nr_refs = cfg.bframes + 2;
+	uint64_t region = fb * (ENC_SRC_FRAMES + nr_refs) + ENC_BITSTREAM_SIZE;
+	uint64_t src_base = cfg.base + region * s;
+	uint64_t ref_base = src_base + fb * ENC_SRC_FRAMES;
+	uint64_t bs_base = ref_base + fb * nr_refs;
+	unsigned int ctbs_x = (cfg.width + cfg.ctb_size - 1) / cfg.ctb_size;
+	unsigned int ctbs_y = (cfg.height + cfg.ctb_size - 1) / cfg.ctb_size;
+	unsigned int nr_ctbs = ctbs_x * ctbs_y;
+	sc_time period(1.0 / cfg.fps, SC_SEC);
+	sc_time ctb_period = period / nr_ctbs;
+	uint64_t bs_per_frame = (uint64_t) cfg.bitrate_kbps * 1000 / 8
+				/ cfg.fps;
+	uint64_t bs_off = 0;
+	uint64_t frame;
+	unsigned int last_ref = 0;
+
+	qk.reset();
+	for (frame = 0; ; frame++) {
+		sc_time start = qk.get_current_time();
+		unsigned int pos = frame ? (frame - 1) % (cfg.bframes + 1) : 0;
+		bool is_i = frame == 0;
+		bool is_p = !is_i && pos == 0;
+		unsigned int refs = is_i ? 0 : (is_p ? 1 : 2);
+		unsigned int recon = (last_ref + 1) % nr_refs;
+		uint64_t src = src_base + fb * (frame % ENC_SRC_FRAMES);
+		uint64_t bs_left = bs_per_frame;
+		uint64_t bs_pending = 0;
+		unsigned int c, r;
+
+		for (c = 0; c < nr_ctbs; c++) {
+			unsigned int cx = c % ctbs_x;
+			unsigned int x0 = cx * cfg.ctb_size;
+			unsigned int y0 = c / ctbs_x * cfg.ctb_size;
+			unsigned int x1 = min(x0 + cfg.ctb_size, cfg.width);
+			unsigned int y1 = min(y0 + cfg.ctb_size, cfg.height);
+			unsigned int wx0, wx1, wy0, wy1;
+			uint64_t bs = bs_left / (nr_ctbs - c);
+
+			transfer_block(qk, m, tlm::TLM_READ_COMMAND, src,
+				       x0, y0, x1, y1);
+
+			/* The search window, or the column entering it.  */
+			wx0 = x0 > cfg.search_h ? x0 - cfg.search_h : 0;
+			wx1 = min(x1 + cfg.search_h, cfg.width);
+			wy0 = y0 > cfg.search_v ? y0 - cfg.search_v : 0;
+			wy1 = min(y1 + cfg.search_v, cfg.height);
+			if (cfg.enc_buffer && cx > 0)
+				wx0 = min(x0 + cfg.search_h, cfg.width);
+			for (r = 0; r < refs; r++) {
+				unsigned int ref = (last_ref + nr_refs - r)
+						   % nr_refs;
+
+				transfer_block(qk, m, tlm::TLM_READ_COMMAND,
+					       ref_base + fb * ref,
+					       wx0, wy0, wx1, wy1);
+			}
+			/* B frames are not used as references.  */
+			if (is_i || is_p) {
+				transfer_block(qk, m, tlm::TLM_WRITE_COMMAND,
+					       ref_base + fb * recon,
+					       x0, y0, x1, y1);
+			}
+			/* The bitstream goes out in full bursts.  */
+			bs_left -= bs;
+			bs_pending += bs;
+			if (bs_pending >= cfg.burst_bytes
+			    || c == nr_ctbs - 1) {
+				if (bs_off + bs_pending > ENC_BITSTREAM_SIZE)
+					bs_off = 0;
+				m->transfer(qk, tlm::TLM_WRITE_COMMAND,
+					    bs_base + bs_off, bs_pending);
+				bs_off += bs_pending;
+				bs_pending = 0;
+			}
+
+			/* Pace the CTBs evenly over the frame period.  */
+			sc_time due = start + ctb_period * (c + 1);
+			if (qk.get_current_time() < due)
+				qk.set(due - sc_time_stamp());
+			if (qk.need_sync())
+				qk.sync();
+		}
+		if (is_i || is_p)
+			last_ref = recon;
+
+		sc_time took = qk.get_current_time() - start;
+		stats[s].frames++;
+		if (took > period)
+			stats[s].late++;
+		if (took > stats[s].worst)
+			stats[s].worst = took;
+
+		/* Wait for the next source frame.  */
+		if (qk.get_current_time() < start + period)
+			qk.set(start + period - sc_time_stamp());
+		qk.sync();
+	}
+}
+
+void vcu_enc_traffic::end_of_simulation(void)
+{
+	sc_time elapsed = sc_time_stamp();
+	unsigned int s;
+
+	cout << name() << ": " << cfg.streams << " x " << cfg.width << "x"
+	     << cfg.height << "@" << cfg.fps << " encode, encoder buffer "
+	     << (cfg.enc_buffer ? "on" : "off") << "\n";
+	port[0]->report(cout, elapsed);
+	port[1]->report(cout, elapsed);
+	for (s = 0; s < cfg.streams; s++) {
+		cout << "  stream " << s << ": " << stats[s].frames
+		     << " frames, " << stats[s].late << " over budget, worst "
+		     << stats[s].worst << "\n";
+	}
+}
@@ -0,0 +1,95 @@
+/*
+ * TLM traffic model of the VCU encoder AXI masters EncData0/EncData1.
+ *
+ * Stands in for the VCU hard block on S_AXI_HP0_FPD/S_AXI_HP1_FPD (see
+ * vcu_trd_bd.tcl) so HP port sizing and DDR headroom can be evaluated
+ * without simulating the VCU RTL.  Each stream runs on its own thread and
+ * issues, per CTB and paced over the frame period:
+ *
+ *   - source frame reads,
+ *   - reference frame reads over the motion search window,
+ *   - reconstructed frame writes (reference frames only),
+ *   - bitstream writes at the configured bit rate.
+ *
+ * Pictures are 4:2:0 with a luma plane followed by an interleaved chroma
+ * plane of half the lines, both with the same line stride.  Pixel data
+ * is fetched as 2-D blocks, one burst sequence per line.
+ *
+ * The motion search window of a CTB extends search_h pixels left and
+ * right and search_v lines up and down, clamped to the picture.  Frames
+ * are coded I P B.. P B.. in encode order.  With the encoder buffer the
+ * window slides along the CTB row on chip and each CTB only fetches the
+ * CTB wide column entering it; without it every CTB refetches its whole
+ * window.
+ */
+
+#ifndef VCU_ENC_TRAFFIC_H__
+#define VCU_ENC_TRAFFIC_H__
+
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+
+#include "vcu_traffic.h"
+
+/* Defaults follow the vcu_trd_vcu_0_1 configuration.  */
+struct vcu_enc_config {
+	unsigned int width;		/* HDL_FRAME_SIZE_X 1920 */
+	unsigned int height;		/* HDL_FRAME_SIZE_Y 1080 */
+	unsigned int fps;		/* HDL_FPS 60 */
+	unsigned int streams;		/* HDL_NUM_CONCURRENT_STREAMS 4 */
+	unsigned int bframes;		/* HDL_ENC_BUFFER_B_FRAME 2 */
+	unsigned int bit_depth;		/* HDL_COLOR_DEPTH 1: 10 bit */
+	unsigned int ctb_size;		/* HEVC, 32x32 CTBs */
+	unsigned int search_h;		/* +/- horizontal search range */
+	unsigned int search_v;		/* +/- vertical search range */
+	bool enc_buffer;		/* HDL_ENC_BUFFER_EN 1 */
+	unsigned int bitrate_kbps;	/* per stream */
+	unsigned int burst_bytes;	/* 16 beats of 128 bits */
+	uint64_t base;			/* frame buffers in DDR_LOW */
+
+	vcu_enc_config(void)
+		: width(1920), height(1080), fps(60), streams(4), bframes(2),
+		  bit_depth(10), ctb_size(32),
+		  search_h(128), search_v(32),	/* MOTION_VEC_RANGE 1 */
+		  enc_buffer(true), bitrate_kbps(20000), burst_bytes(256),
+		  base(0x40000000)
+	{}
+};
+
+class vcu_enc_traffic
+: public sc_core::sc_module
+{
+private:
+	struct stream_stats {
+		uint64_t frames;
+		uint64_t late;
+		sc_core::sc_time worst;
+	};
+
+	vcu_enc_config cfg;
+	vcu_axi_master *port[2];
+	std::vector<stream_stats> stats;
+
+	void stream_thread(unsigned int s);
+	uint64_t line_offset(unsigned int x) const;
+	uint64_t line_bytes(unsigned int x0, unsigned int x1) const;
+	uint64_t frame_bytes(void) const;
+	void transfer_block(tlm_utils::tlm_quantumkeeper &qk,
+			    vcu_axi_master *m, tlm::tlm_command cmd,
+			    uint64_t pic, unsigned int x0, unsigned int y0,
+			    unsigned int x1, unsigned int y1);
+public:
+	tlm_utils::simple_initiator_socket<vcu_enc_traffic> enc_data0;
+	tlm_utils::simple_initiator_socket<vcu_enc_traffic> enc_data1;
+
+	vcu_enc_traffic(sc_core::sc_module_name name,
+			const vcu_enc_config &cfg = vcu_enc_config());
+	~vcu_enc_traffic(void);
+
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,207 @@
+/*
+ * VCU MCU firmware fetch model.
+ */
+
+#include <iostream>
+
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include "vcu_mcu_fetch.h"
+
+using namespace sc_core;
+using namespace std;
+
+/* Length of one busy/idle cycle.  */
+#define MCU_SLICE sc_time(100, SC_US)
+
+vcu_mcu_cache::vcu_mcu_cache(unsigned int size, unsigned int line_size,
+			     unsigned int ways)
+	: line_shift(0),
+	  sets(0),
+	  ways(ways ? ways : 1),
+	  accesses(0),
+	  misses(0)
+{
+	while ((1U << line_shift) < line_size)
+		line_shift++;
+	if (size)
+		sets = size / line_size / this->ways;
+	tags.assign((size_t) sets * this->ways, ~0ULL);
+}
+
+bool vcu_mcu_cache::access(uint64_t addr)
+{
+	uint64_t line = addr >> line_shift;
+	uint64_t *set;
+	unsigned int w;
+	bool hit = true;
+
+	accesses++;
+	if (!sets) {
+		misses++;
+		return false;
+	}
+
+	set = &tags[(line % sets) * ways];
+	for (w = 0; w < ways; w++) {
+		if (set[w] == line)
+			break;
+	}
+	if (w == ways) {
+		misses++;
+		hit = false;
+		w = ways - 1;	/* evict the LRU way */
+	}
+	/* Move to MRU.  */
+	for (; w > 0; w--)
+		set[w] = set[w - 1];
+	set[0] = line;
+	return hit;
+}
+
+vcu_mcu_fetch::vcu_mcu_fetch(sc_module_name name,
+			     const vcu_mcu_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  icache(cfg.icache_size, cfg.line_size, cfg.ways),
+	  dcache(cfg.dcache_size, cfg.line_size, cfg.ways),
+	  instructions(0),
+	  rng(cfg.seed),
+	  code_socket("code_socket")
+{
+	code = new vcu_axi_master("Code", code_socket, cfg.line_size);
+	SC_THREAD(run);
+}
+
+vcu_mcu_fetch::~vcu_mcu_fetch(void)
+{
+	delete code;
+}
+
+uint32_t vcu_mcu_fetch::rand32(void)
+{
+	/* xorshift32 */
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return rng;
+}
+
+/* One access through a cache, filling the line or going uncached.  */
+void vcu_mcu_fetch::fetch(tlm_utils::tlm_quantumkeeper &qk,
+			  vcu_mcu_cache &c, tlm::tlm_command cmd,
+			  uint64_t addr)
+{
+	sc_time lat;
+
+	if (cmd == tlm::TLM_WRITE_COMMAND) {
+		/* Write-through, no allocate.  */
+		lat = code->transfer(qk, cmd, addr & ~3ULL, 4);
+	} else if (c.access(addr)) {
+		return;
+	} else if (c.enabled()) {
+		lat = code->transfer(qk, cmd, addr & ~(uint64_t)
+				     (cfg.line_size - 1), cfg.line_size);
+	} else {
+		lat = code->transfer(qk, cmd, addr & ~3ULL, 4);
+	}
+	stall_time += lat;
+}
+
+void vcu_mcu_fetch::run(void)
+{
+	tlm_utils::tlm_quantumkeeper qk;
+	sc_time cycle(1.0 / cfg.clk_hz, SC_SEC);
+	uint64_t hot_base = cfg.fw_base;
+	uint64_t pc = hot_base;
+
+	qk.reset();
+	while (true) {
+		sc_time slice_start = qk.get_current_time();
+		sc_time busy_until = slice_start + MCU_SLICE * cfg.duty;
+
+		while (qk.get_current_time() < busy_until) {
+			/* A basic block of 4..16 instructions.  */
+			unsigned int len = 4 + rand32() % 13;
+			uint64_t end = pc + len * 4;
+			uint64_t a;
+			unsigned int i;
+
+			for (a = pc & ~(uint64_t) (cfg.line_size - 1);
+			     a < end; a += cfg.line_size) {
+				if (icache.enabled()) {
+					fetch(qk, icache,
+					      tlm::TLM_READ_COMMAND, a);
+				}
+			}
+			/* Uncached: every instruction is a bus read.  */
+			if (!icache.enabled()) {
+				for (a = pc; a < end; a += 4)
+					fetch(qk, icache,
+					      tlm::TLM_READ_COMMAND, a);
+			}
+
+			for (i = 0; i < len; i++) {
+				uint64_t da;
+
+				if (randf() >= cfg.mem_rate)
+					continue;
+				da = cfg.data_base
+				     + (rand32() % cfg.data_size & ~3U);
+				fetch(qk, dcache, randf() < cfg.store_rate ?
+				      tlm::TLM_WRITE_COMMAND :
+				      tlm::TLM_READ_COMMAND, da);
+			}
+
+			instructions += len;
+			qk.inc(cycle * (double) len);
+
+			/* Loop in the hot set, sometimes call far away.  */
+			if (randf() < cfg.call_rate) {
+				pc = cfg.fw_base
+				     + (rand32() % cfg.fw_size & ~3U);
+			} else if (end >= hot_base + cfg.hot_size
+				   || randf() < 0.3) {
+				pc = hot_base + (rand32() % cfg.hot_size
+						 & ~3U);
+			} else {
+				pc = end;
+			}
+			if (qk.need_sync())
+				qk.sync();
+		}
+		busy_time += qk.get_current_time() - slice_start;
+
+		/* Idle until the next command.  */
+		if (qk.get_current_time() < slice_start + MCU_SLICE)
+			qk.set(slice_start + MCU_SLICE - sc_time_stamp());
+		qk.sync();
+	}
+}
+
+void vcu_mcu_fetch::end_of_simulation(void)
+{
+	const vcu_axi_stats &st = code->get_stats();
+	double secs = sc_time_stamp().to_seconds();
+	uint64_t stores = st.wr_bursts;
+
+	cout << name() << ": " << instructions << " instructions, "
+	     << "busy " << busy_time << ", stalled " << stall_time << "\n";
+	cout << "  icache " << cfg.icache_size / 1024 << " KiB: "
+	     << icache.misses << "/" << icache.accesses << " misses ("
+	     << (icache.accesses ? 100.0 * icache.misses / icache.accesses : 0)
+	     << "%)\n";
+	cout << "  dcache " << cfg.dcache_size / 1024 << " KiB: "
+	     << dcache.misses << "/" << dcache.accesses << " read misses ("
+	     << (dcache.accesses ? 100.0 * dcache.misses / dcache.accesses : 0)
+	     << "%), " << stores << " write-through stores\n";
+	if (busy_time > SC_ZERO_TIME) {
+		cout << "  effective CPI "
+		     << (busy_time.to_seconds() * cfg.clk_hz)
+			/ (instructions ? instructions : 1)
+		     << "\n";
+	}
+	cout << "  HPC0 load: " << (secs > 0 ? (st.rd_bytes + st.wr_bytes)
+				     / secs / 1e6 : 0) << " MB/s\n";
+	code->report(cout, sc_time_stamp());
+}
@@ -0,0 +1,105 @@
+/*
+ * VCU MCU firmware fetch model.
+ *
+ * The VCU MCU runs its firmware out of DDR through vcu_0/Code, which the
+ * design maps to HPC0_DDR_LOW over the 32 bit S_AXI_HPC0_FPD port.  This
+ * model replays a synthetic MCU instruction and data stream through
+ * configurable caches and turns the misses into line fills (and the
+ * write-through stores into single writes) on that port.
+ *
+ * The stream is made of basic blocks: mostly loops over a hot working
+ * set, with occasional calls anywhere in the firmware image.  The MCU is
+ * busy for a configurable share of the time (command processing) and
+ * idle otherwise.  Miss rates, stall time and the resulting HPC0 load
+ * are reported at the end of simulation.
+ */
+
+#ifndef VCU_MCU_FETCH_H__
+#define VCU_MCU_FETCH_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+
+#include "vcu_traffic.h"
+
+struct vcu_mcu_config {
+	double clk_hz;			/* HDL_MCU_CLK 444 MHz */
+	uint64_t fw_base;		/* firmware image in DDR_LOW */
+	unsigned int fw_size;
+	unsigned int hot_size;		/* instruction working set */
+	uint64_t data_base;
+	unsigned int data_size;		/* data working set */
+	unsigned int icache_size;	/* 0: uncached */
+	unsigned int dcache_size;	/* 0: uncached */
+	unsigned int line_size;
+	unsigned int ways;
+	double duty;			/* busy share of the time */
+	double call_rate;		/* blocks ending in a far call */
+	double mem_rate;		/* loads/stores per instruction */
+	double store_rate;		/* stores among them */
+	unsigned int seed;
+
+	vcu_mcu_config(void)
+		: clk_hz(444e6), fw_base(0x70000000), fw_size(256 << 10),
+		  hot_size(24 << 10), data_base(0x70040000),
+		  data_size(32 << 10), icache_size(16 << 10),
+		  dcache_size(8 << 10), line_size(32), ways(2), duty(0.3),
+		  call_rate(0.02), mem_rate(0.25), store_rate(0.3), seed(1)
+	{}
+};
+
+/* Set associative, LRU.  */
+class vcu_mcu_cache
+{
+private:
+	unsigned int line_shift;
+	unsigned int sets;
+	unsigned int ways;
+	std::vector<uint64_t> tags;	/* sets x ways, MRU first */
+public:
+	uint64_t accesses;
+	uint64_t misses;
+
+	vcu_mcu_cache(unsigned int size, unsigned int line_size,
+		      unsigned int ways);
+
+	/* Returns true on a hit; on a miss the line is allocated.  */
+	bool access(uint64_t addr);
+	bool enabled(void) const { return sets != 0; }
+};
+
+class vcu_mcu_fetch
+: public sc_core::sc_module
+{
+private:
+	vcu_mcu_config cfg;
+	vcu_axi_master *code;
+	vcu_mcu_cache icache;
+	vcu_mcu_cache dcache;
+	uint64_t instructions;
+	sc_core::sc_time busy_time;
+	sc_core::sc_time stall_time;
+	uint32_t rng;
+
+	void run(void);
+	uint32_t rand32(void);
+	double randf(void) { return rand32() / 4294967296.0; }
+	void fetch(tlm_utils::tlm_quantumkeeper &qk, vcu_mcu_cache &c,
+		   tlm::tlm_command cmd, uint64_t addr);
+public:
+	SC_HAS_PROCESS(vcu_mcu_fetch);
+
+	tlm_utils::simple_initiator_socket<vcu_mcu_fetch> code_socket;
+
+	vcu_mcu_fetch(sc_core::sc_module_name name,
+		      const vcu_mcu_config &cfg = vcu_mcu_config());
+	~vcu_mcu_fetch(void);
+
+	void end_of_simulation(void);
+};
+
+#endif
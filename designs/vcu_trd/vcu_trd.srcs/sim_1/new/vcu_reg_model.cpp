@@ -0,0 +1,417 @@
+/*
+ * Functional model of the VCU S_AXI_LITE register space.
+ */
+
+#include <string.h>
+#include <sstream>
+
+#include "vcu_reg_model.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define VCU_WINDOW_SIZE		0x100000
+#define VCU_MCU_BLOCK_SIZE	0x20000
+#define VCU_SLCR_BASE		0x40000
+#define VCU_SLCR_END		0x42000
+#define VCU_SLCR_PLL_STATUS	(VCU_SLCR_BASE + 0x60)
+#define VCU_PLL_LOCKED		1
+
+#define MCU_MBOX_CMD		0x7000
+#define MCU_MBOX_STATUS		0x7800
+#define MCU_MBOX_DATA_SIZE	0x7f8
+
+#define MCU_RESET		0x9000
+#define MCU_RESET_MODE		0x9004
+#define MCU_STA			0x9008
+#define MCU_WAKEUP		0x900c
+#define MCU_CACHE_OFF		0x9010
+#define MCU_INTERRUPT		0x9100
+#define MCU_IRQ_MSK		0x9104
+#define MCU_IRQ_CLR		0x9108
+#define MCU_IRQ_STA		0x910c
+
+#define MCU_STA_SLEEP		1
+#define MCU_STATUS_OK		0
+#define MCU_STATUS_UNKNOWN_MSG	1
+
+vcu_reg_model::vcu_reg_model(sc_module_name name, const vcu_reg_config &cfg)
+	: sc_module(name),
+	  cfg(cfg),
+	  irq_level(false),
+	  socket("socket"),
+	  irq("irq")
+{
+	unsigned int m;
+
+	socket.register_b_transport(this, &vcu_reg_model::b_transport);
+	socket.register_transport_dbg(this, &vcu_reg_model::transport_dbg);
+	socket.register_get_direct_mem_ptr(this,
+				&vcu_reg_model::get_direct_mem_ptr);
+
+	for (m = 0; m < 2; m++) {
+		memset(&mcu[m], 0, sizeof mcu[m]);
+		mcu_reset(m);
+	}
+
+	SC_THREAD(completion_thread);
+	SC_METHOD(irq_method);
+	sensitive << irq_ev;
+}
+
+static bool is_sram(uint32_t offset)
+{
+	return offset < VCU_SLCR_BASE
+	       && offset % VCU_MCU_BLOCK_SIZE < MCU_SRAM_SIZE;
+}
+
+uint32_t vcu_reg_model::sram_read32(unsigned int m, uint32_t offset)
+{
+	uint32_t v;
+
+	memcpy(&v, &mcu[m].sram[offset], 4);
+	return v;
+}
+
+void vcu_reg_model::sram_write32(unsigned int m, uint32_t offset,
+				 uint32_t val)
+{
+	memcpy(&mcu[m].sram[offset], &val, 4);
+}
+
+void vcu_reg_model::mcu_reset(unsigned int m)
+{
+	multimap<sc_time, reply>::iterator it, next;
+
+	mcu[m].sta = MCU_STA_SLEEP;
+	mcu[m].irq_sta = 0;
+	for (it = pending.begin(); it != pending.end(); it = next) {
+		next = it;
+		++next;
+		if (it->second.mcu == m)
+			pending.erase(it);
+	}
+}
+
+/* Ring indices the host hands us must be in range and word aligned.  */
+static bool mbox_index_ok(uint32_t idx)
+{
+	return idx < MCU_MBOX_DATA_SIZE && !(idx & 3);
+}
+
+/*
+ * Drain the command mailbox, scheduling a reply for every message.  The
+ * host produces at tail; we consume from head and hand it back.
+ */
+void vcu_reg_model::doorbell(unsigned int m, const sc_time &now)
+{
+	uint32_t head = sram_read32(m, MCU_MBOX_CMD);
+	uint32_t tail = sram_read32(m, MCU_MBOX_CMD + 4);
+	unsigned int n;
+
+	if (mcu[m].sta & MCU_STA_SLEEP)
+		return;
+	if (!mbox_index_ok(head) || !mbox_index_ok(tail)) {
+		ostringstream msg;
+
+		msg << "MCU " << m << " command mailbox head 0x" << hex
+		    << head << " tail 0x" << tail << " is corrupt, ignored";
+		SC_REPORT_WARNING(name(), msg.str().c_str());
+		return;
+	}
+
+	/* A ring holds at most one 4 byte header per word.  */
+	for (n = 0; head != tail && n < MCU_MBOX_DATA_SIZE / 4; n++) {
+		uint32_t words[2];
+		uint32_t size;
+		sc_time lat;
+		reply r;
+		unsigned int i;
+
+		for (i = 0; i < 2; i++) {
+			words[i] = sram_read32(m, MCU_MBOX_CMD + 8
+					       + (head + 4 * i)
+					       % MCU_MBOX_DATA_SIZE);
+		}
+		size = ((words[0] & 0xffff) + 3) & ~3U;
+		if (4 + size >= MCU_MBOX_DATA_SIZE) {
+			SC_REPORT_WARNING(name(), "command larger than the "
+					  "mailbox, dropping the rest");
+			head = tail;
+			break;
+		}
+
+		r.mcu = m;
+		r.uid = words[0] >> 16;
+		r.status = MCU_STATUS_OK;
+		r.arg = size >= 4 ? words[1] : 0;
+		switch (r.uid) {
+		case VCU_MCU_MSG_INIT:
+		case VCU_MCU_MSG_CREATE_CHANNEL:
+		case VCU_MCU_MSG_DESTROY_CHANNEL:
+			lat = cfg.cmd_latency;
+			break;
+		case VCU_MCU_MSG_ENCODE_FRAME:
+			lat = m ? cfg.dec_latency : cfg.enc_latency;
+			break;
+		case VCU_MCU_MSG_PUSH_BUFFER_INTERMEDIATE:
+		case VCU_MCU_MSG_PUSH_BUFFER_REFERENCE:
+		case VCU_MCU_MSG_PUT_STREAM_BUFFER:
+			lat = m ? cfg.dec_latency : cfg.cmd_latency;
+			break;
+		default:
+			/* Decoder message types are not public.  */
+			lat = m ? cfg.dec_latency : cfg.cmd_latency;
+			if (!m)
+				r.status = MCU_STATUS_UNKNOWN_MSG;
+			break;
+		}
+		pending.insert(make_pair(now + lat, r));
+
+		head = (head + 4 + size) % MCU_MBOX_DATA_SIZE;
+	}
+	sram_write32(m, MCU_MBOX_CMD, head);
+	pending_ev.notify(SC_ZERO_TIME);
+}
+
+/*
+ * We produce at the status mailbox's tail, the host consumes from head.
+ * Returns false if the mailbox is full.
+ */
+bool vcu_reg_model::post_status(const reply &r)
+{
+	unsigned int m = r.mcu;
+	uint32_t head = sram_read32(m, MCU_MBOX_STATUS);
+	uint32_t tail = sram_read32(m, MCU_MBOX_STATUS + 4);
+	uint32_t used;
+	uint32_t msg[3] = { r.uid << 16 | 8, r.arg, r.status };
+	unsigned int i;
+
+	if (!mbox_index_ok(head) || !mbox_index_ok(tail)) {
+		ostringstream err;
+
+		err << "MCU " << m << " status mailbox head 0x" << hex
+		    << head << " tail 0x" << tail
+		    << " is corrupt, reply dropped";
+		SC_REPORT_WARNING(name(), err.str().c_str());
+		return true;
+	}
+	used = (tail + MCU_MBOX_DATA_SIZE - head) % MCU_MBOX_DATA_SIZE;
+	if (used + sizeof msg >= MCU_MBOX_DATA_SIZE)
+		return false;
+
+	for (i = 0; i < 3; i++) {
+		sram_write32(m, MCU_MBOX_STATUS + 8 + tail, msg[i]);
+		tail = (tail + 4) % MCU_MBOX_DATA_SIZE;
+	}
+	sram_write32(m, MCU_MBOX_STATUS + 4, tail);
+
+	mcu[m].irq_sta |= 1;
+	update_irq();
+	return true;
+}
+
+/*
+ * Called from the completion thread and from the initiator's b_transport;
+ * irq_method is the only writer of the port.
+ */
+void vcu_reg_model::update_irq(void)
+{
+	irq_level = (mcu[0].irq_sta & mcu[0].irq_msk)
+		    || (mcu[1].irq_sta & mcu[1].irq_msk);
+	irq_ev.notify(SC_ZERO_TIME);
+}
+
+void vcu_reg_model::irq_method(void)
+{
+	irq.write(irq_level);
+}
+
+void vcu_reg_model::completion_thread(void)
+{
+	while (true) {
+		if (pending.empty()) {
+			wait(pending_ev);
+			continue;
+		}
+		if (pending.begin()->first > sc_time_stamp()) {
+			wait(pending.begin()->first - sc_time_stamp(),
+			     pending_ev);
+			continue;
+		}
+
+		reply r = pending.begin()->second;
+		pending.erase(pending.begin());
+		if (!post_status(r)) {
+			/* Host has not drained the status mailbox yet.  */
+			pending.insert(make_pair(sc_time_stamp()
+						 + cfg.cmd_latency, r));
+		}
+	}
+}
+
+uint32_t vcu_reg_model::reg_read(uint32_t offset)
+{
+	unsigned int m = offset / VCU_MCU_BLOCK_SIZE;
+	uint32_t r = offset % VCU_MCU_BLOCK_SIZE;
+
+	if (offset >= VCU_SLCR_BASE) {
+		uint32_t v = slcr[offset];
+
+		if (offset == VCU_SLCR_PLL_STATUS)
+			v |= VCU_PLL_LOCKED;
+		return v;
+	}
+
+	switch (r) {
+	case MCU_IRQ_MSK:
+		return mcu[m].irq_msk;
+	case MCU_IRQ_STA:
+		return mcu[m].irq_sta;
+	case MCU_RESET:
+		return mcu[m].reset;
+	case MCU_RESET_MODE:
+		return mcu[m].reset_mode;
+	case MCU_STA:
+		return mcu[m].sta;
+	case MCU_CACHE_OFF:
+	case MCU_CACHE_OFF + 4:
+	case MCU_CACHE_OFF + 8:
+	case MCU_CACHE_OFF + 12:
+		return mcu[m].cache_off[(r - MCU_CACHE_OFF) / 4];
+	default:
+		return 0;
+	}
+}
+
+void vcu_reg_model::reg_write(uint32_t offset, uint32_t val,
+			      const sc_time &now)
+{
+	unsigned int m = offset / VCU_MCU_BLOCK_SIZE;
+	uint32_t r = offset % VCU_MCU_BLOCK_SIZE;
+
+	if (offset >= VCU_SLCR_BASE) {
+		slcr[offset] = val;
+		return;
+	}
+
+	switch (r) {
+	case MCU_IRQ_MSK:
+		mcu[m].irq_msk = val;
+		update_irq();
+		break;
+	case MCU_IRQ_CLR:
+		mcu[m].irq_sta &= ~val;
+		update_irq();
+		break;
+	case MCU_RESET:
+		mcu[m].reset = val;
+		if (val & 1)
+			mcu_reset(m);
+		update_irq();
+		break;
+	case MCU_RESET_MODE:
+		mcu[m].reset_mode = val;
+		break;
+	case MCU_WAKEUP:
+		if (val & 1) {
+			mcu[m].sta &= ~MCU_STA_SLEEP;
+			doorbell(m, now);
+		}
+		break;
+	case MCU_CACHE_OFF:
+	case MCU_CACHE_OFF + 4:
+	case MCU_CACHE_OFF + 8:
+	case MCU_CACHE_OFF + 12:
+		mcu[m].cache_off[(r - MCU_CACHE_OFF) / 4] = val;
+		break;
+	case MCU_INTERRUPT:
+		if (val & 1)
+			doorbell(m, now);
+		break;
+	default:
+		break;
+	}
+}
+
+/* Side effects only happen for non-debug accesses.  */
+bool vcu_reg_model::access(tlm::tlm_generic_payload &trans, bool debug,
+			   const sc_time &now)
+{
+	uint32_t offset = trans.get_address() & (VCU_WINDOW_SIZE - 1);
+	unsigned char *data = trans.get_data_ptr();
+	unsigned int len = trans.get_data_length();
+	unsigned int m = offset / VCU_MCU_BLOCK_SIZE;
+	uint32_t r = offset % VCU_MCU_BLOCK_SIZE;
+	uint32_t v;
+
+	if (trans.get_byte_enable_ptr()) {
+		trans.set_response_status(tlm::TLM_BYTE_ENABLE_ERROR_RESPONSE);
+		return false;
+	}
+
+	if (is_sram(offset) && r + len <= MCU_SRAM_SIZE) {
+		if (trans.is_read())
+			memcpy(data, &mcu[m].sram[r], len);
+		else
+			memcpy(&mcu[m].sram[r], data, len);
+		trans.set_response_status(tlm::TLM_OK_RESPONSE);
+		return true;
+	}
+
+	if (len != 4 || (offset & 3)
+	    || (offset >= VCU_SLCR_END)
+	    || is_sram(offset)) {
+		trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+		return false;
+	}
+
+	if (trans.is_read()) {
+		v = reg_read(offset);
+		memcpy(data, &v, 4);
+	} else if (!debug) {
+		memcpy(&v, data, 4);
+		reg_write(offset, v, now);
+	}
+	trans.set_response_status(tlm::TLM_OK_RESPONSE);
+	return true;
+}
+
+void vcu_reg_model::b_transport(tlm::tlm_generic_payload &trans,
+				sc_time &delay)
+{
+	/* Jobs are timed from the initiator's local time.  */
+	access(trans, false, sc_time_stamp() + delay);
+	delay += cfg.access_latency;
+	trans.set_dmi_allowed(is_sram(trans.get_address()
+				      & (VCU_WINDOW_SIZE - 1)));
+}
+
+unsigned int vcu_reg_model::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return access(trans, true, sc_time_stamp()) ?
+	       trans.get_data_length() : 0;
+}
+
+/* The MCU SRAMs are plain memory; the mailboxes are polled on doorbell. */
+bool vcu_reg_model::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				       tlm::tlm_dmi &dmi)
+{
+	uint64_t addr = trans.get_address();
+	uint64_t window = addr & ~(uint64_t) (VCU_WINDOW_SIZE - 1);
+	uint32_t offset = addr & (VCU_WINDOW_SIZE - 1);
+	unsigned int m = offset / VCU_MCU_BLOCK_SIZE;
+	uint64_t start;
+
+	if (!is_sram(offset))
+		return false;
+
+	start = window + m * VCU_MCU_BLOCK_SIZE;
+	dmi.set_dmi_ptr(mcu[m].sram);
+	dmi.set_start_address(start);
+	dmi.set_end_address(start + MCU_SRAM_SIZE - 1);
+	dmi.set_granted_access(tlm::tlm_dmi::DMI_ACCESS_READ_WRITE);
+	dmi.set_read_latency(cfg.access_latency);
+	dmi.set_write_latency(cfg.access_latency);
+	return true;
+}
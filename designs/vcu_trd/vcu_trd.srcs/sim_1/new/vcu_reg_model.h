@@ -0,0 +1,135 @@
+/*
+ * Functional model of the VCU S_AXI_LITE register space.
+ *
+ * Stands in for the VCU control space at 0x80000000 (1 MiB, reached from
+ * M_AXI_HPM0_LPD through vcu_axi_lite_0) so the VCU drivers running in
+ * QEMU can bring up the codecs and push jobs without the RTL.  Offsets
+ * are relative to the window; absolute addresses are masked.
+ *
+ *   0x00000  encoder MCU     0x20000  decoder MCU
+ *   0x40000  VCU SLCR        0x41000  logicore
+ *
+ * Within an MCU block (offsets as used by the mainline allegro-dvt
+ * driver, firmware interface 2019.2):
+ *
+ *   0x0000-0x7fff  MCU SRAM (boot code, mailboxes), DMI capable
+ *   0x7000         command mailbox (host -> MCU)
+ *   0x7800         status mailbox (MCU -> host)
+ *   0x9000         MCU_RESET
+ *   0x9004         MCU_RESET_MODE
+ *   0x9008         MCU_STA   bit 0: MCU asleep
+ *   0x900c         MCU_WAKEUP
+ *   0x9010-0x901c  I/D cache address offsets (MSB, LSB)
+ *   0x9100         MCU_INTERRUPT  doorbell, processes the command mailbox
+ *   0x9104         IRQ_MSK   host interrupt enable
+ *   0x9108         IRQ_CLR   write 1 to clear
+ *   0x910c         IRQ_STA
+ *
+ * A mailbox is a ring as in the driver's allegro_mbox_*(): head
+ * (consumer) at +0, tail (producer) at +4 and 0x7f8 bytes of data at +8.
+ * A message is a 32 bit header (type in bits 31:16, body size in bytes
+ * in bits 15:0) followed by the body, padded to 32 bits.  A mailbox
+ * whose indices are out of range or unaligned is ignored.  Every command
+ * gets a reply of the same type after the configured latency and the
+ * host interrupt (vcu_host_interrupt, pl_ps_irq0[0]) is raised.  The
+ * reply body is only { first command word, status }, not the firmware's
+ * full reply, so drivers see the handshake and the timing but not real
+ * channel parameters.  The decoder firmware interface is not public; on
+ * the decoder MCU every message other than init and channel
+ * create/destroy is timed as a decoded frame.
+ */
+
+#ifndef VCU_REG_MODEL_H__
+#define VCU_REG_MODEL_H__
+
+#include <stdint.h>
+#include <map>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_target_socket.h"
+
+#define MCU_SRAM_SIZE		0x8000
+
+/* enum mcu_msg_type of the allegro-dvt driver.  */
+enum vcu_mcu_msg {
+	VCU_MCU_MSG_INIT = 0x0000,
+	VCU_MCU_MSG_CREATE_CHANNEL = 0x0005,
+	VCU_MCU_MSG_DESTROY_CHANNEL = 0x0006,
+	VCU_MCU_MSG_ENCODE_FRAME = 0x0007,
+	VCU_MCU_MSG_PUSH_BUFFER_INTERMEDIATE = 0x000e,
+	VCU_MCU_MSG_PUSH_BUFFER_REFERENCE = 0x000f,
+	VCU_MCU_MSG_PUT_STREAM_BUFFER = 0x0012,
+};
+
+struct vcu_reg_config {
+	sc_core::sc_time cmd_latency;	/* init, channel create/destroy */
+	sc_core::sc_time enc_latency;	/* one encoded frame */
+	sc_core::sc_time dec_latency;	/* one decoded frame */
+	sc_core::sc_time access_latency;
+
+	vcu_reg_config(void)
+		: cmd_latency(50, sc_core::SC_US),
+		  enc_latency(16, sc_core::SC_MS),
+		  dec_latency(8, sc_core::SC_MS),
+		  access_latency(20, sc_core::SC_NS)
+	{}
+};
+
+class vcu_reg_model
+: public sc_core::sc_module
+{
+private:
+	struct mcu_block {
+		uint8_t sram[MCU_SRAM_SIZE];
+		uint32_t irq_msk;
+		uint32_t irq_sta;
+		uint32_t reset;
+		uint32_t reset_mode;
+		uint32_t sta;
+		uint32_t cache_off[4];
+	};
+	struct reply {
+		unsigned int mcu;
+		uint32_t uid;
+		uint32_t status;
+		uint32_t arg;
+	};
+
+	vcu_reg_config cfg;
+	mcu_block mcu[2];
+	std::map<uint32_t, uint32_t> slcr;
+	std::multimap<sc_core::sc_time, reply> pending;
+	sc_core::sc_event pending_ev;
+	bool irq_level;
+	sc_core::sc_event irq_ev;
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	bool access(tlm::tlm_generic_payload &trans, bool debug,
+		    const sc_core::sc_time &now);
+
+	uint32_t reg_read(uint32_t offset);
+	void reg_write(uint32_t offset, uint32_t val,
+		       const sc_core::sc_time &now);
+	uint32_t sram_read32(unsigned int m, uint32_t offset);
+	void sram_write32(unsigned int m, uint32_t offset, uint32_t val);
+	void mcu_reset(unsigned int m);
+	void doorbell(unsigned int m, const sc_core::sc_time &now);
+	bool post_status(const reply &r);
+	void update_irq(void);
+	void irq_method(void);
+	void completion_thread(void);
+public:
+	SC_HAS_PROCESS(vcu_reg_model);
+
+	tlm_utils::simple_target_socket<vcu_reg_model> socket;
+	sc_core::sc_out<bool> irq;
+
+	vcu_reg_model(sc_core::sc_module_name name,
+		      const vcu_reg_config &cfg = vcu_reg_config());
+};
+
+#endif
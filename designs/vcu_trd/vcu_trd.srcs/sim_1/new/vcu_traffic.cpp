@@ -0,0 +1,124 @@
+/*
+ * Common plumbing for the VCU AXI master traffic models.
+ */
+
+#include <iomanip>
+
+#include "vcu_traffic.h"
+
+using namespace sc_core;
+using namespace std;
+
+/* Whole beats in a burst of burst_bytes, at least one.  */
+static unsigned int burst_beats(unsigned int burst_bytes)
+{
+	unsigned int beats;
+
+	beats = (burst_bytes + VCU_AXI_DATA_BYTES - 1) / VCU_AXI_DATA_BYTES;
+	return beats ? beats : 1;
+}
+
+vcu_axi_master::vcu_axi_master(const char *name,
+			       tlm::tlm_initiator_socket<> &sk,
+			       unsigned int burst_bytes)
+	: name(name),
+	  sk(sk),
+	  burst_bytes(burst_beats(burst_bytes) * VCU_AXI_DATA_BYTES),
+	  pool(burst_beats(burst_bytes), VCU_AXI_DATA_BYTES),
+	  mm(pool)
+{
+	stats.rd_bytes = 0;
+	stats.wr_bytes = 0;
+	stats.rd_bursts = 0;
+	stats.wr_bursts = 0;
+	stats.errors = 0;
+}
+
+sc_time vcu_axi_master::transfer(tlm_utils::tlm_quantumkeeper &qk,
+				 tlm::tlm_command cmd,
+				 uint64_t addr, uint64_t len)
+{
+	sc_time total = SC_ZERO_TIME;
+
+	while (len) {
+		tlm::tlm_generic_payload *gp;
+		unsigned int chunk = burst_bytes;
+		sc_time delay, start, lat;
+
+		/* AXI bursts must not cross a 4 KiB boundary.  */
+		if (chunk > 4096 - (addr & 4095))
+			chunk = 4096 - (addr & 4095);
+		if (chunk > len)
+			chunk = len;
+
+		gp = mm.allocate();
+		gp->set_command(cmd);
+		gp->set_address(addr);
+		gp->set_data_length(chunk);
+		gp->set_streaming_width(chunk);
+
+		delay = qk.get_local_time();
+		start = sc_time_stamp() + delay;
+		sk->b_transport(*gp, delay);
+		lat = sc_time_stamp() + delay - start;
+		qk.set(delay);
+		if (qk.need_sync())
+			qk.sync();
+
+		if (gp->is_response_error()) {
+			if (!stats.errors) {
+				SC_REPORT_WARNING(name.c_str(),
+					gp->get_response_string().c_str());
+			}
+			stats.errors++;
+		}
+		if (cmd == tlm::TLM_READ_COMMAND) {
+			stats.rd_bytes += chunk;
+			stats.rd_bursts++;
+		} else {
+			stats.wr_bytes += chunk;
+			stats.wr_bursts++;
+		}
+		stats.lat_total += lat;
+		if (lat > stats.lat_max)
+			stats.lat_max = lat;
+		total += lat;
+
+		gp->release();
+		addr += chunk;
+		len -= chunk;
+	}
+	return total;
+}
+
+sc_time vcu_axi_master::transfer_2d(tlm_utils::tlm_quantumkeeper &qk,
+				    tlm::tlm_command cmd, uint64_t addr,
+				    uint64_t row_bytes, unsigned int rows,
+				    uint64_t stride)
+{
+	sc_time total = SC_ZERO_TIME;
+	unsigned int r;
+
+	for (r = 0; r < rows; r++)
+		total += transfer(qk, cmd, addr + stride * r, row_bytes);
+	return total;
+}
+
+void vcu_axi_master::report(ostream &os, const sc_time &elapsed) const
+{
+	double secs = elapsed.to_seconds();
+	uint64_t bursts = stats.rd_bursts + stats.wr_bursts;
+
+	os << name << ": "
+	   << fixed << setprecision(1)
+	   << "rd " << (secs > 0 ? stats.rd_bytes / secs / 1e6 : 0) << " MB/s, "
+	   << "wr " << (secs > 0 ? stats.wr_bytes / secs / 1e6 : 0) << " MB/s, "
+	   << bursts << " bursts";
+	if (bursts) {
+		os << ", latency avg " << stats.lat_total / (double) bursts
+		   << " max " << stats.lat_max;
+	}
+	if (stats.errors)
+		os << ", " << stats.errors << " errors";
+	os << "\n";
+}
@@ -0,0 +1,72 @@
+/*
+ * Common plumbing for the VCU AXI master traffic models.
+ *
+ * vcu_axi_master issues a linear transfer on one VCU AXI port (EncData0/1,
+ * DecData0/1, Code) as a sequence of bursts the way the VCU does: at most
+ * burst_bytes per burst and never across a 4 KiB boundary.  burst_bytes
+ * is rounded up to whole 128 bit beats, at least one.  Payloads come
+ * from a payload_mm pool, time is annotated through the caller's quantum
+ * keeper, and bytes, bursts and latencies are accounted per port.
+ */
+
+#ifndef VCU_TRAFFIC_H__
+#define VCU_TRAFFIC_H__
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+#include "payload_pool.h"
+
+/* The VCU AXI masters are 128 bits wide.  */
+#define VCU_AXI_DATA_BYTES 16
+
+struct vcu_axi_stats {
+	uint64_t rd_bytes;
+	uint64_t wr_bytes;
+	uint64_t rd_bursts;
+	uint64_t wr_bursts;
+	uint64_t errors;
+	sc_core::sc_time lat_total;
+	sc_core::sc_time lat_max;
+};
+
+class vcu_axi_master
+{
+private:
+	std::string name;
+	tlm::tlm_initiator_socket<> &sk;
+	unsigned int burst_bytes;
+	payload_buffer_pool pool;
+	payload_mm mm;
+	vcu_axi_stats stats;
+public:
+	vcu_axi_master(const char *name, tlm::tlm_initiator_socket<> &sk,
+		       unsigned int burst_bytes);
+
+	/*
+	 * Move len bytes at addr, split into bursts.  Returns the
+	 * accumulated latency of the bursts.
+	 */
+	sc_core::sc_time transfer(tlm_utils::tlm_quantumkeeper &qk,
+				  tlm::tlm_command cmd,
+				  uint64_t addr, uint64_t len);
+
+	/*
+	 * Move a block of rows lines of row_bytes each, stride bytes
+	 * apart, starting at addr.  Each line is split into bursts.
+	 */
+	sc_core::sc_time transfer_2d(tlm_utils::tlm_quantumkeeper &qk,
+				     tlm::tlm_command cmd, uint64_t addr,
+				     uint64_t row_bytes, unsigned int rows,
+				     uint64_t stride);
+
+	const vcu_axi_stats &get_stats(void) const { return stats; }
+	void report(std::ostream &os, const sc_core::sc_time &elapsed) const;
+};
+
+#endif
@@ -19,15 +19,48 @@
 //--  Description   : Top level SYSTEMC description of constant block
 //--
 //------------------------------------------------------------------------
+#ifndef XLCONSTANT_V1_1_H
+#define XLCONSTANT_V1_1_H
+
 #include "systemc.h"
+
+//------------------------------------------------------------------------
+//--  The value is the port's initial value, set through
+//--  sc_out::initialize().  The bound signal starts out at CONST_VAL,
+//--  so no process is needed to write it in the first delta cycle.
+//------------------------------------------------------------------------
 template<int CONST_WIDTH,int CONST_VAL>
 SC_MODULE(xlconstant_v1_1) {
   public:
   sc_out< sc_bv<CONST_WIDTH> > dout;
-  void init() {
-    dout.write(CONST_VAL);
-  }
   SC_CTOR(xlconstant_v1_1) {
-    SC_METHOD(init);  
+    dout.initialize(sc_bv<CONST_WIDTH>(CONST_VAL));
   }
 };
+
+//------------------------------------------------------------------------
+//--  Elided constant, instantiated by the generated block design wrappers
+//--  as
+//--
+//--    xlconstant_v1_1_5<W,V> mod;    mod("mod")    mod.dout(dout);
+//--
+//--  It is not a module and has no port: binding dout to the wrapper's
+//--  port initializes that port to CONST_VAL instead.  The constant then
+//--  costs no module, process, port or signal of its own.
+//------------------------------------------------------------------------
+template<int CONST_WIDTH,int CONST_VAL>
+class xlconstant_v1_1_5 {
+  public:
+  struct const_out {
+    void operator()(sc_out< sc_bv<CONST_WIDTH> > &port) {
+      port.initialize(sc_bv<CONST_WIDTH>(CONST_VAL));
+    }
+    void bind(sc_out< sc_bv<CONST_WIDTH> > &port) {
+      (*this)(port);
+    }
+  };
+  const_out dout;
+  xlconstant_v1_1_5(const char *) {}
+};
+
+#endif
@@ -0,0 +1,569 @@
+/*
+ * Generated by psu_init_gen from psu_init.c, do not edit.
+ *
+ * Each init sequence is a table of records run in order until
+ * PSU_OP_END:
+ *
+ *   PSU_OP_WRITE       offset = value
+ *   PSU_OP_MASK_WRITE  offset = (offset & ~mask) | (value & mask)
+ *   PSU_OP_POLL        until (offset & mask) == value
+ *   PSU_OP_DELAY       wait value us
+ *   PSU_OP_CALL        run sequence number value of psu_calls
+ */
+
+#ifndef PSU_INIT_OPS_H__
+#define PSU_INIT_OPS_H__
+
+#include <stdint.h>
+
+#define PSU_OP_END              0
+#define PSU_OP_WRITE            1
+#define PSU_OP_MASK_WRITE       2
+#define PSU_OP_POLL             3
+#define PSU_OP_DELAY            4
+#define PSU_OP_CALL             5
+
+struct psu_op {
+	uint32_t offset;
+	uint32_t mask;
+	uint32_t value;
+	uint32_t opcode;
+};
+
+static const struct psu_op psu_pll_init_data_ops[] = {
+	{ 0xFF5E0034U, 0xFE7FEDEFU, 0x7E60EC6CU, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_CFG */
+	{ 0xFF5E0030U, 0x00717F00U, 0x00013000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_CTRL */
+	{ 0xFF5E0030U, 0x00000008U, 0x00000008U, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_CTRL */
+	{ 0xFF5E0030U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_CTRL */
+	{ 0xFF5E0030U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_CTRL */
+	{ 0xFF5E0040U, 0x00000002U, 0x00000002U, PSU_OP_POLL },	/* CRL_APB_PLL_STATUS */
+	{ 0xFF5E0030U, 0x00000008U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_CTRL */
+	{ 0xFF5E0048U, 0x00003F00U, 0x00000200U, PSU_OP_MASK_WRITE },	/* CRL_APB_RPLL_TO_FPD_CTRL */
+	{ 0xFF5E0108U, 0x013F3F07U, 0x01012300U, PSU_OP_MASK_WRITE },	/* CRL_APB_AMS_REF_CTRL */
+	{ 0xFF5E0024U, 0xFE7FEDEFU, 0x7E4E2C62U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_CFG */
+	{ 0xFF5E0020U, 0x00717F00U, 0x00013C00U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_CTRL */
+	{ 0xFF5E0020U, 0x00000008U, 0x00000008U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_CTRL */
+	{ 0xFF5E0020U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_CTRL */
+	{ 0xFF5E0020U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_CTRL */
+	{ 0xFF5E0040U, 0x00000001U, 0x00000001U, PSU_OP_POLL },	/* CRL_APB_PLL_STATUS */
+	{ 0xFF5E0020U, 0x00000008U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_CTRL */
+	{ 0xFF5E0044U, 0x00003F00U, 0x00000200U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOPLL_TO_FPD_CTRL */
+	{ 0xFD1A0024U, 0xFE7FEDEFU, 0x7E4B0C62U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_CFG */
+	{ 0xFD1A0020U, 0x00717F00U, 0x00014800U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_CTRL */
+	{ 0xFD1A0020U, 0x00000008U, 0x00000008U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_CTRL */
+	{ 0xFD1A0020U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_CTRL */
+	{ 0xFD1A0020U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_CTRL */
+	{ 0xFD1A0044U, 0x00000001U, 0x00000001U, PSU_OP_POLL },	/* CRF_APB_PLL_STATUS */
+	{ 0xFD1A0020U, 0x00000008U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_CTRL */
+	{ 0xFD1A0048U, 0x00003F00U, 0x00000300U, PSU_OP_MASK_WRITE },	/* CRF_APB_APLL_TO_LPD_CTRL */
+	{ 0xFD1A0030U, 0xFE7FEDEFU, 0x7E4B0C62U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_CFG */
+	{ 0xFD1A002CU, 0x00717F00U, 0x00014800U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_CTRL */
+	{ 0xFD1A002CU, 0x00000008U, 0x00000008U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_CTRL */
+	{ 0xFD1A002CU, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_CTRL */
+	{ 0xFD1A002CU, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_CTRL */
+	{ 0xFD1A0044U, 0x00000002U, 0x00000002U, PSU_OP_POLL },	/* CRF_APB_PLL_STATUS */
+	{ 0xFD1A002CU, 0x00000008U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_CTRL */
+	{ 0xFD1A004CU, 0x00003F00U, 0x00000300U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPLL_TO_LPD_CTRL */
+	{ 0xFD1A003CU, 0xFE7FEDEFU, 0x7E4B0C62U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_CFG */
+	{ 0xFD1A0038U, 0x00717F00U, 0x00014000U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_CTRL */
+	{ 0xFD1A0038U, 0x00000008U, 0x00000008U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_CTRL */
+	{ 0xFD1A0038U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_CTRL */
+	{ 0xFD1A0038U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_CTRL */
+	{ 0xFD1A0044U, 0x00000004U, 0x00000004U, PSU_OP_POLL },	/* CRF_APB_PLL_STATUS */
+	{ 0xFD1A0038U, 0x00000008U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_CTRL */
+	{ 0xFD1A0050U, 0x00003F00U, 0x00000200U, PSU_OP_MASK_WRITE },	/* CRF_APB_VPLL_TO_LPD_CTRL */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_clock_init_data_ops[] = {
+	{ 0xFF5E0090U, 0x01003F07U, 0x01000202U, PSU_OP_MASK_WRITE },	/* CRL_APB_CPU_R5_CTRL */
+	{ 0xFF5E009CU, 0x01003F07U, 0x01000300U, PSU_OP_MASK_WRITE },	/* CRL_APB_IOU_SWITCH_CTRL */
+	{ 0xFF5E00A4U, 0x01003F07U, 0x01000500U, PSU_OP_MASK_WRITE },	/* CRL_APB_PCAP_CTRL */
+	{ 0xFF5E00A8U, 0x01003F07U, 0x01000202U, PSU_OP_MASK_WRITE },	/* CRL_APB_LPD_SWITCH_CTRL */
+	{ 0xFF5E00ACU, 0x01003F07U, 0x01000A02U, PSU_OP_MASK_WRITE },	/* CRL_APB_LPD_LSBUS_CTRL */
+	{ 0xFF5E00B0U, 0x01003F07U, 0x01000402U, PSU_OP_MASK_WRITE },	/* CRL_APB_DBG_LPD_CTRL */
+	{ 0xFF5E00B8U, 0x01003F07U, 0x01000202U, PSU_OP_MASK_WRITE },	/* CRL_APB_ADMA_REF_CTRL */
+	{ 0xFF5E00C0U, 0x013F3F07U, 0x01010802U, PSU_OP_MASK_WRITE },	/* CRL_APB_PL0_REF_CTRL */
+	{ 0xFF5E0108U, 0x013F3F07U, 0x01011402U, PSU_OP_MASK_WRITE },	/* CRL_APB_AMS_REF_CTRL */
+	{ 0xFF5E0104U, 0x00000007U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_DLL_REF_CTRL */
+	{ 0xFF5E0128U, 0x01003F07U, 0x01000104U, PSU_OP_MASK_WRITE },	/* CRL_APB_TIMESTAMP_REF_CTRL */
+	{ 0xFD1A0060U, 0x03003F07U, 0x03000100U, PSU_OP_MASK_WRITE },	/* CRF_APB_ACPU_CTRL */
+	{ 0xFD1A0068U, 0x01003F07U, 0x01000200U, PSU_OP_MASK_WRITE },	/* CRF_APB_DBG_FPD_CTRL */
+	{ 0xFD1A0080U, 0x00003F07U, 0x00000300U, PSU_OP_MASK_WRITE },	/* CRF_APB_DDR_CTRL */
+	{ 0xFD1A0084U, 0x07003F07U, 0x07000203U, PSU_OP_MASK_WRITE },	/* CRF_APB_GPU_REF_CTRL */
+	{ 0xFD1A00B8U, 0x01003F07U, 0x01000203U, PSU_OP_MASK_WRITE },	/* CRF_APB_GDMA_REF_CTRL */
+	{ 0xFD1A00BCU, 0x01003F07U, 0x01000203U, PSU_OP_MASK_WRITE },	/* CRF_APB_DPDMA_REF_CTRL */
+	{ 0xFD1A00C0U, 0x01003F07U, 0x01000202U, PSU_OP_MASK_WRITE },	/* CRF_APB_TOPSW_MAIN_CTRL */
+	{ 0xFD1A00C4U, 0x01003F07U, 0x01000502U, PSU_OP_MASK_WRITE },	/* CRF_APB_TOPSW_LSBUS_CTRL */
+	{ 0xFD1A00F8U, 0x00003F07U, 0x00000200U, PSU_OP_MASK_WRITE },	/* CRF_APB_DBG_TSTMP_CTRL */
+	{ 0xFF180380U, 0x000000FFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_IOU_TTC_APB_CLK */
+	{ 0xFD610100U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* FPD_SLCR_WDT_CLK_SEL */
+	{ 0xFF180300U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_WDT_CLK_SEL */
+	{ 0xFF410050U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* LPD_SLCR_CSUPMU_WDT_CLK_SEL */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_init_data_ops[] = {
+	{ 0xFD1A0108U, 0x00000008U, 0x00000008U, PSU_OP_MASK_WRITE },	/* CRF_APB_RST_DDR_SS */
+	{ 0xFD070000U, 0xE30FBE3DU, 0x41040010U, PSU_OP_MASK_WRITE },	/* DDRC_MSTR */
+	{ 0xFD070010U, 0x8000F03FU, 0x00000030U, PSU_OP_MASK_WRITE },	/* DDRC_MRCTRL0 */
+	{ 0xFD070020U, 0x000003F3U, 0x00000200U, PSU_OP_MASK_WRITE },	/* DDRC_DERATEEN */
+	{ 0xFD070024U, 0xFFFFFFFFU, 0x00800000U, PSU_OP_WRITE },	/* DDRC_DERATEINT */
+	{ 0xFD070030U, 0x0000007FU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_PWRCTL */
+	{ 0xFD070034U, 0x00FFFF1FU, 0x00406310U, PSU_OP_MASK_WRITE },	/* DDRC_PWRTMG */
+	{ 0xFD070050U, 0x00F1F1F4U, 0x00210000U, PSU_OP_MASK_WRITE },	/* DDRC_RFSHCTL0 */
+	{ 0xFD070054U, 0x0FFF0FFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_RFSHCTL1 */
+	{ 0xFD070060U, 0x00000073U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_RFSHCTL3 */
+	{ 0xFD070064U, 0x0FFF83FFU, 0x00618040U, PSU_OP_MASK_WRITE },	/* DDRC_RFSHTMG */
+	{ 0xFD070070U, 0x00000017U, 0x00000010U, PSU_OP_MASK_WRITE },	/* DDRC_ECCCFG0 */
+	{ 0xFD070074U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_ECCCFG1 */
+	{ 0xFD0700C4U, 0x3F000391U, 0x10000200U, PSU_OP_MASK_WRITE },	/* DDRC_CRCPARCTL1 */
+	{ 0xFD0700C8U, 0x01FF1F3FU, 0x0030051FU, PSU_OP_MASK_WRITE },	/* DDRC_CRCPARCTL2 */
+	{ 0xFD0700D0U, 0xC3FF0FFFU, 0x000200C5U, PSU_OP_MASK_WRITE },	/* DDRC_INIT0 */
+	{ 0xFD0700D4U, 0x01FF7F0FU, 0x00020000U, PSU_OP_MASK_WRITE },	/* DDRC_INIT1 */
+	{ 0xFD0700D8U, 0x0000FF0FU, 0x00001A05U, PSU_OP_MASK_WRITE },	/* DDRC_INIT2 */
+	{ 0xFD0700DCU, 0xFFFFFFFFU, 0x03040301U, PSU_OP_WRITE },	/* DDRC_INIT3 */
+	{ 0xFD0700E0U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDRC_INIT4 */
+	{ 0xFD0700E4U, 0x00FF03FFU, 0x00210004U, PSU_OP_MASK_WRITE },	/* DDRC_INIT5 */
+	{ 0xFD0700E8U, 0xFFFFFFFFU, 0x000006C0U, PSU_OP_WRITE },	/* DDRC_INIT6 */
+	{ 0xFD0700ECU, 0xFFFF0000U, 0x04190000U, PSU_OP_MASK_WRITE },	/* DDRC_INIT7 */
+	{ 0xFD0700F0U, 0x0000003FU, 0x00000010U, PSU_OP_MASK_WRITE },	/* DDRC_DIMMCTL */
+	{ 0xFD0700F4U, 0x00000FFFU, 0x0000066FU, PSU_OP_MASK_WRITE },	/* DDRC_RANKCTL */
+	{ 0xFD070100U, 0x7F3F7F3FU, 0x0C0E1A0EU, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG0 */
+	{ 0xFD070104U, 0x001F1F7FU, 0x00030313U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG1 */
+	{ 0xFD070108U, 0x3F3F3F3FU, 0x0505060AU, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG2 */
+	{ 0xFD07010CU, 0x3FF3F3FFU, 0x0050400CU, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG3 */
+	{ 0xFD070110U, 0x1F0F0F1FU, 0x05030306U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG4 */
+	{ 0xFD070114U, 0x0F0F3F1FU, 0x04040302U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG5 */
+	{ 0xFD070118U, 0x0F0F000FU, 0x01010003U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG6 */
+	{ 0xFD07011CU, 0x00000F0FU, 0x00000404U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG7 */
+	{ 0xFD070120U, 0x7F7F7F7FU, 0x03030B04U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG8 */
+	{ 0xFD070124U, 0x40070F3FU, 0x00020208U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG9 */
+	{ 0xFD07012CU, 0x7F1F031FU, 0x0F05010EU, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG11 */
+	{ 0xFD070130U, 0x00030F1FU, 0x00020608U, PSU_OP_MASK_WRITE },	/* DDRC_DRAMTMG12 */
+	{ 0xFD070180U, 0xF7FF03FFU, 0x81000040U, PSU_OP_MASK_WRITE },	/* DDRC_ZQCTL0 */
+	{ 0xFD070184U, 0x3FFFFFFFU, 0x0201312CU, PSU_OP_MASK_WRITE },	/* DDRC_ZQCTL1 */
+	{ 0xFD070190U, 0x1FBFBF3FU, 0x04868206U, PSU_OP_MASK_WRITE },	/* DDRC_DFITMG0 */
+	{ 0xFD070194U, 0xF31F0F0FU, 0x00030304U, PSU_OP_MASK_WRITE },	/* DDRC_DFITMG1 */
+	{ 0xFD070198U, 0x0FF1F1F1U, 0x07000101U, PSU_OP_MASK_WRITE },	/* DDRC_DFILPCFG0 */
+	{ 0xFD07019CU, 0x000000F1U, 0x00000021U, PSU_OP_MASK_WRITE },	/* DDRC_DFILPCFG1 */
+	{ 0xFD0701A0U, 0xC3FF03FFU, 0x00400003U, PSU_OP_MASK_WRITE },	/* DDRC_DFIUPD0 */
+	{ 0xFD0701A4U, 0x00FF00FFU, 0x00C800FFU, PSU_OP_MASK_WRITE },	/* DDRC_DFIUPD1 */
+	{ 0xFD0701B0U, 0x00000007U, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_DFIMISC */
+	{ 0xFD0701B4U, 0x00003F3FU, 0x00000404U, PSU_OP_MASK_WRITE },	/* DDRC_DFITMG2 */
+	{ 0xFD0701C0U, 0x00000007U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_DBICTL */
+	{ 0xFD070200U, 0x0000001FU, 0x0000001FU, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP0 */
+	{ 0xFD070204U, 0x001F1F1FU, 0x001F0A0AU, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP1 */
+	{ 0xFD070208U, 0x0F0F0F0FU, 0x01010100U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP2 */
+	{ 0xFD07020CU, 0x0F0F0F0FU, 0x01010101U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP3 */
+	{ 0xFD070210U, 0x00000F0FU, 0x00000F0FU, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP4 */
+	{ 0xFD070214U, 0x0F0F0F0FU, 0x080F0808U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP5 */
+	{ 0xFD070218U, 0x8F0F0F0FU, 0x0F0F0808U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP6 */
+	{ 0xFD07021CU, 0x00000F0FU, 0x00000F0FU, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP7 */
+	{ 0xFD070220U, 0x00001F1FU, 0x00000801U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP8 */
+	{ 0xFD070224U, 0x0F0F0F0FU, 0x08080808U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP9 */
+	{ 0xFD070228U, 0x0F0F0F0FU, 0x08080808U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP10 */
+	{ 0xFD07022CU, 0x0000000FU, 0x00000008U, PSU_OP_MASK_WRITE },	/* DDRC_ADDRMAP11 */
+	{ 0xFD070240U, 0x0F1F0F7CU, 0x06000600U, PSU_OP_MASK_WRITE },	/* DDRC_ODTCFG */
+	{ 0xFD070244U, 0x00003333U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_ODTMAP */
+	{ 0xFD070250U, 0x7FFF3F07U, 0x01002001U, PSU_OP_MASK_WRITE },	/* DDRC_SCHED */
+	{ 0xFD070264U, 0xFF00FFFFU, 0x08000040U, PSU_OP_MASK_WRITE },	/* DDRC_PERFLPR1 */
+	{ 0xFD07026CU, 0xFF00FFFFU, 0x08000040U, PSU_OP_MASK_WRITE },	/* DDRC_PERFWR1 */
+	{ 0xFD070280U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDRC_DQMAP0 */
+	{ 0xFD070284U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDRC_DQMAP1 */
+	{ 0xFD070288U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDRC_DQMAP2 */
+	{ 0xFD07028CU, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDRC_DQMAP3 */
+	{ 0xFD070290U, 0x0000FFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_DQMAP4 */
+	{ 0xFD070294U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_DQMAP5 */
+	{ 0xFD070300U, 0x00000011U, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_DBG0 */
+	{ 0xFD07030CU, 0x80000033U, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_DBGCMD */
+	{ 0xFD070320U, 0x00000001U, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_SWCTL */
+	{ 0xFD070400U, 0x00000111U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCCFG */
+	{ 0xFD070404U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGR_0 */
+	{ 0xFD070408U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGW_0 */
+	{ 0xFD070490U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCTRL_0 */
+	{ 0xFD070494U, 0x0033000FU, 0x0020000BU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS0_0 */
+	{ 0xFD070498U, 0x07FF07FFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS1_0 */
+	{ 0xFD0704B4U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGR_1 */
+	{ 0xFD0704B8U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGW_1 */
+	{ 0xFD070540U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCTRL_1 */
+	{ 0xFD070544U, 0x03330F0FU, 0x02000B03U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS0_1 */
+	{ 0xFD070548U, 0x07FF07FFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS1_1 */
+	{ 0xFD070564U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGR_2 */
+	{ 0xFD070568U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGW_2 */
+	{ 0xFD0705F0U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCTRL_2 */
+	{ 0xFD0705F4U, 0x03330F0FU, 0x02000B03U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS0_2 */
+	{ 0xFD0705F8U, 0x07FF07FFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS1_2 */
+	{ 0xFD070614U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGR_3 */
+	{ 0xFD070618U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGW_3 */
+	{ 0xFD0706A0U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCTRL_3 */
+	{ 0xFD0706A4U, 0x0033000FU, 0x00100003U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS0_3 */
+	{ 0xFD0706A8U, 0x07FF07FFU, 0x0000004FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS1_3 */
+	{ 0xFD0706ACU, 0x0033000FU, 0x00100003U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGWQOS0_3 */
+	{ 0xFD0706B0U, 0x000007FFU, 0x0000004FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGWQOS1_3 */
+	{ 0xFD0706C4U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGR_4 */
+	{ 0xFD0706C8U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGW_4 */
+	{ 0xFD070750U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCTRL_4 */
+	{ 0xFD070754U, 0x0033000FU, 0x00100003U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS0_4 */
+	{ 0xFD070758U, 0x07FF07FFU, 0x0000004FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS1_4 */
+	{ 0xFD07075CU, 0x0033000FU, 0x00100003U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGWQOS0_4 */
+	{ 0xFD070760U, 0x000007FFU, 0x0000004FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGWQOS1_4 */
+	{ 0xFD070774U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGR_5 */
+	{ 0xFD070778U, 0x000073FFU, 0x0000200FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGW_5 */
+	{ 0xFD070800U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* DDRC_PCTRL_5 */
+	{ 0xFD070804U, 0x0033000FU, 0x00100003U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS0_5 */
+	{ 0xFD070808U, 0x07FF07FFU, 0x0000004FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGQOS1_5 */
+	{ 0xFD07080CU, 0x0033000FU, 0x00100003U, PSU_OP_MASK_WRITE },	/* DDRC_PCFGWQOS0_5 */
+	{ 0xFD070810U, 0x000007FFU, 0x0000004FU, PSU_OP_MASK_WRITE },	/* DDRC_PCFGWQOS1_5 */
+	{ 0xFD070F04U, 0x000001FFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_SARBASE0 */
+	{ 0xFD070F08U, 0x000000FFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* DDRC_SARSIZE0 */
+	{ 0xFD070F0CU, 0x000001FFU, 0x00000010U, PSU_OP_MASK_WRITE },	/* DDRC_SARBASE1 */
+	{ 0xFD070F10U, 0x000000FFU, 0x0000000FU, PSU_OP_MASK_WRITE },	/* DDRC_SARSIZE1 */
+	{ 0xFD072190U, 0x1FBFBF3FU, 0x07828002U, PSU_OP_MASK_WRITE },	/* DDRC_DFITMG0_SHADOW */
+	{ 0xFD1A0108U, 0x0000000CU, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_RST_DDR_SS */
+	{ 0xFD080010U, 0xFFFFFFFFU, 0x07001E00U, PSU_OP_WRITE },	/* DDR_PHY_PGCR0 */
+	{ 0xFD080018U, 0xFFFFFFFFU, 0x00F0BF10U, PSU_OP_WRITE },	/* DDR_PHY_PGCR2 */
+	{ 0xFD08001CU, 0xFFFFFFFFU, 0x55AA5480U, PSU_OP_WRITE },	/* DDR_PHY_PGCR3 */
+	{ 0xFD080024U, 0xFFFFFFFFU, 0x010100F4U, PSU_OP_WRITE },	/* DDR_PHY_PGCR5 */
+	{ 0xFD080040U, 0xFFFFFFFFU, 0x32019010U, PSU_OP_WRITE },	/* DDR_PHY_PTR0 */
+	{ 0xFD080044U, 0xFFFFFFFFU, 0x9C400E10U, PSU_OP_WRITE },	/* DDR_PHY_PTR1 */
+	{ 0xFD080068U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_PLLCR0 */
+	{ 0xFD080090U, 0xFFFFFFFFU, 0x02A040E1U, PSU_OP_WRITE },	/* DDR_PHY_DSGCR */
+	{ 0xFD0800C0U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_GPR0 */
+	{ 0xFD0800C4U, 0xFFFFFFFFU, 0x000000DAU, PSU_OP_WRITE },	/* DDR_PHY_GPR1 */
+	{ 0xFD080100U, 0xFFFFFFFFU, 0x0800040CU, PSU_OP_WRITE },	/* DDR_PHY_DCR */
+	{ 0xFD080110U, 0xFFFFFFFFU, 0x051C0A06U, PSU_OP_WRITE },	/* DDR_PHY_DTPR0 */
+	{ 0xFD080114U, 0xFFFFFFFFU, 0x281C0008U, PSU_OP_WRITE },	/* DDR_PHY_DTPR1 */
+	{ 0xFD080118U, 0xFFFFFFFFU, 0x000F0255U, PSU_OP_WRITE },	/* DDR_PHY_DTPR2 */
+	{ 0xFD08011CU, 0xFFFFFFFFU, 0x82550800U, PSU_OP_WRITE },	/* DDR_PHY_DTPR3 */
+	{ 0xFD080120U, 0xFFFFFFFFU, 0x00802B05U, PSU_OP_WRITE },	/* DDR_PHY_DTPR4 */
+	{ 0xFD080124U, 0xFFFFFFFFU, 0x00260A06U, PSU_OP_WRITE },	/* DDR_PHY_DTPR5 */
+	{ 0xFD080128U, 0xFFFFFFFFU, 0x0000090AU, PSU_OP_WRITE },	/* DDR_PHY_DTPR6 */
+	{ 0xFD080140U, 0xFFFFFFFFU, 0x08400020U, PSU_OP_WRITE },	/* DDR_PHY_RDIMMGCR0 */
+	{ 0xFD080144U, 0xFFFFFFFFU, 0x00000C80U, PSU_OP_WRITE },	/* DDR_PHY_RDIMMGCR1 */
+	{ 0xFD080150U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_RDIMMCR0 */
+	{ 0xFD080154U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_RDIMMCR1 */
+	{ 0xFD080180U, 0xFFFFFFFFU, 0x00000204U, PSU_OP_WRITE },	/* DDR_PHY_MR0 */
+	{ 0xFD080184U, 0xFFFFFFFFU, 0x00000301U, PSU_OP_WRITE },	/* DDR_PHY_MR1 */
+	{ 0xFD080188U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_MR2 */
+	{ 0xFD08018CU, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_MR3 */
+	{ 0xFD080190U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_MR4 */
+	{ 0xFD080194U, 0xFFFFFFFFU, 0x000006C0U, PSU_OP_WRITE },	/* DDR_PHY_MR5 */
+	{ 0xFD080198U, 0xFFFFFFFFU, 0x00000419U, PSU_OP_WRITE },	/* DDR_PHY_MR6 */
+	{ 0xFD0801ACU, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_MR11 */
+	{ 0xFD0801B0U, 0xFFFFFFFFU, 0x0000004DU, PSU_OP_WRITE },	/* DDR_PHY_MR12 */
+	{ 0xFD0801B4U, 0xFFFFFFFFU, 0x00000008U, PSU_OP_WRITE },	/* DDR_PHY_MR13 */
+	{ 0xFD0801B8U, 0xFFFFFFFFU, 0x0000004DU, PSU_OP_WRITE },	/* DDR_PHY_MR14 */
+	{ 0xFD0801D8U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_MR22 */
+	{ 0xFD080200U, 0xFFFFFFFFU, 0x800091C7U, PSU_OP_WRITE },	/* DDR_PHY_DTCR0 */
+	{ 0xFD080204U, 0xFFFFFFFFU, 0x00010236U, PSU_OP_WRITE },	/* DDR_PHY_DTCR1 */
+	{ 0xFD080240U, 0xFFFFFFFFU, 0x00141054U, PSU_OP_WRITE },	/* DDR_PHY_CATR0 */
+	{ 0xFD080250U, 0xFFFFFFFFU, 0x00088000U, PSU_OP_WRITE },	/* DDR_PHY_DQSDR0 */
+	{ 0xFD080414U, 0xFFFFFFFFU, 0x12340800U, PSU_OP_WRITE },	/* DDR_PHY_BISTLSR */
+	{ 0xFD0804F4U, 0xFFFFFFFFU, 0x00000005U, PSU_OP_WRITE },	/* DDR_PHY_RIOCR5 */
+	{ 0xFD080500U, 0xFFFFFFFFU, 0x30000028U, PSU_OP_WRITE },	/* DDR_PHY_ACIOCR0 */
+	{ 0xFD080508U, 0xFFFFFFFFU, 0x0A000000U, PSU_OP_WRITE },	/* DDR_PHY_ACIOCR2 */
+	{ 0xFD08050CU, 0xFFFFFFFFU, 0x00000009U, PSU_OP_WRITE },	/* DDR_PHY_ACIOCR3 */
+	{ 0xFD080510U, 0xFFFFFFFFU, 0x0A000000U, PSU_OP_WRITE },	/* DDR_PHY_ACIOCR4 */
+	{ 0xFD080520U, 0xFFFFFFFFU, 0x0300B0CEU, PSU_OP_WRITE },	/* DDR_PHY_IOVCR0 */
+	{ 0xFD080528U, 0xFFFFFFFFU, 0xF9032019U, PSU_OP_WRITE },	/* DDR_PHY_VTCR0 */
+	{ 0xFD08052CU, 0xFFFFFFFFU, 0x07F001E3U, PSU_OP_WRITE },	/* DDR_PHY_VTCR1 */
+	{ 0xFD080544U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_ACBDLR1 */
+	{ 0xFD080548U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_ACBDLR2 */
+	{ 0xFD080558U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_ACBDLR6 */
+	{ 0xFD08055CU, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_ACBDLR7 */
+	{ 0xFD080560U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_ACBDLR8 */
+	{ 0xFD080564U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_ACBDLR9 */
+	{ 0xFD080680U, 0xFFFFFFFFU, 0x0089EA58U, PSU_OP_WRITE },	/* DDR_PHY_ZQCR */
+	{ 0xFD080684U, 0xFFFFFFFFU, 0x000079DDU, PSU_OP_WRITE },	/* DDR_PHY_ZQ0PR0 */
+	{ 0xFD080694U, 0xFFFFFFFFU, 0x01E10210U, PSU_OP_WRITE },	/* DDR_PHY_ZQ0OR0 */
+	{ 0xFD080698U, 0xFFFFFFFFU, 0x01E10000U, PSU_OP_WRITE },	/* DDR_PHY_ZQ0OR1 */
+	{ 0xFD0806A4U, 0xFFFFFFFFU, 0x00087BDBU, PSU_OP_WRITE },	/* DDR_PHY_ZQ1PR0 */
+	{ 0xFD080700U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX0GCR0 */
+	{ 0xFD080704U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX0GCR1 */
+	{ 0xFD08070CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX0GCR3 */
+	{ 0xFD080710U, 0xFFFFFFFFU, 0x0E00B03CU, PSU_OP_WRITE },	/* DDR_PHY_DX0GCR4 */
+	{ 0xFD080714U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX0GCR5 */
+	{ 0xFD080718U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX0GCR6 */
+	{ 0xFD080800U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX1GCR0 */
+	{ 0xFD080804U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX1GCR1 */
+	{ 0xFD08080CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX1GCR3 */
+	{ 0xFD080810U, 0xFFFFFFFFU, 0x0E00B03CU, PSU_OP_WRITE },	/* DDR_PHY_DX1GCR4 */
+	{ 0xFD080814U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX1GCR5 */
+	{ 0xFD080818U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX1GCR6 */
+	{ 0xFD080900U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX2GCR0 */
+	{ 0xFD080904U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX2GCR1 */
+	{ 0xFD08090CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX2GCR3 */
+	{ 0xFD080910U, 0xFFFFFFFFU, 0x0E00B03CU, PSU_OP_WRITE },	/* DDR_PHY_DX2GCR4 */
+	{ 0xFD080914U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX2GCR5 */
+	{ 0xFD080918U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX2GCR6 */
+	{ 0xFD080A00U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX3GCR0 */
+	{ 0xFD080A04U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX3GCR1 */
+	{ 0xFD080A0CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX3GCR3 */
+	{ 0xFD080A10U, 0xFFFFFFFFU, 0x0E00B03CU, PSU_OP_WRITE },	/* DDR_PHY_DX3GCR4 */
+	{ 0xFD080A14U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX3GCR5 */
+	{ 0xFD080A18U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX3GCR6 */
+	{ 0xFD080B00U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR0 */
+	{ 0xFD080B04U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR1 */
+	{ 0xFD080B08U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR2 */
+	{ 0xFD080B0CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR3 */
+	{ 0xFD080B10U, 0xFFFFFFFFU, 0x0E00B004U, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR4 */
+	{ 0xFD080B14U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR5 */
+	{ 0xFD080B18U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX4GCR6 */
+	{ 0xFD080C00U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR0 */
+	{ 0xFD080C04U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR1 */
+	{ 0xFD080C08U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR2 */
+	{ 0xFD080C0CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR3 */
+	{ 0xFD080C10U, 0xFFFFFFFFU, 0x0E00B03CU, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR4 */
+	{ 0xFD080C14U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR5 */
+	{ 0xFD080C18U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX5GCR6 */
+	{ 0xFD080D00U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR0 */
+	{ 0xFD080D04U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR1 */
+	{ 0xFD080D08U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR2 */
+	{ 0xFD080D0CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR3 */
+	{ 0xFD080D10U, 0xFFFFFFFFU, 0x0E00B004U, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR4 */
+	{ 0xFD080D14U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR5 */
+	{ 0xFD080D18U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX6GCR6 */
+	{ 0xFD080E00U, 0xFFFFFFFFU, 0x40800604U, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR0 */
+	{ 0xFD080E04U, 0xFFFFFFFFU, 0x00007FFFU, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR1 */
+	{ 0xFD080E08U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR2 */
+	{ 0xFD080E0CU, 0xFFFFFFFFU, 0x3F000008U, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR3 */
+	{ 0xFD080E10U, 0xFFFFFFFFU, 0x0E00B03CU, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR4 */
+	{ 0xFD080E14U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR5 */
+	{ 0xFD080E18U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX7GCR6 */
+	{ 0xFD080F00U, 0xFFFFFFFFU, 0x40803660U, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR0 */
+	{ 0xFD080F04U, 0xFFFFFFFFU, 0x55556000U, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR1 */
+	{ 0xFD080F08U, 0xFFFFFFFFU, 0xAAAAAAAAU, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR2 */
+	{ 0xFD080F0CU, 0xFFFFFFFFU, 0x0029A4A4U, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR3 */
+	{ 0xFD080F10U, 0xFFFFFFFFU, 0x0C00B000U, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR4 */
+	{ 0xFD080F14U, 0xFFFFFFFFU, 0x09094F4FU, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR5 */
+	{ 0xFD080F18U, 0xFFFFFFFFU, 0x09092B2BU, PSU_OP_WRITE },	/* DDR_PHY_DX8GCR6 */
+	{ 0xFD081400U, 0xFFFFFFFFU, 0x2A019FFEU, PSU_OP_WRITE },	/* DDR_PHY_DX8SL0OSC */
+	{ 0xFD081404U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL0PLLCR0 */
+	{ 0xFD08141CU, 0xFFFFFFFFU, 0x01264300U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL0DQSCTL */
+	{ 0xFD08142CU, 0xFFFFFFFFU, 0x00041800U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL0DXCTL2 */
+	{ 0xFD081430U, 0xFFFFFFFFU, 0x70800000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL0IOCR */
+	{ 0xFD081440U, 0xFFFFFFFFU, 0x2A019FFEU, PSU_OP_WRITE },	/* DDR_PHY_DX8SL1OSC */
+	{ 0xFD081444U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL1PLLCR0 */
+	{ 0xFD08145CU, 0xFFFFFFFFU, 0x01264300U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL1DQSCTL */
+	{ 0xFD08146CU, 0xFFFFFFFFU, 0x00041800U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL1DXCTL2 */
+	{ 0xFD081470U, 0xFFFFFFFFU, 0x70800000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL1IOCR */
+	{ 0xFD081480U, 0xFFFFFFFFU, 0x2A019FFEU, PSU_OP_WRITE },	/* DDR_PHY_DX8SL2OSC */
+	{ 0xFD081484U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL2PLLCR0 */
+	{ 0xFD08149CU, 0xFFFFFFFFU, 0x01264300U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL2DQSCTL */
+	{ 0xFD0814ACU, 0xFFFFFFFFU, 0x00041800U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL2DXCTL2 */
+	{ 0xFD0814B0U, 0xFFFFFFFFU, 0x70800000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL2IOCR */
+	{ 0xFD0814C0U, 0xFFFFFFFFU, 0x2A019FFEU, PSU_OP_WRITE },	/* DDR_PHY_DX8SL3OSC */
+	{ 0xFD0814C4U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL3PLLCR0 */
+	{ 0xFD0814DCU, 0xFFFFFFFFU, 0x01264300U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL3DQSCTL */
+	{ 0xFD0814ECU, 0xFFFFFFFFU, 0x00041800U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL3DXCTL2 */
+	{ 0xFD0814F0U, 0xFFFFFFFFU, 0x70800000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL3IOCR */
+	{ 0xFD081500U, 0xFFFFFFFFU, 0x15019FFEU, PSU_OP_WRITE },	/* DDR_PHY_DX8SL4OSC */
+	{ 0xFD081504U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL4PLLCR0 */
+	{ 0xFD08151CU, 0xFFFFFFFFU, 0x01264300U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL4DQSCTL */
+	{ 0xFD08152CU, 0xFFFFFFFFU, 0x00041800U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL4DXCTL2 */
+	{ 0xFD081530U, 0xFFFFFFFFU, 0x70800000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SL4IOCR */
+	{ 0xFD0817C4U, 0xFFFFFFFFU, 0x02120000U, PSU_OP_WRITE },	/* DDR_PHY_DX8SLBPLLCR0 */
+	{ 0xFD0817DCU, 0xFFFFFFFFU, 0x012643C4U, PSU_OP_WRITE },	/* DDR_PHY_DX8SLBDQSCTL */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_qos_init_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_mio_init_data_ops[] = {
+	{ 0xFF180138U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK0_CTRL0 */
+	{ 0xFF18013CU, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK0_CTRL1 */
+	{ 0xFF180140U, 0x03FFFFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK0_CTRL3 */
+	{ 0xFF180144U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK0_CTRL4 */
+	{ 0xFF180148U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK0_CTRL5 */
+	{ 0xFF18014CU, 0x03FFFFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK0_CTRL6 */
+	{ 0xFF180154U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK1_CTRL0 */
+	{ 0xFF180158U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK1_CTRL1 */
+	{ 0xFF18015CU, 0x03FFFFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK1_CTRL3 */
+	{ 0xFF180160U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK1_CTRL4 */
+	{ 0xFF180164U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK1_CTRL5 */
+	{ 0xFF180168U, 0x03FFFFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK1_CTRL6 */
+	{ 0xFF180170U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK2_CTRL0 */
+	{ 0xFF180174U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK2_CTRL1 */
+	{ 0xFF180178U, 0x03FFFFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK2_CTRL3 */
+	{ 0xFF18017CU, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK2_CTRL4 */
+	{ 0xFF180180U, 0x03FFFFFFU, 0x03FFFFFFU, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK2_CTRL5 */
+	{ 0xFF180184U, 0x03FFFFFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_BANK2_CTRL6 */
+	{ 0xFF180200U, 0x0000000FU, 0x00000000U, PSU_OP_MASK_WRITE },	/* IOU_SLCR_MIO_LOOPBACK */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_peripherals_pre_init_data_ops[] = {
+	{ 0xFF5E0108U, 0x013F3F07U, 0x01012302U, PSU_OP_MASK_WRITE },	/* CRL_APB_AMS_REF_CTRL */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_peripherals_init_data_ops[] = {
+	{ 0xFD1A0100U, 0x0000007CU, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_RST_FPD_TOP */
+	{ 0xFF5E0238U, 0x001A0000U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RST_LPD_IOU2 */
+	{ 0xFF5E023CU, 0x0093C018U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RST_LPD_TOP */
+	{ 0xFF5E0238U, 0x00040000U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RST_LPD_IOU2 */
+	{ 0xFF4B0024U, 0x000000FFU, 0x000000FFU, PSU_OP_MASK_WRITE },	/* LPD_SLCR_SECURE_SLCR_ADMA */
+	{ 0xFFCA5000U, 0x00001FFFU, 0x00000000U, PSU_OP_MASK_WRITE },	/* CSU_TAMPER_STATUS */
+	{ 0xFD5C0060U, 0x000F000FU, 0x00000000U, PSU_OP_MASK_WRITE },	/* APU_ACE_CTRL */
+	{ 0xFFA60040U, 0x80000000U, 0x80000000U, PSU_OP_MASK_WRITE },	/* RTC_CONTROL */
+	{ 0xFF260020U, 0xFFFFFFFFU, 0x01FC9F08U, PSU_OP_WRITE },	/* IOU_SCNTRS_BASE_FREQUENCY_ID_REGISTER */
+	{ 0xFF260000U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* IOU_SCNTRS_COUNTER_CONTROL_REGISTER */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_post_config_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_peripherals_powerdwn_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_lpd_xppu_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_xmpu0_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_xmpu1_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_xmpu2_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_xmpu3_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_xmpu4_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ddr_xmpu5_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ocm_xmpu_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_fpd_xmpu_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_protection_lock_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_apply_master_tz_ops[] = {
+	{ 0xFD690040U, 0x00000001U, 0x00000001U, PSU_OP_MASK_WRITE },	/* FPD_SLCR_SECURE_SLCR_DPDMA */
+	{ 0xFD690030U, 0x01FFFFFFU, 0x01FFFFFFU, PSU_OP_MASK_WRITE },	/* FPD_SLCR_SECURE_SLCR_PCIE */
+	{ 0xFF4B0034U, 0x00000003U, 0x00000003U, PSU_OP_MASK_WRITE },	/* LPD_SLCR_SECURE_SLCR_USB */
+	{ 0xFF240004U, 0x003F0000U, 0x00120000U, PSU_OP_MASK_WRITE },	/* IOU_SECURE_SLCR_IOU_AXI_RPRTCN */
+	{ 0xFF240000U, 0x003F0000U, 0x00120000U, PSU_OP_MASK_WRITE },	/* IOU_SECURE_SLCR_IOU_AXI_WPRTCN */
+	{ 0xFF240004U, 0x00000FFFU, 0x00000492U, PSU_OP_MASK_WRITE },	/* IOU_SECURE_SLCR_IOU_AXI_RPRTCN */
+	{ 0xFF240000U, 0x0E000FFFU, 0x04000492U, PSU_OP_MASK_WRITE },	/* IOU_SECURE_SLCR_IOU_AXI_WPRTCN */
+	{ 0xFF240004U, 0x01C00000U, 0x00800000U, PSU_OP_MASK_WRITE },	/* IOU_SECURE_SLCR_IOU_AXI_RPRTCN */
+	{ 0xFF240000U, 0x01C00000U, 0x00800000U, PSU_OP_MASK_WRITE },	/* IOU_SECURE_SLCR_IOU_AXI_WPRTCN */
+	{ 0xFF4B0024U, 0x000000FFU, 0x000000FFU, PSU_OP_MASK_WRITE },	/* LPD_SLCR_SECURE_SLCR_ADMA */
+	{ 0xFD690050U, 0x000000FFU, 0x000000FFU, PSU_OP_MASK_WRITE },	/* FPD_SLCR_SECURE_SLCR_GDMA */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_serdes_init_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_resetout_init_data_ops[] = {
+	{ 0xFD480064U, 0x00000200U, 0x00000200U, PSU_OP_MASK_WRITE },	/* PCIE_ATTRIB_ATTR_25 */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_resetin_init_data_ops[] = {
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ps_pl_isolation_removal_data_ops[] = {
+	{ 0xFFD80118U, 0x00800000U, 0x00800000U, PSU_OP_MASK_WRITE },	/* PMU_GLOBAL_REQ_PWRUP_INT_EN */
+	{ 0xFFD80120U, 0x00800000U, 0x00800000U, PSU_OP_MASK_WRITE },	/* PMU_GLOBAL_REQ_PWRUP_TRIG */
+	{ 0xFFD80110U, 0x00800000U, 0x00000000U, PSU_OP_POLL },	/* PMU_GLOBAL_REQ_PWRUP_STATUS */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_afi_config_ops[] = {
+	{ 0xFD1A0100U, 0x00001F80U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRF_APB_RST_FPD_TOP */
+	{ 0xFF5E023CU, 0x00080000U, 0x00000000U, PSU_OP_MASK_WRITE },	/* CRL_APB_RST_LPD_TOP */
+	{ 0xFF419000U, 0x00000300U, 0x00000000U, PSU_OP_MASK_WRITE },	/* LPD_SLCR_AFI_FS */
+	{ 0xFD360000U, 0x00000003U, 0x00000002U, PSU_OP_MASK_WRITE },	/* AFIFM0_AFIFM_RDCTRL */
+	{ 0xFD380000U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM2_AFIFM_RDCTRL */
+	{ 0xFD390000U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM3_AFIFM_RDCTRL */
+	{ 0xFD3A0000U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM4_AFIFM_RDCTRL */
+	{ 0xFD3B0000U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM5_AFIFM_RDCTRL */
+	{ 0xFD360014U, 0x00000003U, 0x00000002U, PSU_OP_MASK_WRITE },	/* AFIFM0_AFIFM_WRCTRL */
+	{ 0xFD380014U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM2_AFIFM_WRCTRL */
+	{ 0xFD390014U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM3_AFIFM_WRCTRL */
+	{ 0xFD3A0014U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM4_AFIFM_WRCTRL */
+	{ 0xFD3B0014U, 0x00000003U, 0x00000000U, PSU_OP_MASK_WRITE },	/* AFIFM5_AFIFM_WRCTRL */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+static const struct psu_op psu_ps_pl_reset_config_data_ops[] = {
+	{ 0xFF0A002CU, 0xFFFF0000U, 0x80000000U, PSU_OP_MASK_WRITE },	/* GPIO_MASK_DATA_5_MSW */
+	{ 0xFF0A0344U, 0xFFFFFFFFU, 0x80000000U, PSU_OP_WRITE },	/* GPIO_DIRM_5 */
+	{ 0xFF0A0348U, 0xFFFFFFFFU, 0x80000000U, PSU_OP_WRITE },	/* GPIO_OEN_5 */
+	{ 0xFF0A0054U, 0xFFFFFFFFU, 0x80000000U, PSU_OP_WRITE },	/* GPIO_DATA_5 */
+	{ 0x00000000U, 0x00000000U, 0x00000001U, PSU_OP_DELAY },
+	{ 0xFF0A0054U, 0xFFFFFFFFU, 0x00000000U, PSU_OP_WRITE },	/* GPIO_DATA_5 */
+	{ 0x00000000U, 0x00000000U, 0x00000001U, PSU_OP_DELAY },
+	{ 0xFF0A0054U, 0xFFFFFFFFU, 0x80000000U, PSU_OP_WRITE },	/* GPIO_DATA_5 */
+	{ 0, 0, 0, PSU_OP_END },
+};
+
+#ifdef PSU_INIT_OPS_INDEX
+static const struct psu_seq {
+	const char *name;
+	const struct psu_op *ops;
+} psu_seqs[] = {
+	{ "psu_pll_init_data", psu_pll_init_data_ops },
+	{ "psu_clock_init_data", psu_clock_init_data_ops },
+	{ "psu_ddr_init_data", psu_ddr_init_data_ops },
+	{ "psu_ddr_qos_init_data", psu_ddr_qos_init_data_ops },
+	{ "psu_mio_init_data", psu_mio_init_data_ops },
+	{ "psu_peripherals_pre_init_data", psu_peripherals_pre_init_data_ops },
+	{ "psu_peripherals_init_data", psu_peripherals_init_data_ops },
+	{ "psu_post_config_data", psu_post_config_data_ops },
+	{ "psu_peripherals_powerdwn_data", psu_peripherals_powerdwn_data_ops },
+	{ "psu_lpd_xppu_data", psu_lpd_xppu_data_ops },
+	{ "psu_ddr_xmpu0_data", psu_ddr_xmpu0_data_ops },
+	{ "psu_ddr_xmpu1_data", psu_ddr_xmpu1_data_ops },
+	{ "psu_ddr_xmpu2_data", psu_ddr_xmpu2_data_ops },
+	{ "psu_ddr_xmpu3_data", psu_ddr_xmpu3_data_ops },
+	{ "psu_ddr_xmpu4_data", psu_ddr_xmpu4_data_ops },
+	{ "psu_ddr_xmpu5_data", psu_ddr_xmpu5_data_ops },
+	{ "psu_ocm_xmpu_data", psu_ocm_xmpu_data_ops },
+	{ "psu_fpd_xmpu_data", psu_fpd_xmpu_data_ops },
+	{ "psu_protection_lock_data", psu_protection_lock_data_ops },
+	{ "psu_apply_master_tz", psu_apply_master_tz_ops },
+	{ "psu_serdes_init_data", psu_serdes_init_data_ops },
+	{ "psu_resetout_init_data", psu_resetout_init_data_ops },
+	{ "psu_resetin_init_data", psu_resetin_init_data_ops },
+	{ "psu_ps_pl_isolation_removal_data", psu_ps_pl_isolation_removal_data_ops },
+	{ "psu_afi_config", psu_afi_config_ops },
+	{ "psu_ps_pl_reset_config_data", psu_ps_pl_reset_config_data_ops },
+	{ 0, 0 },
+};
+
+/* PSU_OP_CALL targets, by value.  */
+static const char *const psu_call_names[] = {
+	0,
+};
+#endif
+
+#endif
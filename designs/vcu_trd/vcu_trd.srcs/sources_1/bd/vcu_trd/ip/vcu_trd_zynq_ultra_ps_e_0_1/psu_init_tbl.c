@@ -0,0 +1,553 @@
+/******************************************************************************
+*
+* Copyright (C) 2015 Xilinx, Inc.  All rights reserved.
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in
+* all copies or substantial portions of the Software.
+*
+* Use of the Software is limited solely to applications:
+* (a) running on a Xilinx device, or
+* (b) that interact with a Xilinx device through a bus or interconnect.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* XILINX CONSORTIUM BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+* WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF
+* OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* Except as contained in this notice, the name of the Xilinx shall not be used
+* in advertising or otherwise to promote the sale, use or other dealings in
+* this Software without prior written authorization from Xilinx.
+*
+******************************************************************************/
+/****************************************************************************/
+/**
+*
+* @file psu_init.c
+*
+* This file is automatically generated
+*
+*****************************************************************************/
+
+/*
+ * Generated by psu_init_gen from psu_init.c: the init sequences are the
+ * tables of psu_init_ops.h, run by psu_run().
+ */
+#include <xil_io.h>
+#include <sleep.h>
+#include "psu_init.h"
+#include "psu_init_ops.h"
+#define    DPLL_CFG_LOCK_DLY        63
+#define    DPLL_CFG_LOCK_CNT        625
+#define    DPLL_CFG_LFHF            3
+#define    DPLL_CFG_CP              3
+#define    DPLL_CFG_RES             2
+
+static int mask_pollOnValue(u32 add, u32 mask, u32 value);
+
+static void mask_delay(u32 delay);
+
+static u32 mask_read(u32 add, u32 mask);
+
+static void dpll_prog(int ddr_pll_fbdiv, int d_lock_dly,
+	int d_lock_cnt, int d_lfhf, int d_cp, int d_res);
+
+static
+void PSU_Mask_Write(unsigned long offset, unsigned long mask,
+	unsigned long val)
+{
+	unsigned long RegVal = 0x0;
+
+	RegVal = Xil_In32(offset);
+	RegVal &= ~(mask);
+	RegVal |= (val & mask);
+	Xil_Out32(offset, RegVal);
+}
+
+	void prog_reg(unsigned long addr, unsigned long mask,
+	unsigned long shift, unsigned long value) {
+	    int rdata = 0;
+
+	    rdata  = Xil_In32(addr);
+	    rdata  = rdata & (~mask);
+	    rdata  = rdata | (value << shift);
+	    Xil_Out32(addr, rdata);
+	    }
+
+/* Targets of PSU_OP_CALL.  */
+static unsigned long (*const psu_calls[])(void) = {
+	0,
+};
+
+/*
+ * Runs a table from psu_init_ops.h.  As in the code it replaces, a poll
+ * that times out does not stop the sequence.
+ */
+static unsigned long psu_run(const struct psu_op *op)
+{
+	unsigned long status = 1;
+
+	for (;; op++) {
+		switch (op->opcode) {
+		case PSU_OP_END:
+			return status;
+		case PSU_OP_WRITE:
+			Xil_Out32(op->offset, op->value);
+			break;
+		case PSU_OP_MASK_WRITE:
+			PSU_Mask_Write(op->offset, op->mask, op->value);
+			break;
+		case PSU_OP_POLL:
+			mask_pollOnValue(op->offset, op->mask, op->value);
+			break;
+		case PSU_OP_DELAY:
+			mask_delay(op->value);
+			break;
+		case PSU_OP_CALL:
+			status &= psu_calls[op->value]();
+			break;
+		}
+	}
+}
+
+unsigned long psu_pll_init_data(void)
+{
+	return psu_run(psu_pll_init_data_ops);
+}
+unsigned long psu_clock_init_data(void)
+{
+	return psu_run(psu_clock_init_data_ops);
+}
+unsigned long psu_ddr_init_data(void)
+{
+	return psu_run(psu_ddr_init_data_ops);
+}
+unsigned long psu_ddr_qos_init_data(void)
+{
+	return psu_run(psu_ddr_qos_init_data_ops);
+}
+unsigned long psu_mio_init_data(void)
+{
+	return psu_run(psu_mio_init_data_ops);
+}
+unsigned long psu_peripherals_pre_init_data(void)
+{
+	return psu_run(psu_peripherals_pre_init_data_ops);
+}
+unsigned long psu_peripherals_init_data(void)
+{
+	return psu_run(psu_peripherals_init_data_ops);
+}
+unsigned long psu_post_config_data(void)
+{
+	return psu_run(psu_post_config_data_ops);
+}
+unsigned long psu_peripherals_powerdwn_data(void)
+{
+	return psu_run(psu_peripherals_powerdwn_data_ops);
+}
+unsigned long psu_lpd_xppu_data(void)
+{
+	return psu_run(psu_lpd_xppu_data_ops);
+}
+unsigned long psu_ddr_xmpu0_data(void)
+{
+	return psu_run(psu_ddr_xmpu0_data_ops);
+}
+unsigned long psu_ddr_xmpu1_data(void)
+{
+	return psu_run(psu_ddr_xmpu1_data_ops);
+}
+unsigned long psu_ddr_xmpu2_data(void)
+{
+	return psu_run(psu_ddr_xmpu2_data_ops);
+}
+unsigned long psu_ddr_xmpu3_data(void)
+{
+	return psu_run(psu_ddr_xmpu3_data_ops);
+}
+unsigned long psu_ddr_xmpu4_data(void)
+{
+	return psu_run(psu_ddr_xmpu4_data_ops);
+}
+unsigned long psu_ddr_xmpu5_data(void)
+{
+	return psu_run(psu_ddr_xmpu5_data_ops);
+}
+unsigned long psu_ocm_xmpu_data(void)
+{
+	return psu_run(psu_ocm_xmpu_data_ops);
+}
+unsigned long psu_fpd_xmpu_data(void)
+{
+	return psu_run(psu_fpd_xmpu_data_ops);
+}
+unsigned long psu_protection_lock_data(void)
+{
+	return psu_run(psu_protection_lock_data_ops);
+}
+unsigned long psu_apply_master_tz(void)
+{
+	return psu_run(psu_apply_master_tz_ops);
+}
+unsigned long psu_serdes_init_data(void)
+{
+	return psu_run(psu_serdes_init_data_ops);
+}
+unsigned long psu_resetout_init_data(void)
+{
+	return psu_run(psu_resetout_init_data_ops);
+}
+unsigned long psu_resetin_init_data(void)
+{
+	return psu_run(psu_resetin_init_data_ops);
+}
+unsigned long psu_ps_pl_isolation_removal_data(void)
+{
+	return psu_run(psu_ps_pl_isolation_removal_data_ops);
+}
+unsigned long psu_afi_config(void)
+{
+	return psu_run(psu_afi_config_ops);
+}
+unsigned long psu_ps_pl_reset_config_data(void)
+{
+	return psu_run(psu_ps_pl_reset_config_data_ops);
+}
+
+unsigned long psu_ddr_phybringup_data(void)
+{
+
+
+	unsigned int regval = 0;
+
+	unsigned int pll_retry = 10;
+
+	unsigned int pll_locked = 0;
+
+
+	while ((pll_retry > 0) && (!pll_locked)) {
+
+		Xil_Out32(0xFD080004, 0x00040010);/*PIR*/
+		Xil_Out32(0xFD080004, 0x00040011);/*PIR*/
+
+	while ((Xil_In32(0xFD080030) & 0x1) != 1) {
+	/*****TODO*****/
+
+	/*TIMEOUT poll mechanism need to be inserted in this block*/
+
+	}
+
+
+		pll_locked = (Xil_In32(0xFD080030) & 0x80000000)
+		>> 31;/*PGSR0*/
+		pll_locked &= (Xil_In32(0xFD0807E0) & 0x10000)
+		>> 16;/*DX0GSR0*/
+		pll_locked &= (Xil_In32(0xFD0809E0) & 0x10000)
+		>> 16;/*DX2GSR0*/
+		pll_locked &= (Xil_In32(0xFD080BE0) & 0x10000)
+		>> 16;/*DX4GSR0*/
+		pll_locked &= (Xil_In32(0xFD080DE0) & 0x10000)
+		>> 16;/*DX6GSR0*/
+		pll_retry--;
+	}
+	Xil_Out32(0xFD0800C0, Xil_In32(0xFD0800C0) |
+		(pll_retry << 16));/*GPR0*/
+	Xil_Out32(0xFD080004U, 0x00040063U);
+	/* PHY BRINGUP SEQ */
+	while ((Xil_In32(0xFD080030U) & 0x0000000FU) != 0x0000000FU) {
+	/*****TODO*****/
+
+	/*TIMEOUT poll mechanism need to be inserted in this block*/
+
+	}
+
+	prog_reg(0xFD080004U, 0x00000001U, 0x00000000U, 0x00000001U);
+	/* poll for PHY initialization to complete */
+	while ((Xil_In32(0xFD080030U) & 0x000000FFU) != 0x0000001FU) {
+	/*****TODO*****/
+
+	/*TIMEOUT poll mechanism need to be inserted in this block*/
+
+	}
+
+
+	Xil_Out32(0xFD0701B0U, 0x00000001U);
+	Xil_Out32(0xFD070320U, 0x00000001U);
+	while ((Xil_In32(0xFD070004U) & 0x0000000FU) != 0x00000001U) {
+	/*****TODO*****/
+
+	/*TIMEOUT poll mechanism need to be inserted in this block*/
+
+	}
+
+	prog_reg(0xFD080014U, 0x00000040U, 0x00000006U, 0x00000001U);
+	Xil_Out32(0xFD080004, 0x0004FE01); /*PUB_PIR*/
+	regval = Xil_In32(0xFD080030); /*PUB_PGSR0*/
+	while (regval != 0x80000FFF)
+		regval = Xil_In32(0xFD080030); /*PUB_PGSR0*/
+
+/* Run Vref training in static read mode*/
+	Xil_Out32(0xFD080200U, 0x100091C7U);
+	Xil_Out32(0xFD080018U, 0x00F016CFU);
+	prog_reg(0xFD08001CU, 0x00000018U, 0x00000003U, 0x00000003U);
+	prog_reg(0xFD08142CU, 0x00000030U, 0x00000004U, 0x00000003U);
+	prog_reg(0xFD08146CU, 0x00000030U, 0x00000004U, 0x00000003U);
+	prog_reg(0xFD0814ACU, 0x00000030U, 0x00000004U, 0x00000003U);
+	prog_reg(0xFD0814ECU, 0x00000030U, 0x00000004U, 0x00000003U);
+	prog_reg(0xFD08152CU, 0x00000030U, 0x00000004U, 0x00000003U);
+
+
+	Xil_Out32(0xFD080004, 0x00060001); /*PUB_PIR*/
+	regval = Xil_In32(0xFD080030); /*PUB_PGSR0*/
+	while ((regval & 0x80004001) != 0x80004001) {
+	/*PUB_PGSR0*/
+		regval = Xil_In32(0xFD080030);
+	}
+
+	prog_reg(0xFD08001CU, 0x00000018U, 0x00000003U, 0x00000000U);
+	prog_reg(0xFD08142CU, 0x00000030U, 0x00000004U, 0x00000000U);
+	prog_reg(0xFD08146CU, 0x00000030U, 0x00000004U, 0x00000000U);
+	prog_reg(0xFD0814ACU, 0x00000030U, 0x00000004U, 0x00000000U);
+	prog_reg(0xFD0814ECU, 0x00000030U, 0x00000004U, 0x00000000U);
+	prog_reg(0xFD08152CU, 0x00000030U, 0x00000004U, 0x00000000U);
+/*Vref training is complete, disabling static read mode*/
+	Xil_Out32(0xFD080200U, 0x800091C7U);
+	Xil_Out32(0xFD080018U, 0x00F0D9C7U);
+
+
+	Xil_Out32(0xFD080004, 0x0000C001); /*PUB_PIR*/
+	regval = Xil_In32(0xFD080030); /*PUB_PGSR0*/
+	while ((regval & 0x80000C01) != 0x80000C01) {
+	/*PUB_PGSR0*/
+		regval = Xil_In32(0xFD080030);
+	}
+
+	Xil_Out32(0xFD070180U, 0x01000040U);
+	Xil_Out32(0xFD070060U, 0x00000000U);
+	prog_reg(0xFD080014U, 0x00000040U, 0x00000006U, 0x00000000U);
+
+return 1;
+}
+
+/**
+ * CRL_APB Base Address
+ */
+#define CRL_APB_BASEADDR      0XFF5E0000U
+#define CRL_APB_RST_LPD_IOU0    ((CRL_APB_BASEADDR) + 0X00000230U)
+#define CRL_APB_RST_LPD_IOU1    ((CRL_APB_BASEADDR) + 0X00000234U)
+#define CRL_APB_RST_LPD_IOU2    ((CRL_APB_BASEADDR) + 0X00000238U)
+#define CRL_APB_RST_LPD_TOP    ((CRL_APB_BASEADDR) + 0X0000023CU)
+#define CRL_APB_IOU_SWITCH_CTRL    ((CRL_APB_BASEADDR) + 0X0000009CU)
+
+/**
+ * CRF_APB Base Address
+ */
+#define CRF_APB_BASEADDR      0XFD1A0000U
+
+#define CRF_APB_RST_FPD_TOP    ((CRF_APB_BASEADDR) + 0X00000100U)
+#define CRF_APB_GPU_REF_CTRL    ((CRF_APB_BASEADDR) + 0X00000084U)
+#define CRF_APB_RST_DDR_SS    ((CRF_APB_BASEADDR) + 0X00000108U)
+#define PSU_MASK_POLL_TIME 1100000
+
+/**
+ *  * Register: CRF_APB_DPLL_CTRL
+ */
+#define CRF_APB_DPLL_CTRL    ((CRF_APB_BASEADDR) + 0X0000002C)
+
+
+#define CRF_APB_DPLL_CTRL_DIV2_SHIFT   16
+#define CRF_APB_DPLL_CTRL_DIV2_WIDTH   1
+
+#define CRF_APB_DPLL_CTRL_FBDIV_SHIFT   8
+#define CRF_APB_DPLL_CTRL_FBDIV_WIDTH   7
+
+#define CRF_APB_DPLL_CTRL_BYPASS_SHIFT   3
+#define CRF_APB_DPLL_CTRL_BYPASS_WIDTH   1
+
+#define CRF_APB_DPLL_CTRL_RESET_SHIFT   0
+#define CRF_APB_DPLL_CTRL_RESET_WIDTH   1
+
+/**
+ *  * Register: CRF_APB_DPLL_CFG
+ */
+#define CRF_APB_DPLL_CFG    ((CRF_APB_BASEADDR) + 0X00000030)
+
+#define CRF_APB_DPLL_CFG_LOCK_DLY_SHIFT   25
+#define CRF_APB_DPLL_CFG_LOCK_DLY_WIDTH   7
+
+#define CRF_APB_DPLL_CFG_LOCK_CNT_SHIFT   13
+#define CRF_APB_DPLL_CFG_LOCK_CNT_WIDTH   10
+
+#define CRF_APB_DPLL_CFG_LFHF_SHIFT   10
+#define CRF_APB_DPLL_CFG_LFHF_WIDTH   2
+
+#define CRF_APB_DPLL_CFG_CP_SHIFT   5
+#define CRF_APB_DPLL_CFG_CP_WIDTH   4
+
+#define CRF_APB_DPLL_CFG_RES_SHIFT   0
+#define CRF_APB_DPLL_CFG_RES_WIDTH   4
+
+/**
+ * Register: CRF_APB_PLL_STATUS
+ */
+#define CRF_APB_PLL_STATUS    ((CRF_APB_BASEADDR) + 0X00000044)
+
+
+static int mask_pollOnValue(u32 add, u32 mask, u32 value)
+{
+	volatile u32 *addr = (volatile u32 *)(unsigned long) add;
+	int i = 0;
+
+	while ((*addr & mask) != value) {
+		if (i == PSU_MASK_POLL_TIME)
+			return 0;
+		i++;
+	}
+	return 1;
+}
+
+static void mask_delay(u32 delay)
+{
+	usleep(delay);
+}
+
+static u32 mask_read(u32 add, u32 mask)
+{
+	volatile u32 *addr = (volatile u32 *)(unsigned long) add;
+	u32 val = (*addr & mask);
+	return val;
+}
+
+/*
+ * dpll_prog() with its read-modify-writes merged by psu_init_gen.  The
+ * divider and loop filter settings only take effect through the reset,
+ * so they go out as one write per register; bypass and reset keep their
+ * own writes, in order.
+ */
+static void dpll_prog(int ddr_pll_fbdiv, int d_lock_dly, int d_lock_cnt,
+	int d_lfhf, int d_cp, int d_res) {
+
+	unsigned int pll_status_regval;
+
+	PSU_Mask_Write(CRF_APB_DPLL_CFG, CRF_APB_DPLL_CFG_LOCK_DLY_MASK |
+		CRF_APB_DPLL_CFG_LOCK_CNT_MASK | CRF_APB_DPLL_CFG_LFHF_MASK |
+		CRF_APB_DPLL_CFG_CP_MASK | CRF_APB_DPLL_CFG_RES_MASK,
+		(d_lock_dly << CRF_APB_DPLL_CFG_LOCK_DLY_SHIFT) |
+		(d_lock_cnt << CRF_APB_DPLL_CFG_LOCK_CNT_SHIFT) |
+		(d_lfhf << CRF_APB_DPLL_CFG_LFHF_SHIFT) |
+		(d_cp << CRF_APB_DPLL_CFG_CP_SHIFT) |
+		(d_res << CRF_APB_DPLL_CFG_RES_SHIFT));
+	PSU_Mask_Write(CRF_APB_DPLL_CTRL,
+		CRF_APB_DPLL_CTRL_DIV2_MASK | CRF_APB_DPLL_CTRL_FBDIV_MASK,
+		(1 << CRF_APB_DPLL_CTRL_DIV2_SHIFT) |
+		(ddr_pll_fbdiv << CRF_APB_DPLL_CTRL_FBDIV_SHIFT));
+
+	/*Setting PLL BYPASS*/
+	PSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_BYPASS_MASK,
+		CRF_APB_DPLL_CTRL_BYPASS_MASK);
+	/*Setting PLL RESET*/
+	PSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_RESET_MASK,
+		CRF_APB_DPLL_CTRL_RESET_MASK);
+	/*Clearing PLL RESET*/
+	PSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_RESET_MASK, 0);
+
+	/*Checking PLL lock*/
+	pll_status_regval = 0x00000000;
+	while ((pll_status_regval & CRF_APB_PLL_STATUS_DPLL_LOCK_MASK) !=
+		CRF_APB_PLL_STATUS_DPLL_LOCK_MASK)
+		pll_status_regval = Xil_In32(CRF_APB_PLL_STATUS);
+
+	/*Clearing PLL BYPASS*/
+	PSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_BYPASS_MASK, 0);
+}
+
+
+
+static void init_peripheral(void)
+{
+/*SMMU_REG Interrrupt Enable: Followig register need to be written all the time to properly catch SMMU messages.*/
+	PSU_Mask_Write(0xFD5F0018, 0x8000001FU, 0x8000001FU);
+}
+
+static int psu_init_xppu_aper_ram(void)
+{
+
+	return 0;
+}
+
+int psu_lpd_protection(void)
+{
+	psu_init_xppu_aper_ram();
+	return 0;
+}
+
+int psu_ddr_protection(void)
+{
+	psu_ddr_xmpu0_data();
+	psu_ddr_xmpu1_data();
+	psu_ddr_xmpu2_data();
+	psu_ddr_xmpu3_data();
+	psu_ddr_xmpu4_data();
+	psu_ddr_xmpu5_data();
+	return 0;
+}
+int psu_ocm_protection(void)
+{
+	psu_ocm_xmpu_data();
+	return 0;
+}
+
+int psu_fpd_protection(void)
+{
+	psu_fpd_xmpu_data();
+	return 0;
+}
+
+int psu_protection_lock(void)
+{
+	psu_protection_lock_data();
+	return 0;
+}
+
+int psu_protection(void)
+{
+	psu_apply_master_tz();
+	psu_ddr_protection();
+	psu_ocm_protection();
+	psu_fpd_protection();
+	psu_lpd_protection();
+	return 0;
+}
+
+int
+psu_init(void)
+{
+	int status = 1;
+
+	status &= psu_mio_init_data();
+	status &=  psu_peripherals_pre_init_data();
+	status &=   psu_pll_init_data();
+	status &=   psu_clock_init_data();
+	status &=  psu_ddr_init_data();
+	status &=  psu_ddr_phybringup_data();
+	status &=  psu_peripherals_init_data();
+	init_peripheral();
+
+	status &=  psu_peripherals_powerdwn_data();
+	status &=    psu_afi_config();
+	psu_ddr_qos_init_data();
+
+	if (status == 0)
+		return 1;
+	return 0;
+}
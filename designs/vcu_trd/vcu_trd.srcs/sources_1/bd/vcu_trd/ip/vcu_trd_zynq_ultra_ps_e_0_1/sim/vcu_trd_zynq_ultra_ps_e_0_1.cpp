@@ -53,10 +53,20 @@
 #include <map>
 #include <string>
 
-vcu_trd_zynq_ultra_ps_e_0_1::vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& nm) : sc_module(nm), mp_impl(NULL)
+int vcu_trd_zynq_ultra_ps_e_0_1::s_num_instances = 0;
+
+vcu_trd_zynq_ultra_ps_e_0_1::vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& nm) : vcu_trd_zynq_ultra_ps_e_0_1(nm, xsc::common::properties())
+{
+}
+
+vcu_trd_zynq_ultra_ps_e_0_1::vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& nm, const xsc::common::properties& instance_props) : sc_module(nm), mp_impl(NULL), m_instance_props(instance_props)
 {
   // configure connectivity manager
-  xsc::utils::xsc_sim_manager::addInstance("vcu_trd_zynq_ultra_ps_e_0_1", this);
+  // The first instance keeps the IP name; further instances register by
+  // hierarchical name.  get_tlm_mode() reads Vivado's settings by IP name.
+  m_instance_key = (s_num_instances == 0) ? std::string("vcu_trd_zynq_ultra_ps_e_0_1") : std::string(name());
+  s_num_instances++;
+  xsc::utils::xsc_sim_manager::addInstance(m_instance_key, this);
 
   // initialize module
   xsc::common::properties model_param_props;
@@ -97,6 +107,12 @@ vcu_trd_zynq_ultra_ps_e_0_1::vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& n
   model_param_props._string_property_map["C_PL_CLK1_BUF"] = "FALSE";
   model_param_props._string_property_map["C_PL_CLK2_BUF"] = "FALSE";
   model_param_props._string_property_map["C_PL_CLK3_BUF"] = "FALSE";
+
+  // instance-scoped parameters (e.g. COSIM_MACHINE_TCPIP_ADDRESS) override the IP defaults
+  for (std::map<std::string, long long>::const_iterator it = m_instance_props._long_property_map.begin(); it != m_instance_props._long_property_map.end(); ++it)
+    model_param_props._long_property_map[it->first] = it->second;
+  for (std::map<std::string, std::string>::const_iterator it = m_instance_props._string_property_map.begin(); it != m_instance_props._string_property_map.end(); ++it)
+    model_param_props._string_property_map[it->first] = it->second;
   mp_impl = new zynq_ultra_ps_e_tlm("inst", model_param_props);
 
   // initialize sockets
@@ -143,42 +159,67 @@ vcu_trd_zynq_ultra_ps_e_0_1::vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& n
   mp_saxigp5_awuser_converter = NULL;
 }
 
+int vcu_trd_zynq_ultra_ps_e_0_1::get_tlm_mode(const char* port_param)
+{
+  std::map<std::string, long long>::const_iterator it = m_instance_props._long_property_map.find(port_param);
+  if (it != m_instance_props._long_property_map.end())
+    return (int)it->second;
+  // Vivado sets *_TLM_MODE on the IP, so it applies to every instance
+  return xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", port_param);
+}
+
+// registers a port's FREQ_HZ and CLK_DOMAIN from its transactor properties, in TLM and pin mode alike,
+// with the clock domains of this instance's scope (the parent module), so PS instances side by side
+// each get their own domains
+void vcu_trd_zynq_ultra_ps_e_0_1::set_clock_domain(const char* port, const xsc::common::properties& props)
+{
+  std::string key = std::string(name()) + "." + port;
+  sc_core::sc_object* parent = get_parent_object();
+  std::map<std::string, long long>::const_iterator freq = props._long_property_map.find("FREQ_HZ");
+  std::map<std::string, std::string>::const_iterator domain = props._string_property_map.find("CLK_DOMAIN");
+  if (freq == props._long_property_map.end() || domain == props._string_property_map.end())
+    return;
+  clock_domains& domains = clock_domains::instance(parent ? parent->name() : "");
+  mp_impl->set_clock_domain(port, domains.add(key, domain->second, (double)freq->second));
+}
+
 void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
 {
   // configure 'M_AXI_HPM0_LPD' transactor
-  if (xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", "M_AXI_HPM0_LPD_TLM_MODE") != 1)
+  xsc::common::properties M_AXI_HPM0_LPD_transactor_param_props;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 32;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["FREQ_HZ"] = 99999000;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["ID_WIDTH"] = 16;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 40;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 16;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 16;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 1;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 4;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 4;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
+  M_AXI_HPM0_LPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
+  M_AXI_HPM0_LPD_transactor_param_props._float_property_map["PHASE"] = 0.000;
+  M_AXI_HPM0_LPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "8";
+  M_AXI_HPM0_LPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "8";
+  M_AXI_HPM0_LPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
+  M_AXI_HPM0_LPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
+  M_AXI_HPM0_LPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "vcu_trd_zynq_ultra_ps_e_0_1_pl_clk0";
+  set_clock_domain("M_AXI_HPM0_LPD", M_AXI_HPM0_LPD_transactor_param_props);
+  if (get_tlm_mode("M_AXI_HPM0_LPD_TLM_MODE") != 1)
   {
-    xsc::common::properties M_AXI_HPM0_LPD_transactor_param_props;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 32;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["FREQ_HZ"] = 99999000;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["ID_WIDTH"] = 16;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 40;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 16;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 16;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 1;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 4;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 4;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
-    M_AXI_HPM0_LPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
-    M_AXI_HPM0_LPD_transactor_param_props._float_property_map["PHASE"] = 0.000;
-    M_AXI_HPM0_LPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "8";
-    M_AXI_HPM0_LPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "8";
-    M_AXI_HPM0_LPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
-    M_AXI_HPM0_LPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
-    M_AXI_HPM0_LPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "vcu_trd_zynq_ultra_ps_e_0_1_pl_clk0";
     mp_M_AXI_HPM0_LPD_transactor = new xtlm::xaximm_xtlm2pin_t<32,40,16,16,1,1,16,1>("M_AXI_HPM0_LPD_transactor", M_AXI_HPM0_LPD_transactor_param_props);
     mp_M_AXI_HPM0_LPD_transactor->ARADDR(maxigp2_araddr);
     mp_M_AXI_HPM0_LPD_transactor->ARBURST(maxigp2_arburst);
@@ -227,39 +268,40 @@ void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
     mp_impl->M_AXI_HPM0_LPD_rd_socket->bind(*(mp_M_AXI_HPM0_LPD_transactor->rd_socket));
   }
   // configure 'S_AXI_HPC0_FPD' transactor
-  if (xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", "S_AXI_HPC0_FPD_TLM_MODE") != 1)
+  xsc::common::properties S_AXI_HPC0_FPD_transactor_param_props;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 32;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HPC0_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HPC0_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
+  S_AXI_HPC0_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
+  S_AXI_HPC0_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
+  S_AXI_HPC0_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
+  S_AXI_HPC0_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
+  S_AXI_HPC0_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
+  set_clock_domain("S_AXI_HPC0_FPD", S_AXI_HPC0_FPD_transactor_param_props);
+  if (get_tlm_mode("S_AXI_HPC0_FPD_TLM_MODE") != 1)
   {
-    xsc::common::properties S_AXI_HPC0_FPD_transactor_param_props;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 32;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HPC0_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HPC0_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
-    S_AXI_HPC0_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
-    S_AXI_HPC0_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
-    S_AXI_HPC0_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
-    S_AXI_HPC0_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
-    S_AXI_HPC0_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
     mp_S_AXI_HPC0_FPD_transactor = new xtlm::xaximm_pin2xtlm_t<32,49,6,1,1,1,1,1>("S_AXI_HPC0_FPD_transactor", S_AXI_HPC0_FPD_transactor_param_props);
     mp_S_AXI_HPC0_FPD_transactor->ARADDR(saxigp0_araddr);
     mp_S_AXI_HPC0_FPD_transactor->ARBURST(saxigp0_arburst);
@@ -312,39 +354,40 @@ void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
     mp_impl->S_AXI_HPC0_FPD_rd_socket->bind(*(mp_S_AXI_HPC0_FPD_transactor->rd_socket));
   }
   // configure 'S_AXI_HP0_FPD' transactor
-  if (xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", "S_AXI_HP0_FPD_TLM_MODE") != 1)
+  xsc::common::properties S_AXI_HP0_FPD_transactor_param_props;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP0_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
+  S_AXI_HP0_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
+  S_AXI_HP0_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
+  S_AXI_HP0_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
+  S_AXI_HP0_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
+  S_AXI_HP0_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
+  set_clock_domain("S_AXI_HP0_FPD", S_AXI_HP0_FPD_transactor_param_props);
+  if (get_tlm_mode("S_AXI_HP0_FPD_TLM_MODE") != 1)
   {
-    xsc::common::properties S_AXI_HP0_FPD_transactor_param_props;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP0_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
-    S_AXI_HP0_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
-    S_AXI_HP0_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
-    S_AXI_HP0_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
-    S_AXI_HP0_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
-    S_AXI_HP0_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
     mp_S_AXI_HP0_FPD_transactor = new xtlm::xaximm_pin2xtlm_t<128,49,6,1,1,1,1,1>("S_AXI_HP0_FPD_transactor", S_AXI_HP0_FPD_transactor_param_props);
     mp_S_AXI_HP0_FPD_transactor->ARADDR(saxigp2_araddr);
     mp_S_AXI_HP0_FPD_transactor->ARBURST(saxigp2_arburst);
@@ -397,39 +440,40 @@ void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
     mp_impl->S_AXI_HP0_FPD_rd_socket->bind(*(mp_S_AXI_HP0_FPD_transactor->rd_socket));
   }
   // configure 'S_AXI_HP1_FPD' transactor
-  if (xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", "S_AXI_HP1_FPD_TLM_MODE") != 1)
+  xsc::common::properties S_AXI_HP1_FPD_transactor_param_props;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP1_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
+  S_AXI_HP1_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
+  S_AXI_HP1_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
+  S_AXI_HP1_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
+  S_AXI_HP1_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
+  S_AXI_HP1_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
+  set_clock_domain("S_AXI_HP1_FPD", S_AXI_HP1_FPD_transactor_param_props);
+  if (get_tlm_mode("S_AXI_HP1_FPD_TLM_MODE") != 1)
   {
-    xsc::common::properties S_AXI_HP1_FPD_transactor_param_props;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP1_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
-    S_AXI_HP1_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
-    S_AXI_HP1_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
-    S_AXI_HP1_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
-    S_AXI_HP1_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
-    S_AXI_HP1_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
     mp_S_AXI_HP1_FPD_transactor = new xtlm::xaximm_pin2xtlm_t<128,49,6,1,1,1,1,1>("S_AXI_HP1_FPD_transactor", S_AXI_HP1_FPD_transactor_param_props);
     mp_S_AXI_HP1_FPD_transactor->ARADDR(saxigp3_araddr);
     mp_S_AXI_HP1_FPD_transactor->ARBURST(saxigp3_arburst);
@@ -482,39 +526,40 @@ void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
     mp_impl->S_AXI_HP1_FPD_rd_socket->bind(*(mp_S_AXI_HP1_FPD_transactor->rd_socket));
   }
   // configure 'S_AXI_HP2_FPD' transactor
-  if (xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", "S_AXI_HP2_FPD_TLM_MODE") != 1)
+  xsc::common::properties S_AXI_HP2_FPD_transactor_param_props;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP2_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
+  S_AXI_HP2_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
+  S_AXI_HP2_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
+  S_AXI_HP2_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
+  S_AXI_HP2_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
+  S_AXI_HP2_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
+  set_clock_domain("S_AXI_HP2_FPD", S_AXI_HP2_FPD_transactor_param_props);
+  if (get_tlm_mode("S_AXI_HP2_FPD_TLM_MODE") != 1)
   {
-    xsc::common::properties S_AXI_HP2_FPD_transactor_param_props;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP2_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
-    S_AXI_HP2_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
-    S_AXI_HP2_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
-    S_AXI_HP2_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
-    S_AXI_HP2_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
-    S_AXI_HP2_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
     mp_S_AXI_HP2_FPD_transactor = new xtlm::xaximm_pin2xtlm_t<128,49,6,1,1,1,1,1>("S_AXI_HP2_FPD_transactor", S_AXI_HP2_FPD_transactor_param_props);
     mp_S_AXI_HP2_FPD_transactor->ARADDR(saxigp4_araddr);
     mp_S_AXI_HP2_FPD_transactor->ARBURST(saxigp4_arburst);
@@ -567,39 +612,40 @@ void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
     mp_impl->S_AXI_HP2_FPD_rd_socket->bind(*(mp_S_AXI_HP2_FPD_transactor->rd_socket));
   }
   // configure 'S_AXI_HP3_FPD' transactor
-  if (xsc::utils::xsc_sim_manager::getInstanceParameterInt("vcu_trd_zynq_ultra_ps_e_0_1", "S_AXI_HP3_FPD_TLM_MODE") != 1)
+  xsc::common::properties S_AXI_HP3_FPD_transactor_param_props;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
+  S_AXI_HP3_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
+  S_AXI_HP3_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
+  S_AXI_HP3_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
+  S_AXI_HP3_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
+  S_AXI_HP3_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
+  S_AXI_HP3_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
+  set_clock_domain("S_AXI_HP3_FPD", S_AXI_HP3_FPD_transactor_param_props);
+  if (get_tlm_mode("S_AXI_HP3_FPD_TLM_MODE") != 1)
   {
-    xsc::common::properties S_AXI_HP3_FPD_transactor_param_props;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["DATA_WIDTH"] = 128;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["FREQ_HZ"] = 166838609;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["ID_WIDTH"] = 6;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["ADDR_WIDTH"] = 49;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["AWUSER_WIDTH"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["ARUSER_WIDTH"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["WUSER_WIDTH"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["RUSER_WIDTH"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["BUSER_WIDTH"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_BURST"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_LOCK"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_PROT"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_CACHE"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_QOS"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_REGION"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_WSTRB"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_BRESP"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["HAS_RRESP"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["SUPPORTS_NARROW_BURST"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["MAX_BURST_LENGTH"] = 256;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["NUM_READ_THREADS"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["NUM_WRITE_THREADS"] = 1;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["RUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._long_property_map["WUSER_BITS_PER_BYTE"] = 0;
-    S_AXI_HP3_FPD_transactor_param_props._float_property_map["PHASE"] = 0.0;
-    S_AXI_HP3_FPD_transactor_param_props._string_property_map["NUM_WRITE_OUTSTANDING"] = "16";
-    S_AXI_HP3_FPD_transactor_param_props._string_property_map["NUM_READ_OUTSTANDING"] = "16";
-    S_AXI_HP3_FPD_transactor_param_props._string_property_map["PROTOCOL"] = "AXI4";
-    S_AXI_HP3_FPD_transactor_param_props._string_property_map["READ_WRITE_MODE"] = "READ_WRITE";
-    S_AXI_HP3_FPD_transactor_param_props._string_property_map["CLK_DOMAIN"] = "/vcu_clk_wiz0_clk_out1";
     mp_S_AXI_HP3_FPD_transactor = new xtlm::xaximm_pin2xtlm_t<128,49,6,1,1,1,1,1>("S_AXI_HP3_FPD_transactor", S_AXI_HP3_FPD_transactor_param_props);
     mp_S_AXI_HP3_FPD_transactor->ARADDR(saxigp5_araddr);
     mp_S_AXI_HP3_FPD_transactor->ARBURST(saxigp5_arburst);
@@ -655,7 +701,9 @@ void vcu_trd_zynq_ultra_ps_e_0_1::before_end_of_elaboration()
 
 vcu_trd_zynq_ultra_ps_e_0_1::~vcu_trd_zynq_ultra_ps_e_0_1()
 {
-  xsc::utils::xsc_sim_manager::clean();
+  // the connectivity manager is shared by all instances in the process
+  if (--s_num_instances == 0)
+    xsc::utils::xsc_sim_manager::clean();
 
   delete mp_impl;
   delete mp_M_AXI_HPM0_LPD_transactor;
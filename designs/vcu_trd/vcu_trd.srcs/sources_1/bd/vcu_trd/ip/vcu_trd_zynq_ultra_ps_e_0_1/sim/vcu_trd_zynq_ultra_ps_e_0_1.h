@@ -64,6 +64,7 @@ class vcu_trd_zynq_ultra_ps_e_0_1 : public sc_module
 public:
 
   vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& nm);
+  vcu_trd_zynq_ultra_ps_e_0_1(const sc_module_name& nm, const xsc::common::properties& instance_props);
   virtual ~vcu_trd_zynq_ultra_ps_e_0_1();
 
 public: // module pin-to-pin RTL interface
@@ -336,8 +337,18 @@ private:
   vcu_trd_zynq_ultra_ps_e_0_1(const vcu_trd_zynq_ultra_ps_e_0_1&);
   const vcu_trd_zynq_ultra_ps_e_0_1& operator=(const vcu_trd_zynq_ultra_ps_e_0_1&);
 
+  int get_tlm_mode(const char* port_param);
+  void set_clock_domain(const char* port, const xsc::common::properties& props);
+
   zynq_ultra_ps_e_tlm* mp_impl;
 
+  // key this instance is registered under with xsc_sim_manager
+  std::string m_instance_key;
+  // parameters scoped to this instance, take precedence over xsc_sim_manager
+  xsc::common::properties m_instance_props;
+  // number of live instances in this process
+  static int s_num_instances;
+
   xtlm::xaximm_xtlm2pin_t<32,40,16,16,1,1,16,1>* mp_M_AXI_HPM0_LPD_transactor;
   sc_signal< bool > m_M_AXI_HPM0_LPD_transactor_rst_signal;
 
@@ -0,0 +1,107 @@
+/*
+ * Adaptive quantum for PL to PS transactions.
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include <sstream>
+
+#include "boundary_quantum.h"
+#include "sc_profiler.h"
+#include "trace_writer.h"
+
+using namespace sc_core;
+using namespace std;
+
+boundary_quantum::boundary_quantum(sc_module_name name,
+				   const sc_time &min, const sc_time &max,
+				   unsigned int busy_threshold)
+	: sc_module(name),
+	  quantum_min(min),
+	  quantum_max(max),
+	  busy_threshold(busy_threshold),
+	  activity(0)
+{
+	sc_time q = tlm::tlm_global_quantum::instance().get();
+
+	qk.quantum = &quantum;
+
+	if (quantum_max < quantum_min)
+		quantum_max = quantum_min;
+
+	/* Start from the global quantum, clamped to the bounds.  */
+	if (q < quantum_min)
+		q = quantum_min;
+	if (q > quantum_max)
+		q = quantum_max;
+	set_quantum(q);
+
+	SC_THREAD(run);
+}
+
+void boundary_quantum::set_quantum(const sc_time &q)
+{
+	ostringstream msg;
+
+	quantum = q;
+	if (trace_writer::enabled) {
+		trace_writer::instance().counter("pl_quantum_ns",
+			sc_time_stamp(), (uint64_t) (q.to_seconds() * 1e9));
+	}
+
+	msg << "PL quantum " << q << " (" << activity
+	    << " boundary events in last window)";
+	SC_REPORT_INFO(name(), msg.str().c_str());
+}
+
+void boundary_quantum::run(void)
+{
+	while (true) {
+		sc_time q = quantum;
+		sc_time nq = q;
+
+		activity = 0;
+		wait(q);
+
+		SC_PROFILE_SCOPE("adjust");
+		if (activity == 0) {
+			nq = q * 2;
+			if (nq > quantum_max)
+				nq = quantum_max;
+		} else if (activity >= busy_threshold) {
+			nq = q / 2;
+			if (nq < quantum_min)
+				nq = quantum_min;
+		}
+
+		if (nq != q)
+			set_quantum(nq);
+	}
+}
+
+void boundary_quantum::sync(sc_time &delay)
+{
+	activity++;
+	qk.set(delay);
+	if (qk.need_sync()) {
+		qk.sync();
+		delay = SC_ZERO_TIME;
+	}
+}
+
+void boundary_quantum::before_end_of_elaboration(void)
+{
+	sc_spawn_options opts;
+	unsigned int i;
+
+	if (watched.empty())
+		return;
+
+	opts.spawn_method();
+	opts.dont_initialize();
+	for (i = 0; i < watched.size(); i++) {
+		opts.set_sensitivity(watched[i]);
+	}
+	sc_spawn(sc_bind(&boundary_quantum::note_activity, this),
+		 "watch", &opts);
+}
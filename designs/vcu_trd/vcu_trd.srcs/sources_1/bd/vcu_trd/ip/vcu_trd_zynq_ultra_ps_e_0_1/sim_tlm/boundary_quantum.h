@@ -0,0 +1,88 @@
+/*
+ * Adaptive quantum for PL to PS transactions.
+ *
+ * A PL master running loosely timed runs ahead of SystemC time by up to
+ * a quantum before its transactions into the PS wait the lag off.  With
+ * no PL traffic (e.g. while Linux boots) a long quantum costs nothing,
+ * while a busy PL (4K decode) needs a short one to keep latencies
+ * credible.
+ *
+ * The policy counts AXI transactions in both directions (PL to PS and PS
+ * to PL) and IRQ edges crossing the PS/PL boundary.  At the end of every
+ * quantum it doubles the quantum if the window was idle and halves it if
+ * the window saw at least busy_threshold events, within the user-set
+ * min/max bounds.
+ *
+ * Only PL to PS transactions are held against it, through the policy's
+ * own quantum keeper, so several PS instances in one process each keep
+ * their own quantum and tlm_global_quantum is left alone.  It does not
+ * change how often remote-port synchronizes with QEMU: that interval is
+ * QEMU's sync-quantum, set on the QEMU side.
+ *
+ * While tracing, the quantum is recorded as a counter, see
+ * trace_writer.h.
+ */
+
+#ifndef BOUNDARY_QUANTUM_H__
+#define BOUNDARY_QUANTUM_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/tlm_quantumkeeper.h"
+
+class boundary_quantum
+: public sc_core::sc_module
+{
+private:
+	/* A quantum keeper using the policy's quantum.  */
+	class keeper
+	: public tlm_utils::tlm_quantumkeeper
+	{
+	public:
+		const sc_core::sc_time *quantum;
+	protected:
+		sc_core::sc_time compute_local_quantum(void)
+		{
+			return *quantum;
+		}
+	};
+
+	sc_core::sc_time quantum;
+	sc_core::sc_time quantum_min;
+	sc_core::sc_time quantum_max;
+	unsigned int busy_threshold;
+	unsigned int activity;
+	keeper qk;
+	std::vector<const sc_core::sc_event *> watched;
+
+	void run(void);
+	void set_quantum(const sc_core::sc_time &q);
+public:
+	SC_HAS_PROCESS(boundary_quantum);
+	boundary_quantum(sc_core::sc_module_name name,
+			 const sc_core::sc_time &min,
+			 const sc_core::sc_time &max,
+			 unsigned int busy_threshold = 8);
+
+	/* Called for every transaction or IRQ edge crossing the boundary.  */
+	void note_activity(void) { activity++; }
+
+	/*
+	 * A PL to PS transaction with the initiator's annotated delay.
+	 * Counts it and, once the quantum is used up, waits the delay off
+	 * and zeroes it.  Call from a thread (b_transport).
+	 */
+	void sync(sc_core::sc_time &delay);
+
+	/* Count every notification of ev (e.g. an IRQ wire's value change). */
+	void watch(const sc_core::sc_event &ev) { watched.push_back(&ev); }
+
+	const sc_core::sc_time &get_quantum(void) const { return quantum; }
+
+	void before_end_of_elaboration(void);
+};
+
+#endif
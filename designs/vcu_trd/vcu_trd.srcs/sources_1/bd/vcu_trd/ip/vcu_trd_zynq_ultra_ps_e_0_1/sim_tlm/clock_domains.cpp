@@ -0,0 +1,181 @@
+/*
+ * Clock domain registry and beat timing for the PS AXI ports.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+
+#include <iostream>
+#include <sstream>
+
+#include "clock_domains.h"
+
+using namespace sc_core;
+using namespace std;
+
+bool clock_domains::enabled = getenv("COSIM_BEAT_TIMING") != NULL;
+
+clock_domains &clock_domains::instance(const string &scope)
+{
+	static map<string, clock_domains *> scopes;
+	clock_domains *&d = scopes[scope];
+
+	if (!d)
+		d = new clock_domains();
+	return *d;
+}
+
+clock_domain *clock_domains::add(const string &port, const string &domain,
+				 double freq_hz)
+{
+	map<string, clock_domain>::iterator it = domains.find(domain);
+	clock_domain *d;
+
+	if (it == domains.end()) {
+		d = &domains[domain];
+		d->name = domain;
+		d->freq_hz = freq_hz;
+		d->period = sc_time(1.0 / freq_hz, SC_SEC);
+	} else {
+		d = &it->second;
+		/* FREQ_HZ is rounded to the Hz, computed rates are not.  */
+		if (fabs(d->freq_hz - freq_hz) > d->freq_hz * 1e-6) {
+			ostringstream msg;
+
+			msg << port << " has FREQ_HZ " << freq_hz << ", "
+			    << domain << " runs at " << d->freq_hz;
+			SC_REPORT_WARNING("clock_domains", msg.str().c_str());
+		}
+	}
+	d->ports.push_back(port);
+	return d;
+}
+
+clock_domain *clock_domains::find(const string &domain)
+{
+	map<string, clock_domain>::iterator it = domains.find(domain);
+
+	return it == domains.end() ? NULL : &it->second;
+}
+
+bool clock_domains::set_freq(const string &domain, double freq_hz)
+{
+	clock_domain *d = find(domain);
+
+	if (!d || freq_hz <= 0)
+		return false;
+	d->freq_hz = freq_hz;
+	d->period = sc_time(1.0 / freq_hz, SC_SEC);
+	return true;
+}
+
+beat_timing::beat_timing(sc_module_name name, unsigned int data_width)
+	: sc_module(name),
+	  beat_bytes(data_width / 8),
+	  domain(NULL),
+	  transactions(0),
+	  beats(0),
+	  bytes(0),
+	  target_socket("target_socket"),
+	  initiator_socket("initiator_socket")
+{
+	target_socket.register_b_transport(this, &beat_timing::b_transport);
+	target_socket.register_transport_dbg(this,
+				&beat_timing::transport_dbg);
+	target_socket.register_get_direct_mem_ptr(this,
+				&beat_timing::get_direct_mem_ptr);
+	initiator_socket.register_invalidate_direct_mem_ptr(this,
+				&beat_timing::invalidate_direct_mem_ptr);
+}
+
+void beat_timing::set_domain(const clock_domain *d)
+{
+	domain = d;
+}
+
+/*
+ * Occupies a data channel with n beats starting no earlier than at.
+ * Returns how much later than at the last beat is done.
+ */
+static sc_time occupy(sc_time &free, const sc_time &at, uint64_t n,
+		      const sc_time &period, sc_time &busy, sc_time &stalled)
+{
+	sc_time start = at > free ? at : free;
+	sc_time t = period * (double) n;
+
+	free = start + t;
+	busy += t;
+	stalled += start - at;
+	return free - at;
+}
+
+void beat_timing::b_transport(tlm::tlm_generic_payload &trans,
+			      sc_time &delay)
+{
+	unsigned int len = trans.get_data_length();
+	uint64_t n;
+
+	if (!domain) {
+		initiator_socket->b_transport(trans, delay);
+		return;
+	}
+
+	n = len ? (len + beat_bytes - 1) / beat_bytes : 1;
+	transactions++;
+	beats += n;
+	bytes += len;
+
+	/* Write data goes out before the target sees it, read data after.  */
+	if (trans.is_write()) {
+		delay += occupy(wr_free, sc_time_stamp() + delay, n,
+				domain->period, wr_busy, stalled);
+		initiator_socket->b_transport(trans, delay);
+	} else {
+		initiator_socket->b_transport(trans, delay);
+		delay += occupy(rd_free, sc_time_stamp() + delay, n,
+				domain->period, rd_busy, stalled);
+	}
+}
+
+unsigned int beat_timing::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return initiator_socket->transport_dbg(trans);
+}
+
+bool beat_timing::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				     tlm::tlm_dmi &dmi)
+{
+	bool ok = initiator_socket->get_direct_mem_ptr(trans, dmi);
+
+	if (ok && domain) {
+		dmi.set_read_latency(dmi.get_read_latency() + domain->period);
+		dmi.set_write_latency(dmi.get_write_latency()
+				      + domain->period);
+	}
+	return ok;
+}
+
+void beat_timing::invalidate_direct_mem_ptr(sc_dt::uint64 start,
+					    sc_dt::uint64 end)
+{
+	target_socket->invalidate_direct_mem_ptr(start, end);
+}
+
+void beat_timing::end_of_simulation(void)
+{
+	sc_time now = sc_time_stamp();
+
+	if (!domain)
+		return;
+
+	cout << name() << ": " << domain->name << " at "
+	     << domain->freq_hz / 1e6 << " MHz, " << transactions
+	     << " transactions, " << beats << " beats, " << bytes
+	     << " bytes\n";
+	if (now > SC_ZERO_TIME) {
+		cout << "  R busy " << 100.0 * (rd_busy / now) << "%, W busy "
+		     << 100.0 * (wr_busy / now) << "%, "
+		     << (double) bytes / now.to_seconds() / 1e6 << " MB/s, "
+		     << "stalled " << stalled << "\n";
+	}
+}
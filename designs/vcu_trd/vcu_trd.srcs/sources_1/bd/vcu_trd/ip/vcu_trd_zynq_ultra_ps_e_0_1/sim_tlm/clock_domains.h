@@ -0,0 +1,113 @@
+/*
+ * Clock domain registry and beat timing for the PS AXI ports.
+ *
+ * The Vivado wrapper knows every AXI port's FREQ_HZ and CLK_DOMAIN, but
+ * only hands them to the pin level transactors.  It now registers each
+ * port with clock_domains as well, and ports sharing a CLK_DOMAIN share
+ * one clock_domain, so a frequency change (e.g. reprogramming a clocking
+ * wizard) is seen by all of them.
+ *
+ * Domains are kept per scope.  The wrapper registers its ports in the
+ * scope named after its parent module, so several PS instances (one per
+ * cosim_farm slot) each have their own copy of the design's domains, and
+ * the clock models of a slot join it by naming the same scope.
+ *
+ * With COSIM_BEAT_TIMING set, a beat_timing tap sits on every AXI port
+ * between the xtlm bridge and the PS.  It annotates the data beats of each
+ * transaction at the period of the port's domain.  Reads and writes have
+ * their own data channels (R and W), so each tracks when its channel is
+ * free.  A transaction that arrives while its channel is still busy waits
+ * for it, which caps a port at one beat per cycle of its clock.  DMI
+ * accesses are charged one beat.
+ *
+ * At the end of simulation every tap reports its port's domain, traffic
+ * and channel occupancy.
+ */
+
+#ifndef CLOCK_DOMAINS_H__
+#define CLOCK_DOMAINS_H__
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+struct clock_domain {
+	std::string name;		/* CLK_DOMAIN */
+	double freq_hz;			/* FREQ_HZ */
+	sc_core::sc_time period;
+	std::vector<std::string> ports;
+};
+
+class clock_domains
+{
+private:
+	std::map<std::string, clock_domain> domains;
+
+	clock_domains(void) {}
+public:
+	static bool enabled;
+	/* The registry of scope, created on first use.  */
+	static clock_domains &instance(const std::string &scope = "");
+
+	/*
+	 * Registers port as clocked by domain and returns the domain.  The
+	 * first frequency given for a domain sticks; a port that disagrees
+	 * by more than 1 ppm gets a warning.
+	 */
+	clock_domain *add(const std::string &port, const std::string &domain,
+			  double freq_hz);
+
+	/* NULL if no port was registered with domain.  */
+	clock_domain *find(const std::string &domain);
+
+	/*
+	 * Changes the frequency of domain, effective for transactions that
+	 * start from now on.  Returns false for an unknown domain.
+	 */
+	bool set_freq(const std::string &domain, double freq_hz);
+};
+
+class beat_timing
+: public sc_core::sc_module
+{
+private:
+	unsigned int beat_bytes;
+	const clock_domain *domain;
+
+	/* Data channels: R for reads, W for writes.  */
+	sc_core::sc_time rd_free;
+	sc_core::sc_time wr_free;
+
+	uint64_t transactions;
+	uint64_t beats;
+	uint64_t bytes;
+	sc_core::sc_time rd_busy;
+	sc_core::sc_time wr_busy;
+	sc_core::sc_time stalled;
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	void invalidate_direct_mem_ptr(sc_dt::uint64 start,
+				       sc_dt::uint64 end);
+public:
+	tlm_utils::simple_target_socket<beat_timing> target_socket;
+	tlm_utils::simple_initiator_socket<beat_timing> initiator_socket;
+
+	/* data_width is the port's DATA_WIDTH in bits.  */
+	beat_timing(sc_core::sc_module_name name, unsigned int data_width);
+
+	/* Until a domain is set transactions pass untimed.  */
+	void set_domain(const clock_domain *d);
+
+	void end_of_simulation(void);
+};
+
+#endif
@@ -0,0 +1,458 @@
+/*
+ * Frame capture from PL writes into DDR.
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fstream>
+#include <sstream>
+
+#include "frame_capture.h"
+#include "vcu_tile.h"
+
+using namespace sc_core;
+using namespace std;
+
+#define CAPTURE_GRANULE 64
+
+bool frame_capture::enabled = getenv("COSIM_CAPTURE") != NULL;
+
+static void tile_format(unsigned int width, unsigned int height,
+			unsigned int depth, bool nv16,
+			struct vcu_tile_format *fmt)
+{
+	vcu_tile_format_init(fmt, width, height, depth,
+			     nv16 ? VCU_TILE_NV16 : VCU_TILE_NV12);
+}
+
+capture_tap::capture_tap(sc_module_name name, frame_capture *capture)
+	: sc_module(name),
+	  capture(capture),
+	  target_socket("target_socket"),
+	  initiator_socket("initiator_socket")
+{
+	target_socket.register_b_transport(this, &capture_tap::b_transport);
+	target_socket.register_transport_dbg(this, &capture_tap::transport_dbg);
+	target_socket.register_get_direct_mem_ptr(this,
+				&capture_tap::get_direct_mem_ptr);
+	initiator_socket.register_invalidate_direct_mem_ptr(this,
+				&capture_tap::invalidate_direct_mem_ptr);
+}
+
+void capture_tap::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+	initiator_socket->b_transport(trans, delay);
+	if (trans.is_write() && trans.is_response_ok())
+		capture->observe(trans);
+}
+
+unsigned int capture_tap::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return initiator_socket->transport_dbg(trans);
+}
+
+/*
+ * Writes through a DMI pointer would bypass the shadow copy, so DMI is
+ * refused on the captured ports.  The PS side does not grant it to the
+ * HP ports today, so this costs nothing.
+ */
+bool capture_tap::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				     tlm::tlm_dmi &dmi)
+{
+	return false;
+}
+
+void capture_tap::invalidate_direct_mem_ptr(sc_dt::uint64 start,
+					    sc_dt::uint64 end)
+{
+	target_socket->invalidate_direct_mem_ptr(start, end);
+}
+
+frame_capture::frame_capture(sc_module_name name)
+	: sc_module(name),
+	  max_buffers(4),
+	  nr_buffers(0),
+	  stop(false),
+	  closed(false)
+{
+	sc_object *parent = get_parent_object();
+	const char *env;
+
+	prefix = parent ? parent->name() : "";
+	env = getenv("COSIM_CAPTURE_DIR");
+	dir = env ? env : ".";
+	env = getenv("COSIM_CAPTURE_BUFFERS");
+	if (env && atoi(env) > 0)
+		max_buffers = atoi(env);
+
+	if (!parse_config(getenv("COSIM_CAPTURE")) || regions.empty()) {
+		SC_REPORT_WARNING(this->name(),
+				  "no usable COSIM_CAPTURE regions, capture disabled");
+		enabled = false;
+		closed = true;
+		return;
+	}
+
+	writer = thread(&frame_capture::write_loop, this);
+}
+
+frame_capture::~frame_capture(void)
+{
+	unsigned int i;
+
+	close();
+	for (i = 0; i < pool.size(); i++) {
+		delete pool[i];
+	}
+}
+
+bool frame_capture::parse_config(const char *path)
+{
+	ifstream in(path);
+	string line;
+	unsigned int lineno = 0;
+
+	if (!in) {
+		perror(path);
+		return false;
+	}
+
+	while (getline(in, line)) {
+		istringstream ss(line);
+		string base, size, format, opt;
+		unsigned int width, height, depth;
+		ostringstream err;
+		struct vcu_tile_format fmt;
+		region r;
+
+		lineno++;
+		if (line.find('#') != string::npos)
+			line.erase(line.find('#'));
+		ss.str(line);
+		if (!(ss >> r.name))
+			continue;
+
+		err << path << ":" << lineno << ": ";
+		if (!(ss >> base >> size >> format >> depth) ||
+		    sscanf(size.c_str(), "%ux%u", &width, &height) != 2 ||
+		    (format != "nv12" && format != "nv16")) {
+			err << "expected: name base WxH nv12|nv16 depth [options]";
+			SC_REPORT_ERROR(name(), err.str().c_str());
+			return false;
+		}
+
+		r.base = strtoull(base.c_str(), NULL, 0);
+		r.width = width;
+		r.height = height;
+		r.bit_depth = depth;
+		r.nv16 = format == "nv16";
+		tile_format(width, height, depth, r.nv16, &fmt);
+		r.tiled = true;
+		r.irq = -1;
+		r.y4m = true;
+		r.fps = 60;
+		while (ss >> opt) {
+			if (opt == "tiled" || opt == "linear") {
+				r.tiled = opt == "tiled";
+			} else if (opt == "cover") {
+				r.irq = -1;
+			} else if (opt.compare(0, 4, "irq=") == 0) {
+				r.irq = atoi(opt.c_str() + 4);
+			} else if (opt == "y4m" || opt == "yuv") {
+				r.y4m = opt == "y4m";
+			} else if (opt.compare(0, 4, "fps=") == 0) {
+				r.fps = atoi(opt.c_str() + 4);
+			} else {
+				err << "unknown option " << opt;
+				SC_REPORT_ERROR(name(), err.str().c_str());
+				return false;
+			}
+		}
+
+		if (r.tiled ? vcu_tile_format_check(&fmt) != 0 :
+		    (depth != 8 && depth != 10) || width % 2 ||
+		    (!r.nv16 && height % 2)) {
+			err << "unsupported frame format for " << r.name;
+			SC_REPORT_ERROR(name(), err.str().c_str());
+			return false;
+		}
+
+		r.size = r.tiled ? vcu_tile_frame_size(&fmt)
+				 : vcu_linear_frame_size(&fmt);
+		r.shadow.assign(r.size, 0);
+		r.granules = (r.size + CAPTURE_GRANULE - 1) / CAPTURE_GRANULE;
+		r.coverage.assign((r.granules + 63) / 64, 0);
+		r.covered = 0;
+		r.fp = NULL;
+		r.captured = 0;
+		r.dropped = 0;
+		regions.push_back(r);
+	}
+	return true;
+}
+
+void frame_capture::observe(const tlm::tlm_generic_payload &trans)
+{
+	uint64_t addr = trans.get_address();
+	unsigned int len = trans.get_data_length();
+	unsigned int sw = trans.get_streaming_width();
+	const unsigned char *data = trans.get_data_ptr();
+	const unsigned char *be = trans.get_byte_enable_ptr();
+	unsigned int be_len = trans.get_byte_enable_length();
+	unsigned int i, j;
+
+	if (sw == 0 || sw > len)
+		sw = len;
+
+	for (i = 0; i < regions.size(); i++) {
+		region &r = regions[i];
+		uint64_t start, end;
+
+		if (addr + sw <= r.base || addr >= r.base + r.size)
+			continue;
+
+		start = addr > r.base ? addr - r.base : 0;
+		end = min<uint64_t>(addr + sw - r.base, r.size);
+		if (!be && sw == len) {
+			memcpy(&r.shadow[start], data + (r.base + start - addr),
+			       end - start);
+		} else {
+			/* Byte enables or streaming: last beat wins.  */
+			for (j = 0; j < len; j++) {
+				uint64_t a = addr + j % sw;
+
+				if (a < r.base + start || a >= r.base + end)
+					continue;
+				if (be && be[j % be_len] != tlm::TLM_BYTE_ENABLED)
+					continue;
+				r.shadow[a - r.base] = data[j];
+			}
+		}
+		mark(r, start, end);
+		if (r.irq < 0 && r.covered == r.granules)
+			snapshot(i);
+	}
+}
+
+void frame_capture::mark(region &r, uint64_t start, uint64_t end)
+{
+	size_t g;
+
+	for (g = start / CAPTURE_GRANULE; g <= (end - 1) / CAPTURE_GRANULE; g++) {
+		uint64_t bit = 1ULL << (g % 64);
+
+		if (!(r.coverage[g / 64] & bit)) {
+			r.coverage[g / 64] |= bit;
+			r.covered++;
+		}
+	}
+}
+
+/* Runs on the simulation thread: a memcpy, never a wait.  */
+void frame_capture::snapshot(unsigned int i)
+{
+	region &r = regions[i];
+	vector<uint8_t> *buf = NULL;
+	job j;
+
+	{
+		lock_guard<mutex> guard(lock);
+
+		if (!pool.empty()) {
+			buf = pool.back();
+			pool.pop_back();
+		} else if (nr_buffers < max_buffers) {
+			buf = new vector<uint8_t>();
+			nr_buffers++;
+		}
+	}
+
+	/* The next frame starts now, whether or not this one is kept.  */
+	fill(r.coverage.begin(), r.coverage.end(), 0);
+	r.covered = 0;
+	if (!buf) {
+		r.dropped++;
+		return;
+	}
+
+	buf->assign(r.shadow.begin(), r.shadow.end());
+	r.captured++;
+
+	j.region = i;
+	j.buf = buf;
+	{
+		lock_guard<mutex> guard(lock);
+		queue.push_back(j);
+	}
+	cond.notify_one();
+}
+
+void frame_capture::irq_edge(unsigned int irq)
+{
+	unsigned int i;
+
+	if (!irqs[irq]->read())
+		return;
+
+	for (i = 0; i < regions.size(); i++) {
+		/* Nothing written since the last frame, nothing new to show.  */
+		if (regions[i].irq == (int) irq && regions[i].covered)
+			snapshot(i);
+	}
+}
+
+void frame_capture::watch_irq(unsigned int irq, const sc_signal<bool> &sig)
+{
+	if (irqs.size() <= irq)
+		irqs.resize(irq + 1, NULL);
+	irqs[irq] = &sig;
+}
+
+void frame_capture::before_end_of_elaboration(void)
+{
+	unsigned int i, irq;
+
+	for (irq = 0; irq < irqs.size(); irq++) {
+		sc_spawn_options opts;
+		bool used = false;
+
+		for (i = 0; i < regions.size(); i++) {
+			if (regions[i].irq == (int) irq)
+				used = true;
+		}
+		if (!used || !irqs[irq])
+			continue;
+
+		opts.spawn_method();
+		opts.dont_initialize();
+		opts.set_sensitivity(&irqs[irq]->value_changed_event());
+		sc_spawn(sc_bind(&frame_capture::irq_edge, this, irq),
+			 sc_gen_unique_name("irq_edge"), &opts);
+	}
+}
+
+void frame_capture::write_loop(void)
+{
+	unique_lock<mutex> guard(lock);
+
+	while (true) {
+		while (queue.empty() && !stop)
+			cond.wait(guard);
+		if (queue.empty())
+			break;
+
+		job j = queue.front();
+		queue.pop_front();
+
+		guard.unlock();
+		write_frame(regions[j.region], *j.buf);
+		guard.lock();
+
+		pool.push_back(j.buf);
+	}
+}
+
+bool frame_capture::open_output(region &r)
+{
+	static const char *chroma_tags[2][2] = {
+		{ "420", "422" }, { "420p10", "422p10" },
+	};
+	string path = dir + "/" + (prefix.empty() ? "" : prefix + ".")
+		      + r.name + (r.y4m ? ".y4m" : ".yuv");
+
+	r.fp = fopen(path.c_str(), "wb");
+	if (!r.fp) {
+		perror(path.c_str());
+		return false;
+	}
+	if (r.y4m) {
+		fprintf(r.fp, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C%s\n",
+			r.width, r.height, r.fps,
+			chroma_tags[r.bit_depth == 10][r.nv16]);
+	}
+	return true;
+}
+
+/* Runs on the writer thread.  */
+void frame_capture::write_frame(region &r, const vector<uint8_t> &buf)
+{
+	const uint8_t *frame = &buf[0];
+	const uint8_t *c;
+	unsigned int bps = r.bit_depth == 8 ? 1 : 2;
+	struct vcu_tile_format fmt;
+	unsigned int lines, x, y;
+	size_t luma, half;
+	uint8_t *u, *v;
+
+	if (!r.fp && !open_output(r))
+		return;
+
+	tile_format(r.width, r.height, r.bit_depth, r.nv16, &fmt);
+	if (r.tiled) {
+		r.linear.resize(vcu_linear_frame_size(&fmt));
+		vcu_detile(&fmt, frame, &r.linear[0]);
+		frame = &r.linear[0];
+	}
+
+	luma = (size_t) r.width * r.height * bps;
+	lines = r.nv16 ? r.height : r.height / 2;
+	if (!r.y4m) {
+		fwrite(frame, 1, vcu_linear_frame_size(&fmt), r.fp);
+		fflush(r.fp);
+		return;
+	}
+
+	/* Y4M chroma is planar, NV12/NV16 interleave Cb and Cr.  */
+	half = (size_t) r.width / 2 * lines * bps;
+	r.plane.resize(half * 2);
+	u = &r.plane[0];
+	v = u + half;
+	c = frame + luma;
+	for (y = 0; y < lines; y++) {
+		for (x = 0; x < r.width / 2; x++) {
+			memcpy(u, c, bps);
+			memcpy(v, c + bps, bps);
+			u += bps;
+			v += bps;
+			c += 2 * bps;
+		}
+	}
+
+	fputs("FRAME\n", r.fp);
+	fwrite(frame, 1, luma, r.fp);
+	fwrite(&r.plane[0], 1, half * 2, r.fp);
+	/* Whole frames reach the file even if the run never ends cleanly.  */
+	fflush(r.fp);
+}
+
+void frame_capture::close(void)
+{
+	unsigned int i;
+
+	if (closed)
+		return;
+	closed = true;
+
+	{
+		lock_guard<mutex> guard(lock);
+		stop = true;
+	}
+	cond.notify_one();
+	if (writer.joinable())
+		writer.join();
+
+	for (i = 0; i < regions.size(); i++) {
+		region &r = regions[i];
+
+		if (r.fp)
+			fclose(r.fp);
+		r.fp = NULL;
+		cout << name() << ": " << r.name << ": " << r.captured
+		     << " frames, " << r.dropped << " dropped, "
+		     << r.covered << "/" << r.granules
+		     << " granules of a partial frame" << endl;
+	}
+}
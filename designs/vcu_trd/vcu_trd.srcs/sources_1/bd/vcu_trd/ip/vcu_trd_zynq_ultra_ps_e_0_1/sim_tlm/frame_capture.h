@@ -0,0 +1,153 @@
+/*
+ * Frame capture from PL writes into DDR.
+ *
+ * capture_tap sits on the HP0-3 bridge/PS socket pairs and shows every
+ * write that completes to frame_capture.  For each configured frame
+ * buffer region, frame_capture keeps a shadow copy built from those writes
+ * and a coverage bitmap of 64 byte granules.  A frame is complete when
+ * every granule has been written, or when the region's IRQ line rises.
+ * The shadow is then copied into a pooled buffer, and the copy goes to a
+ * writer thread that detiles it and appends it to a Y4M or raw YUV file.
+ * The simulation thread never waits on the disk: when the writer falls
+ * behind and the pool runs dry, the frame is dropped and counted.
+ *
+ * Only bytes written through HP0-3 are seen.  Anything else in the region
+ * (software writes from QEMU, for example) keeps its last captured value,
+ * which starts at zero.
+ *
+ * Enabled by setting COSIM_CAPTURE=<config file>.  One region per line:
+ *
+ *   # name  base        size       format  depth  [options]
+ *   dec0    0x60000000  3840x2160  nv12    8      tiled irq=0
+ *
+ * Options are tiled or linear (tiled), cover or irq=N (cover), y4m or yuv
+ * (y4m) and fps=N (60).  Tiled regions use the 64x4 VCU layout.  Linear
+ * 10 bit regions hold one 16 bit word per sample.  Luma and chroma planes
+ * must be contiguous.  Files are written as <instance>.<name>.y4m or
+ * <instance>.<name>.yuv in COSIM_CAPTURE_DIR (default "."), where
+ * <instance> is the hierarchical name of the PS model, so several PS
+ * instances can capture into one directory.  COSIM_CAPTURE_BUFFERS
+ * (default 4) sets how many frames may be in flight.
+ *
+ * The tiled layouts come from vcu_tile.{h,cpp}, a copy of tools/vcu_tile
+ * shipped with the IP so the PS model builds on its own; only
+ * frame_capture.cpp includes it.
+ */
+
+#ifndef FRAME_CAPTURE_H__
+#define FRAME_CAPTURE_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+class frame_capture;
+
+class capture_tap
+: public sc_core::sc_module
+{
+private:
+	frame_capture *capture;
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	void invalidate_direct_mem_ptr(sc_dt::uint64 start,
+				       sc_dt::uint64 end);
+public:
+	tlm_utils::simple_target_socket<capture_tap> target_socket;
+	tlm_utils::simple_initiator_socket<capture_tap> initiator_socket;
+
+	capture_tap(sc_core::sc_module_name name, frame_capture *capture);
+};
+
+class frame_capture
+: public sc_core::sc_module
+{
+private:
+	struct region {
+		std::string name;
+		uint64_t base;
+		size_t size;
+		unsigned int width;
+		unsigned int height;
+		unsigned int bit_depth;
+		bool nv16;
+		bool tiled;
+		int irq;
+		bool y4m;
+		unsigned int fps;
+
+		std::vector<uint8_t> shadow;
+		std::vector<uint64_t> coverage;
+		size_t granules;
+		size_t covered;
+
+		/* Owned by the writer thread once the simulation runs.  */
+		FILE *fp;
+		std::vector<uint8_t> linear;
+		std::vector<uint8_t> plane;
+
+		unsigned int captured;
+		unsigned int dropped;
+	};
+
+	struct job {
+		unsigned int region;
+		std::vector<uint8_t> *buf;
+	};
+
+	std::vector<region> regions;
+	std::vector<const sc_signal<bool> *> irqs;
+	std::string dir;
+	std::string prefix;
+	unsigned int max_buffers;
+	unsigned int nr_buffers;
+
+	/* Shared with the writer thread.  */
+	std::vector<std::vector<uint8_t> *> pool;
+	std::deque<job> queue;
+	std::mutex lock;
+	std::condition_variable cond;
+	std::thread writer;
+	bool stop;
+	bool closed;
+
+	bool parse_config(const char *path);
+	void mark(region &r, uint64_t start, uint64_t end);
+	void snapshot(unsigned int i);
+	void irq_edge(unsigned int irq);
+
+	void write_loop(void);
+	void write_frame(region &r, const std::vector<uint8_t> &buf);
+	bool open_output(region &r);
+public:
+	static bool enabled;
+
+	frame_capture(sc_core::sc_module_name name);
+	~frame_capture(void);
+
+	/* A completed write seen by one of the taps.  */
+	void observe(const tlm::tlm_generic_payload &trans);
+
+	/* Trigger irq=N regions on rising edges of sig.  */
+	void watch_irq(unsigned int irq, const sc_signal<bool> &sig);
+
+	void before_end_of_elaboration(void);
+
+	/* Drain the queue, close the files and print a summary.  */
+	void close(void);
+};
+
+#endif
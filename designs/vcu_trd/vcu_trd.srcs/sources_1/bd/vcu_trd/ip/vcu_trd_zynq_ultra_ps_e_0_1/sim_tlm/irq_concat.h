@@ -0,0 +1,248 @@
+/*
+ * Interrupt concentrator channel, a native stand-in for xlconcat.
+ *
+ * vcu_interrupt (xlconcat) merges interrupt lines into pl_ps_irq0.  Built
+ * from signals that costs an update per input line, a process to
+ * concatenate them, an update of the sc_bv signal and pl_ps_irq0_method
+ * to split the word into pl2ps_irq again.
+ *
+ * irq_concat<W> is a single primitive channel instead.  Interrupt sources
+ * bind their sc_out<bool> to in(i).  The channel keeps the lines as one
+ * word with a mask of the bits that changed in the last update, and is
+ * itself an sc_bv<W> signal, so it can be bound where the xlconcat output
+ * signal would be (e.g. to pl_ps_irq0).
+ *
+ * After drive() a line write goes straight to the bool signal it drives,
+ * typically xilinx_zynqmp::pl2ps_irq[first + i], and only if the line
+ * changes.  The lines then read back, and notify, through those signals.
+ * zynq_ultra_ps_e_tlm calls drive() itself when its pl_ps_irq0 is bound
+ * to an irq_concat<1>.
+ *
+ * Like sc_signal, writes become visible in the next delta cycle.
+ */
+
+#ifndef IRQ_CONCAT_H__
+#define IRQ_CONCAT_H__
+
+#include <stdint.h>
+
+#include "systemc.h"
+
+template<int W>
+class irq_concat
+: public sc_core::sc_prim_channel,
+  public sc_core::sc_signal_in_if<sc_dt::sc_bv<W> >
+{
+public:
+	/* One input line.  */
+	class line
+	: public sc_core::sc_signal_inout_if<bool>
+	{
+	private:
+		friend class irq_concat;
+
+		irq_concat *owner;
+		uint32_t bit;
+		bool cur;
+		bool next;
+		sc_dt::uint64 stamp;
+		sc_core::sc_signal<bool> *out;
+		sc_core::sc_event changed_ev;
+		sc_core::sc_event pos_ev;
+		sc_core::sc_event neg_ev;
+
+		/* From the owner's update, when not driving a signal.  */
+		void update(void)
+		{
+			if (cur == next)
+				return;
+			cur = next;
+			stamp = sc_core::sc_delta_count();
+			changed_ev.notify(sc_core::SC_ZERO_TIME);
+			if (cur)
+				pos_ev.notify(sc_core::SC_ZERO_TIME);
+			else
+				neg_ev.notify(sc_core::SC_ZERO_TIME);
+		}
+	public:
+		line(void)
+			: owner(NULL), bit(0), cur(false), next(false),
+			  stamp(~(sc_dt::uint64) 0), out(NULL)
+		{}
+
+		void write(const bool &v)
+		{
+			if (v == next)
+				return;
+			next = v;
+			if (out)
+				out->write(v);
+			owner->line_written(bit, v);
+		}
+
+		const bool &read(void) const
+		{
+			return out ? out->read() : cur;
+		}
+		const bool &get_data_ref(void) const
+		{
+			return read();
+		}
+		const sc_core::sc_event &value_changed_event(void) const
+		{
+			return out ? out->value_changed_event() : changed_ev;
+		}
+		const sc_core::sc_event &posedge_event(void) const
+		{
+			return out ? out->posedge_event() : pos_ev;
+		}
+		const sc_core::sc_event &negedge_event(void) const
+		{
+			return out ? out->negedge_event() : neg_ev;
+		}
+		const sc_core::sc_event &default_event(void) const
+		{
+			return value_changed_event();
+		}
+		bool event(void) const
+		{
+			if (out)
+				return out->event();
+			return stamp == sc_core::sc_delta_count();
+		}
+		bool posedge(void) const
+		{
+			return event() && read();
+		}
+		bool negedge(void) const
+		{
+			return event() && !read();
+		}
+	};
+
+private:
+	line lines[W];
+	uint32_t cur;
+	uint32_t next;
+	uint32_t changed_mask;
+	bool pending;
+	bool driving;
+	sc_dt::uint64 stamp;
+	sc_dt::sc_bv<W> word;
+	sc_core::sc_event changed_ev;
+
+	void line_written(uint32_t bit, bool v)
+	{
+		if (v)
+			next |= 1U << bit;
+		else
+			next &= ~(1U << bit);
+		if (!pending) {
+			pending = true;
+			this->request_update();
+		}
+	}
+
+protected:
+	void update(void)
+	{
+		unsigned int i;
+
+		pending = false;
+		changed_mask = cur ^ next;
+		if (!changed_mask)
+			return;
+		cur = next;
+		stamp = sc_core::sc_delta_count();
+		word = sc_dt::sc_bv<W>(cur);
+		if (!driving) {
+			for (i = 0; i < W; i++) {
+				if (changed_mask & (1U << i))
+					lines[i].update();
+			}
+		}
+		changed_ev.notify(sc_core::SC_ZERO_TIME);
+	}
+
+public:
+	irq_concat(const char *name)
+		: sc_core::sc_prim_channel(name),
+		  cur(0), next(0), changed_mask(0), pending(false),
+		  driving(false), stamp(~(sc_dt::uint64) 0), word(0)
+	{
+		unsigned int i;
+
+		/* Interrupts are packed into a 32-bit word.  */
+		sc_assert(W > 0 && W <= 32);
+		for (i = 0; i < W; i++) {
+			lines[i].owner = this;
+			lines[i].bit = i;
+		}
+	}
+
+	/* Input line i, the xlconcat In<i> port.  */
+	line &in(unsigned int i)
+	{
+		sc_assert(i < W);
+		return lines[i];
+	}
+
+	/*
+	 * Drive irq[first + i] from line i.  The channel becomes the only
+	 * writer of those signals; call it during elaboration.
+	 */
+	void drive(sc_core::sc_vector<sc_core::sc_signal<bool> > &irq,
+		   unsigned int first = 0)
+	{
+		unsigned int i;
+
+		sc_assert(first + W <= irq.size());
+		for (i = 0; i < W; i++)
+			lines[i].out = &irq[first + i];
+		driving = true;
+	}
+
+	bool is_driving(void) const
+	{
+		return driving;
+	}
+
+	/* The lines as a word, and the bits the last update changed.  */
+	uint32_t value(void) const
+	{
+		return cur;
+	}
+	uint32_t changed(void) const
+	{
+		return changed_mask;
+	}
+
+	/* sc_signal_in_if<sc_bv<W> >, the xlconcat dout.  */
+	const sc_dt::sc_bv<W> &read(void) const
+	{
+		return word;
+	}
+	const sc_dt::sc_bv<W> &get_data_ref(void) const
+	{
+		return word;
+	}
+	const sc_core::sc_event &value_changed_event(void) const
+	{
+		return changed_ev;
+	}
+	const sc_core::sc_event &default_event(void) const
+	{
+		return changed_ev;
+	}
+	bool event(void) const
+	{
+		return stamp == sc_core::sc_delta_count();
+	}
+
+	const char *kind(void) const
+	{
+		return "irq_concat";
+	}
+};
+
+#endif
@@ -0,0 +1,162 @@
+/*
+ * Pooled, reference counted payload data buffers.
+ */
+
+#include <assert.h>
+
+#include "payload_pool.h"
+
+payload_buffer::payload_buffer(payload_buffer_pool *pool, unsigned int size)
+	: pool(pool),
+	  storage(new unsigned char[size]),
+	  refcount(0)
+{
+}
+
+payload_buffer::~payload_buffer(void)
+{
+	delete[] storage;
+}
+
+unsigned int payload_buffer::size(void) const
+{
+	return pool->buf_size;
+}
+
+void payload_buffer::release(void)
+{
+	assert(refcount > 0);
+	if (--refcount == 0)
+		pool->put(this);
+}
+
+payload_buffer_pool::payload_buffer_pool(unsigned int max_burst_len,
+					 unsigned int data_width_bytes)
+	: buf_size(max_burst_len * data_width_bytes),
+	  nr_allocated(0)
+{
+}
+
+payload_buffer_pool::~payload_buffer_pool(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < free_list.size(); i++) {
+		delete free_list[i];
+	}
+}
+
+payload_buffer *payload_buffer_pool::get(void)
+{
+	payload_buffer *buf;
+
+	if (free_list.empty()) {
+		buf = new payload_buffer(this, buf_size);
+		nr_allocated++;
+	} else {
+		buf = free_list.back();
+		free_list.pop_back();
+	}
+	buf->acquire();
+	return buf;
+}
+
+void payload_buffer_pool::put(payload_buffer *buf)
+{
+	free_list.push_back(buf);
+}
+
+payload_buffer_extension::~payload_buffer_extension(void)
+{
+	if (buf)
+		buf->release();
+}
+
+tlm::tlm_extension_base *payload_buffer_extension::clone(void) const
+{
+	payload_buffer_extension *ext = new payload_buffer_extension();
+
+	ext->buf = buf;
+	if (buf)
+		buf->acquire();
+	return ext;
+}
+
+void payload_buffer_extension::copy_from(const tlm::tlm_extension_base &ext)
+{
+	payload_buffer *nbuf;
+
+	nbuf = static_cast<const payload_buffer_extension &>(ext).buf;
+	if (nbuf)
+		nbuf->acquire();
+	if (buf)
+		buf->release();
+	buf = nbuf;
+}
+
+payload_buffer *payload_buffer_extension::get(const tlm::tlm_generic_payload &gp)
+{
+	payload_buffer_extension *ext;
+
+	gp.get_extension(ext);
+	return ext ? ext->buf : NULL;
+}
+
+payload_mm::payload_mm(payload_buffer_pool &pool)
+	: pool(pool)
+{
+}
+
+payload_mm::~payload_mm(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < free_list.size(); i++) {
+		payload_buffer_extension *ext;
+
+		free_list[i]->get_extension(ext);
+		free_list[i]->clear_extension(ext);
+		delete ext;
+		delete free_list[i];
+	}
+}
+
+tlm::tlm_generic_payload *payload_mm::allocate(void)
+{
+	tlm::tlm_generic_payload *gp;
+	payload_buffer_extension *ext;
+
+	if (free_list.empty()) {
+		gp = new tlm::tlm_generic_payload(this);
+		ext = new payload_buffer_extension();
+		gp->set_extension(ext);
+	} else {
+		gp = free_list.back();
+		free_list.pop_back();
+		gp->get_extension(ext);
+	}
+
+	ext->buf = pool.get();
+	gp->set_data_ptr(ext->buf->data());
+	gp->set_data_length(ext->buf->size());
+	gp->set_streaming_width(ext->buf->size());
+	gp->set_byte_enable_ptr(NULL);
+	gp->set_byte_enable_length(0);
+	gp->set_dmi_allowed(false);
+	gp->set_response_status(tlm::TLM_INCOMPLETE_RESPONSE);
+	gp->acquire();
+	return gp;
+}
+
+void payload_mm::free(tlm::tlm_generic_payload *gp)
+{
+	payload_buffer_extension *ext;
+
+	gp->get_extension(ext);
+	if (ext->buf) {
+		ext->buf->release();
+		ext->buf = NULL;
+	}
+	gp->set_data_ptr(NULL);
+	free_list.push_back(gp);
+}
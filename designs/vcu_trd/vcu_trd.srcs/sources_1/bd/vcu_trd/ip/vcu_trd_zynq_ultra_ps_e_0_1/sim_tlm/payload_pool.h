@@ -0,0 +1,109 @@
+/*
+ * Pooled, reference counted payload data buffers.
+ *
+ * A burst's data lives in one payload_buffer sized for the largest burst
+ * a port can issue (MAX_BURST_LENGTH x data width, 256 x 16 bytes on the
+ * HP ports).  The generic payload and any consumer that keeps the data
+ * past the transaction share that storage; each holder takes a reference
+ * and the buffer goes back to its pool when the last one lets go.
+ *
+ * It is an allocator for PL side initiators, today the VCU traffic
+ * generators (sim_1/new/vcu_traffic.h), and removes no copy from the PS
+ * bridge path.  That path's copies are all inside prebuilt libraries:
+ * the xtlm2tlm bridges build their own generic payload, and the
+ * remote-port layer copies the data into its packet.  xilinx_zynqmp
+ * passes the payload through without copying.
+ */
+
+#ifndef PAYLOAD_POOL_H__
+#define PAYLOAD_POOL_H__
+
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+
+class payload_buffer_pool;
+
+class payload_buffer
+{
+	friend class payload_buffer_pool;
+private:
+	payload_buffer_pool *pool;
+	unsigned char *storage;
+	unsigned int refcount;
+
+	payload_buffer(payload_buffer_pool *pool, unsigned int size);
+	~payload_buffer(void);
+public:
+	unsigned char *data(void) { return storage; }
+	unsigned int size(void) const;
+
+	void acquire(void) { refcount++; }
+	void release(void);
+};
+
+class payload_buffer_pool
+{
+	friend class payload_buffer;
+private:
+	unsigned int buf_size;
+	std::vector<payload_buffer *> free_list;
+	unsigned int nr_allocated;
+
+	void put(payload_buffer *buf);
+public:
+	payload_buffer_pool(unsigned int max_burst_len,
+			    unsigned int data_width_bytes);
+	~payload_buffer_pool(void);
+
+	/* Returns a buffer holding one reference.  */
+	payload_buffer *get(void);
+
+	unsigned int buffer_size(void) const { return buf_size; }
+	unsigned int allocated(void) const { return nr_allocated; }
+};
+
+/*
+ * Travels with a generic payload whose data pointer points into a pooled
+ * buffer, holding a reference to it.  A consumer that needs the data
+ * beyond the transaction takes a reference instead of copying it.  Clones
+ * take a reference of their own and an extension releases its reference
+ * when freed.
+ */
+class payload_buffer_extension
+: public tlm::tlm_extension<payload_buffer_extension>
+{
+public:
+	payload_buffer *buf;
+
+	payload_buffer_extension(void) : buf(NULL) {}
+	~payload_buffer_extension(void);
+
+	virtual tlm::tlm_extension_base *clone(void) const;
+	virtual void copy_from(const tlm::tlm_extension_base &ext);
+
+	static payload_buffer *get(const tlm::tlm_generic_payload &gp);
+};
+
+/*
+ * TLM memory manager handing out generic payloads pre-attached to a
+ * pooled data buffer.  Payloads and buffers are recycled, so a steady
+ * stream of bursts does no allocation.
+ */
+class payload_mm
+: public tlm::tlm_mm_interface
+{
+private:
+	payload_buffer_pool &pool;
+	std::vector<tlm::tlm_generic_payload *> free_list;
+public:
+	payload_mm(payload_buffer_pool &pool);
+	~payload_mm(void);
+
+	/* Returns a payload holding one reference (see tlm acquire/release). */
+	tlm::tlm_generic_payload *allocate(void);
+	void free(tlm::tlm_generic_payload *gp);
+};
+
+#endif
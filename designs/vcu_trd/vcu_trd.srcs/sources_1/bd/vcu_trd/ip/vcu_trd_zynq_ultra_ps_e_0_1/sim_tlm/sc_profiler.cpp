@@ -0,0 +1,243 @@
+/*
+ * Opt-in SystemC process profiler.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "sc_profiler.h"
+
+using namespace sc_core;
+using namespace std;
+
+bool sc_profiler::enabled = getenv("COSIM_PROFILE") != NULL;
+
+sc_profiler::sc_profiler(void)
+	: cur_proc(NULL),
+	  cur_delta(0),
+	  cur_ns(0),
+	  top_n(20),
+	  sim_start_ns(0),
+	  sim_end_ns(0),
+	  dumped(false)
+{
+	const char *env;
+
+	env = getenv("COSIM_PROFILE");
+	if (env && strtoul(env, NULL, 0) > 0)
+		top_n = strtoul(env, NULL, 0);
+	env = getenv("COSIM_PROFILE_FOLDED");
+	if (env)
+		folded_path = env;
+}
+
+sc_profiler &sc_profiler::instance(void)
+{
+	static sc_profiler profiler;
+	return profiler;
+}
+
+/*
+ * Wall time: QEMU round trips block in the kernel and would not show up
+ * in CPU time.
+ */
+uint64_t sc_profiler::now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/*
+ * Advances and returns proc's clock.  The time since the last event only
+ * counts if that event was proc's and in this delta cycle; otherwise proc
+ * has been suspended in between.
+ */
+uint64_t sc_profiler::run_ns(const sc_object *proc)
+{
+	sc_dt::uint64 delta = sc_delta_count();
+	uint64_t now = now_ns();
+	proc_state &ps = procs[proc];
+
+	if (proc == cur_proc && delta == cur_delta)
+		ps.run_ns += now - cur_ns;
+	cur_proc = proc;
+	cur_delta = delta;
+	cur_ns = now;
+	return ps.run_ns;
+}
+
+void sc_profiler::enter(const char *scope)
+{
+	sc_object *proc = sc_get_current_process_handle().get_process_object();
+	vector<frame> &stack = procs[proc].stack;
+	frame f;
+
+	if (stack.empty())
+		f.path = proc ? proc->name() : "(elaboration)";
+	else
+		f.path = stack.back().path;
+	f.path += ';';
+	f.path += scope;
+	f.child_ns = 0;
+	f.start_ns = run_ns(proc);
+	stack.push_back(f);
+}
+
+void sc_profiler::leave(void)
+{
+	sc_object *proc = sc_get_current_process_handle().get_process_object();
+	uint64_t end = run_ns(proc);
+	vector<frame> &stack = procs[proc].stack;
+	uint64_t total;
+	stats *st;
+
+	if (stack.empty())
+		return;
+
+	frame &f = stack.back();
+	total = end - f.start_ns;
+	st = &table[f.path];
+	st->total_ns += total;
+	st->self_ns += total > f.child_ns ? total - f.child_ns : 0;
+	st->count++;
+	stack.pop_back();
+
+	if (!stack.empty())
+		stack.back().child_ns += total;
+}
+
+void sc_profiler::start(void)
+{
+	if (!sim_start_ns)
+		sim_start_ns = now_ns();
+}
+
+static bool by_self_time(const pair<string, uint64_t> &a,
+			 const pair<string, uint64_t> &b)
+{
+	return a.second > b.second;
+}
+
+void sc_profiler::report(ostream &os, unsigned int n)
+{
+	map<string, stats>::const_iterator it;
+	map<string, uint64_t> per_proc;
+	vector<pair<string, uint64_t> > top;
+	uint64_t attributed = 0;
+	uint64_t wall_ns;
+	unsigned int i;
+
+	for (it = table.begin(); it != table.end(); ++it) {
+		string proc = it->first.substr(0, it->first.find(';'));
+
+		per_proc[proc] += it->second.self_ns;
+		attributed += it->second.self_ns;
+	}
+	top.assign(per_proc.begin(), per_proc.end());
+	sort(top.begin(), top.end(), by_self_time);
+
+	wall_ns = (sim_end_ns > sim_start_ns) ? sim_end_ns - sim_start_ns : 0;
+
+	os << "SystemC profile: " << wall_ns / 1000000 << " ms host wall, "
+	   << attributed / 1000000 << " ms in profiled scopes\n";
+	if (wall_ns > attributed) {
+		os << "  partial coverage: " << (wall_ns - attributed) / 1000000
+		   << " ms outside the PS scopes and socket taps (bridge,"
+		   << " router and register slice processes, kernel)\n";
+	}
+	os << "  top processes by self time:\n";
+	for (i = 0; i < top.size() && i < n; i++) {
+		os << "  " << setw(10) << top[i].second / 1000 << " us  "
+		   << top[i].first << "\n";
+	}
+
+	os << "  top scopes by self time:\n";
+	vector<pair<string, uint64_t> > scopes;
+	for (it = table.begin(); it != table.end(); ++it) {
+		scopes.push_back(make_pair(it->first, it->second.self_ns));
+	}
+	sort(scopes.begin(), scopes.end(), by_self_time);
+	for (i = 0; i < scopes.size() && i < n; i++) {
+		const stats &st = table[scopes[i].first];
+
+		os << "  " << setw(10) << st.self_ns / 1000 << " us  "
+		   << setw(10) << st.count << " calls  "
+		   << scopes[i].first << "\n";
+	}
+}
+
+bool sc_profiler::write_folded(const char *path)
+{
+	map<string, stats>::const_iterator it;
+	ofstream out(path);
+
+	if (!out)
+		return false;
+
+	/* Folded stacks, one line per stack, weighted by self time in us.  */
+	for (it = table.begin(); it != table.end(); ++it) {
+		if (it->second.self_ns < 1000)
+			continue;
+		out << it->first << " " << it->second.self_ns / 1000 << "\n";
+	}
+	return true;
+}
+
+void sc_profiler::dump(void)
+{
+	if (!enabled || dumped)
+		return;
+	dumped = true;
+	sim_end_ns = now_ns();
+
+	report(cout, top_n);
+	if (!folded_path.empty() && !write_folded(folded_path.c_str()))
+		perror(folded_path.c_str());
+}
+
+profile_tap::profile_tap(sc_module_name name, const char *port)
+	: sc_module(name),
+	  port(port),
+	  target_socket("target_socket"),
+	  initiator_socket("initiator_socket")
+{
+	target_socket.register_b_transport(this, &profile_tap::b_transport);
+	target_socket.register_transport_dbg(this,
+				&profile_tap::transport_dbg);
+	target_socket.register_get_direct_mem_ptr(this,
+				&profile_tap::get_direct_mem_ptr);
+	initiator_socket.register_invalidate_direct_mem_ptr(this,
+				&profile_tap::invalidate_direct_mem_ptr);
+}
+
+void profile_tap::b_transport(tlm::tlm_generic_payload &trans,
+			      sc_time &delay)
+{
+	SC_PROFILE_SCOPE(port.c_str());
+	initiator_socket->b_transport(trans, delay);
+}
+
+unsigned int profile_tap::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return initiator_socket->transport_dbg(trans);
+}
+
+bool profile_tap::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				     tlm::tlm_dmi &dmi)
+{
+	return initiator_socket->get_direct_mem_ptr(trans, dmi);
+}
+
+void profile_tap::invalidate_direct_mem_ptr(sc_dt::uint64 start,
+					    sc_dt::uint64 end)
+{
+	target_socket->invalidate_direct_mem_ptr(start, end);
+}
@@ -0,0 +1,142 @@
+/*
+ * Opt-in SystemC process profiler.
+ *
+ * Host wall time and activation counts are attributed to profiled scopes,
+ * keyed by the SystemC process that runs them.  Code called from a
+ * process we do not own (e.g. the pin-level transactor threads calling
+ * into the xtlm2tlm bridges and the PS proxies) still shows up under that
+ * process's name.
+ *
+ * Enabled by setting COSIM_PROFILE to the number of entries to report.
+ * With COSIM_PROFILE_FOLDED=<file> the samples are also written in the
+ * folded stack format understood by flamegraph.pl.
+ *
+ * SystemC processes are coroutines on one host thread, so a scope that
+ * calls wait() would otherwise be charged for whatever runs while it is
+ * suspended.  Each process has its own clock instead, which only
+ * advances between two profiler events of that process in the same delta
+ * cycle with no other process's event in between.  Time from a process's
+ * last event up to its wait() is therefore not attributed.
+ *
+ * QEMU round trips through remote-port block the simulation thread
+ * without yielding, so the b_transport scopes include the time QEMU
+ * takes to answer.
+ *
+ * Besides the hand placed scopes, a profile_tap on every bridge/PS
+ * socket pair opens a scope named after its port around each
+ * b_transport, so whatever the call runs on its way through (taps, PS
+ * proxies, the PL side of the tlm2xtlm bridges) is charged to that port.
+ * Coverage is still partial: the bridges' own processes, the pin-level
+ * transactors, the router and register slices in between, and the
+ * kernel are only seen where they call through a tap.  The report says
+ * how much host time this leaves unattributed.
+ */
+
+#ifndef SC_PROFILER_H__
+#define SC_PROFILER_H__
+
+#include <stdint.h>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+class sc_profiler
+{
+private:
+	struct frame {
+		std::string path;
+		uint64_t start_ns;
+		uint64_t child_ns;
+	};
+	struct stats {
+		uint64_t self_ns;
+		uint64_t total_ns;
+		uint64_t count;
+	};
+	/* Open scopes and run time of one process.  */
+	struct proc_state {
+		std::vector<frame> stack;
+		uint64_t run_ns;
+	};
+
+	std::map<const sc_core::sc_object *, proc_state> procs;
+	std::map<std::string, stats> table;
+	/* Process and delta cycle of the last event, and its host time.  */
+	const sc_core::sc_object *cur_proc;
+	sc_dt::uint64 cur_delta;
+	uint64_t cur_ns;
+	unsigned int top_n;
+	std::string folded_path;
+	uint64_t sim_start_ns;
+	uint64_t sim_end_ns;
+	bool dumped;
+
+	sc_profiler(void);
+	static uint64_t now_ns(void);
+	uint64_t run_ns(const sc_core::sc_object *proc);
+public:
+	static bool enabled;
+	static sc_profiler &instance(void);
+
+	void enter(const char *scope);
+	void leave(void);
+
+	/* Bracket the measured run; dump() is idempotent.  */
+	void start(void);
+	void dump(void);
+
+	void report(std::ostream &os, unsigned int top_n);
+	bool write_folded(const char *path);
+};
+
+class sc_profile_scope
+{
+private:
+	bool active;
+public:
+	sc_profile_scope(const char *scope)
+		: active(sc_profiler::enabled)
+	{
+		if (active)
+			sc_profiler::instance().enter(scope);
+	}
+	~sc_profile_scope(void)
+	{
+		if (active)
+			sc_profiler::instance().leave();
+	}
+};
+
+#define SC_PROFILE_CAT_(a, b) a ## b
+#define SC_PROFILE_CAT(a, b) SC_PROFILE_CAT_(a, b)
+#define SC_PROFILE_SCOPE(name) \
+	sc_profile_scope SC_PROFILE_CAT(sc_profile_scope_, __LINE__)(name)
+
+/* AXI pass-through profiling every call under the scope port.  */
+class profile_tap
+: public sc_core::sc_module
+{
+private:
+	std::string port;
+
+	void b_transport(tlm::tlm_generic_payload &trans,
+			 sc_core::sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	void invalidate_direct_mem_ptr(sc_dt::uint64 start,
+				       sc_dt::uint64 end);
+public:
+	tlm_utils::simple_target_socket<profile_tap> target_socket;
+	tlm_utils::simple_initiator_socket<profile_tap> initiator_socket;
+
+	profile_tap(sc_core::sc_module_name name, const char *port);
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*
+ * Trace probes for the PS/PL boundary.
+ */
+
+#define SC_INCLUDE_DYNAMIC_PROCESSES
+
+#include "trace_probe.h"
+#include "trace_writer.h"
+
+using namespace sc_core;
+using namespace std;
+
+trace_tap::trace_tap(sc_module_name name)
+	: sc_module(name),
+	  target_socket("target_socket"),
+	  initiator_socket("initiator_socket")
+{
+	track = trace_writer::instance().track(this->name());
+
+	target_socket.register_b_transport(this, &trace_tap::b_transport);
+	target_socket.register_transport_dbg(this, &trace_tap::transport_dbg);
+	target_socket.register_get_direct_mem_ptr(this,
+				&trace_tap::get_direct_mem_ptr);
+	initiator_socket.register_invalidate_direct_mem_ptr(this,
+				&trace_tap::invalidate_direct_mem_ptr);
+}
+
+void trace_tap::b_transport(tlm::tlm_generic_payload &trans, sc_time &delay)
+{
+	sc_time start = sc_time_stamp() + delay;
+
+	initiator_socket->b_transport(trans, delay);
+
+	trace_writer::instance().complete(track,
+		trans.is_read() ? "read" : "write",
+		start, sc_time_stamp() + delay,
+		trans.get_address(), trans.get_data_length());
+}
+
+unsigned int trace_tap::transport_dbg(tlm::tlm_generic_payload &trans)
+{
+	return initiator_socket->transport_dbg(trans);
+}
+
+bool trace_tap::get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				   tlm::tlm_dmi &dmi)
+{
+	return initiator_socket->get_direct_mem_ptr(trans, dmi);
+}
+
+void trace_tap::invalidate_direct_mem_ptr(sc_dt::uint64 start,
+					  sc_dt::uint64 end)
+{
+	target_socket->invalidate_direct_mem_ptr(start, end);
+}
+
+trace_probe::trace_probe(sc_module_name name)
+	: sc_module(name)
+{
+}
+
+void trace_probe::watch(const sc_signal<bool> &sig)
+{
+	probe p;
+
+	/* Tracks are allocated on the first edge, most lines never toggle.  */
+	p.sig = &sig;
+	p.track = 0;
+	irqs.push_back(p);
+}
+
+void trace_probe::irq_edge(unsigned int i)
+{
+	trace_writer &tw = trace_writer::instance();
+	probe &p = irqs[i];
+
+	if (!p.track)
+		p.track = tw.track(p.sig->name());
+	tw.level(p.track, "asserted", p.sig->read(), sc_time_stamp());
+}
+
+void trace_probe::before_end_of_elaboration(void)
+{
+	unsigned int i;
+
+	for (i = 0; i < irqs.size(); i++) {
+		sc_spawn_options opts;
+
+		opts.spawn_method();
+		opts.dont_initialize();
+		opts.set_sensitivity(&irqs[i].sig->value_changed_event());
+		sc_spawn(sc_bind(&trace_probe::irq_edge, this, i),
+			 sc_gen_unique_name("irq_edge"), &opts);
+	}
+}
+
+rp_sync_trace::rp_sync_trace(const char *name)
+{
+	string track_name = string(name) + ".rp_sync";
+
+	track = trace_writer::instance().track(track_name.c_str());
+	gettimeofday(&last, NULL);
+}
+
+void rp_sync_trace::mark(const char *what, const sc_time &ts)
+{
+	struct timeval now;
+	uint64_t host_us;
+
+	gettimeofday(&now, NULL);
+	host_us = (now.tv_sec - last.tv_sec) * 1000000ULL
+		  + now.tv_usec - last.tv_usec;
+	last = now;
+	trace_writer::instance().instant(track, what, ts, "host_us", host_us);
+}
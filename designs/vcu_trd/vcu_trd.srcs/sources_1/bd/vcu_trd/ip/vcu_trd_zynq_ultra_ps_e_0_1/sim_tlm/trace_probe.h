@@ -0,0 +1,85 @@
+/*
+ * Trace probes for the PS/PL boundary, see trace_writer.h.
+ *
+ * trace_tap is an AXI pass-through placed on a bridge/PS socket pair that
+ * records every transaction on its own track.  trace_probe records IRQ
+ * edges.  Both are only instantiated while tracing is enabled.
+ *
+ * rp_sync_trace marks the points where a PS instance exchanges time with
+ * QEMU over remote-port: every PL to PS transaction when QEMU's response
+ * comes back, and every PS to PL transaction when QEMU's request comes
+ * in.  xilinx_zynqmp calls it on its remote-port path, whether or not
+ * the adaptive quantum is enabled.  Sync packets that carry no
+ * transaction are handled inside the remote-port library, which has no
+ * hook for them, so idle stretches show no markers.
+ */
+
+#ifndef TRACE_PROBE_H__
+#define TRACE_PROBE_H__
+
+#include <stdint.h>
+#include <sys/time.h>
+#include <vector>
+
+#include "systemc.h"
+#include "tlm.h"
+#include "tlm_utils/simple_initiator_socket.h"
+#include "tlm_utils/simple_target_socket.h"
+
+class trace_tap
+: public sc_core::sc_module
+{
+private:
+	int track;
+
+	void b_transport(tlm::tlm_generic_payload &trans, sc_time &delay);
+	unsigned int transport_dbg(tlm::tlm_generic_payload &trans);
+	bool get_direct_mem_ptr(tlm::tlm_generic_payload &trans,
+				tlm::tlm_dmi &dmi);
+	void invalidate_direct_mem_ptr(sc_dt::uint64 start,
+				       sc_dt::uint64 end);
+public:
+	tlm_utils::simple_target_socket<trace_tap> target_socket;
+	tlm_utils::simple_initiator_socket<trace_tap> initiator_socket;
+
+	trace_tap(sc_core::sc_module_name name);
+};
+
+class trace_probe
+: public sc_core::sc_module
+{
+private:
+	struct probe {
+		const sc_signal<bool> *sig;
+		int track;
+	};
+	std::vector<probe> irqs;
+
+	void irq_edge(unsigned int i);
+public:
+	SC_HAS_PROCESS(trace_probe);
+	trace_probe(sc_core::sc_module_name name);
+
+	/* Record every edge of sig on a track of its own.  */
+	void watch(const sc_signal<bool> &sig);
+
+	void before_end_of_elaboration(void);
+};
+
+class rp_sync_trace
+{
+private:
+	int track;
+	struct timeval last;
+public:
+	/* Records on the track <name>.rp_sync.  */
+	rp_sync_trace(const char *name);
+
+	/*
+	 * A time exchange with QEMU at ts; the host time since the last one
+	 * shows where the co-simulation stalled.
+	 */
+	void mark(const char *what, const sc_core::sc_time &ts);
+};
+
+#endif
@@ -0,0 +1,213 @@
+/*
+ * Chrome/Perfetto JSON trace writer.
+ */
+
+#include <inttypes.h>
+#include <stdlib.h>
+
+#include "trace_writer.h"
+
+using namespace sc_core;
+using namespace std;
+
+/* Hand a chunk to the writer thread once it reaches this size.  */
+#define TRACE_CHUNK_SIZE (1 << 20)
+
+bool trace_writer::enabled = getenv("COSIM_TRACE") != NULL;
+
+trace_writer::trace_writer(const char *path)
+	: fp(NULL),
+	  first(true),
+	  closed(false),
+	  next_track(1),
+	  stop(false)
+{
+	if (path)
+		fp = fopen(path, "w");
+	if (!fp) {
+		if (path)
+			perror(path);
+		enabled = false;
+		closed = true;
+		return;
+	}
+
+	chunk.reserve(TRACE_CHUNK_SIZE + 4096);
+	chunk = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+	flusher = thread(&trace_writer::flush_loop, this);
+}
+
+trace_writer::~trace_writer(void)
+{
+	close();
+}
+
+trace_writer &trace_writer::instance(void)
+{
+	static trace_writer writer(getenv("COSIM_TRACE"));
+	return writer;
+}
+
+void trace_writer::flush_loop(void)
+{
+	unique_lock<mutex> guard(lock);
+
+	while (true) {
+		while (queue.empty() && !stop)
+			cond.wait(guard);
+		if (queue.empty())
+			break;
+
+		string buf;
+		buf.swap(queue.front());
+		queue.pop_front();
+
+		guard.unlock();
+		fwrite(buf.data(), 1, buf.size(), fp);
+		guard.lock();
+	}
+}
+
+void trace_writer::submit(void)
+{
+	{
+		lock_guard<mutex> guard(lock);
+		queue.push_back(string());
+		queue.back().swap(chunk);
+	}
+	cond.notify_one();
+	chunk.reserve(TRACE_CHUNK_SIZE + 4096);
+}
+
+/* Appends s as a quoted JSON string.  */
+void trace_writer::append_string(const char *s)
+{
+	char buf[8];
+
+	chunk += '"';
+	for (; *s; s++) {
+		unsigned char c = *s;
+
+		if (c == '"' || c == '\\') {
+			chunk += '\\';
+			chunk += c;
+		} else if (c < 0x20) {
+			snprintf(buf, sizeof buf, "\\u%04x", c);
+			chunk += buf;
+		} else {
+			chunk += c;
+		}
+	}
+	chunk += '"';
+}
+
+/* Timestamps are in us, with ps resolution.  */
+void trace_writer::begin_event(const char *name, const char *ph, int track,
+			       const sc_time &ts)
+{
+	char buf[96];
+
+	chunk += first ? "{\"name\":" : ",\n{\"name\":";
+	append_string(name);
+	snprintf(buf, sizeof buf,
+		 ",\"ph\":\"%s\",\"pid\":1,\"tid\":%d,\"ts\":%.6f",
+		 ph, track, ts.to_seconds() * 1e6);
+	chunk += buf;
+	first = false;
+}
+
+void trace_writer::end_event(void)
+{
+	chunk += '}';
+	if (chunk.size() >= TRACE_CHUNK_SIZE)
+		submit();
+}
+
+int trace_writer::track(const char *name)
+{
+	int id = next_track++;
+
+	if (closed)
+		return id;
+
+	begin_event("thread_name", "M", id, SC_ZERO_TIME);
+	chunk += ",\"args\":{\"name\":";
+	append_string(name);
+	chunk += "}";
+	end_event();
+	return id;
+}
+
+void trace_writer::complete(int track, const char *name,
+			    const sc_time &start, const sc_time &end,
+			    uint64_t addr, unsigned int len)
+{
+	char buf[96];
+
+	if (closed)
+		return;
+
+	begin_event(name, "X", track, start);
+	snprintf(buf, sizeof buf,
+		 ",\"dur\":%.6f,\"args\":{\"addr\":\"0x%" PRIx64 "\",\"len\":%u}",
+		 (end - start).to_seconds() * 1e6, addr, len);
+	chunk += buf;
+	end_event();
+}
+
+void trace_writer::level(int track, const char *name, bool asserted,
+			 const sc_time &ts)
+{
+	if (closed)
+		return;
+
+	begin_event(name, asserted ? "B" : "E", track, ts);
+	end_event();
+}
+
+void trace_writer::instant(int track, const char *name, const sc_time &ts,
+			   const char *arg_name, uint64_t arg)
+{
+	char buf[32];
+
+	if (closed)
+		return;
+
+	begin_event(name, "i", track, ts);
+	chunk += ",\"s\":\"t\",\"args\":{";
+	append_string(arg_name);
+	snprintf(buf, sizeof buf, ":%" PRIu64 "}", arg);
+	chunk += buf;
+	end_event();
+}
+
+void trace_writer::counter(const char *name, const sc_time &ts,
+			   uint64_t value)
+{
+	char buf[64];
+
+	if (closed)
+		return;
+
+	begin_event(name, "C", 0, ts);
+	snprintf(buf, sizeof buf, ",\"args\":{\"value\":%" PRIu64 "}", value);
+	chunk += buf;
+	end_event();
+}
+
+void trace_writer::close(void)
+{
+	if (closed)
+		return;
+	closed = true;
+
+	chunk += "\n]}\n";
+	submit();
+	{
+		lock_guard<mutex> guard(lock);
+		stop = true;
+	}
+	cond.notify_one();
+	flusher.join();
+	fclose(fp);
+}
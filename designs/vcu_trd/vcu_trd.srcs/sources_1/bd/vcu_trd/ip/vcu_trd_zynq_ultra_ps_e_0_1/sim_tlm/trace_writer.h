@@ -0,0 +1,76 @@
+/*
+ * Chrome/Perfetto JSON trace writer.
+ *
+ * Events are formatted into an in-memory chunk on the simulation thread.
+ * Full chunks are handed to a writer thread, so the simulation never
+ * blocks on file I/O.  Timestamps are SystemC time.  The output loads in
+ * ui.perfetto.dev and chrome://tracing.
+ *
+ * Enabled by setting COSIM_TRACE=<file>.
+ */
+
+#ifndef TRACE_WRITER_H__
+#define TRACE_WRITER_H__
+
+#include <stdint.h>
+#include <stdio.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "systemc.h"
+
+class trace_writer
+{
+private:
+	FILE *fp;
+	std::string chunk;
+	bool first;
+	bool closed;
+	int next_track;
+
+	std::deque<std::string> queue;
+	std::mutex lock;
+	std::condition_variable cond;
+	std::thread flusher;
+	bool stop;
+
+	trace_writer(const char *path);
+	~trace_writer(void);
+	void flush_loop(void);
+	void append_string(const char *s);
+	void begin_event(const char *name, const char *ph, int track,
+			 const sc_core::sc_time &ts);
+	void end_event(void);
+	void submit(void);
+public:
+	static bool enabled;
+	static trace_writer &instance(void);
+
+	/* Allocate a named track (one per port, IRQ line, ...).  */
+	int track(const char *name);
+
+	/* A transaction spanning [start, end) on a track.  */
+	void complete(int track, const char *name,
+		      const sc_core::sc_time &start,
+		      const sc_core::sc_time &end,
+		      uint64_t addr, unsigned int len);
+
+	/* Level changes, drawn as asserted intervals.  */
+	void level(int track, const char *name, bool asserted,
+		   const sc_core::sc_time &ts);
+
+	void instant(int track, const char *name,
+		     const sc_core::sc_time &ts, const char *arg_name,
+		     uint64_t arg);
+
+	void counter(const char *name, const sc_core::sc_time &ts,
+		     uint64_t value);
+
+	/* Write out the remaining events and terminate the file.  */
+	void close(void);
+};
+
+#endif
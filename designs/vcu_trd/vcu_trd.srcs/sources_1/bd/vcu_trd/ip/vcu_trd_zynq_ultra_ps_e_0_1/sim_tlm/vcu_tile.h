@@ -0,0 +1,76 @@
+/*
+ * VCU tiled frame buffer layouts.
+ *
+ * The VCU reads and writes NV12 (4:2:0) and NV16 (4:2:2) frames in DDR
+ * in a tiled layout: each plane is cut into tiles of tile_w x tile_h
+ * samples (64x4 by default), tiles are stored one after the other along
+ * a band of tile_h lines, and bands follow each other down the plane.
+ * 8 bit samples take a byte; 10 bit samples are bit-packed, four to five
+ * bytes, LSB first.  This differs from the linear XV15/XV20 layout (three
+ * samples to a 32 bit word, 4/3 bytes per sample) that vcu_enc_traffic,
+ * vcu_dec_traffic and vcu_bw_check size frames with: a 64 sample tile
+ * row is not a whole number of 32 bit words, so tiled 10 bit frames are
+ * 5/4 bytes per sample, 1/16 smaller than linear ones.
+ *
+ * The linear side is plain NV12/NV16: a luma plane followed by the
+ * interleaved CbCr plane, one byte per 8 bit sample and one little
+ * endian 16 bit word per 10 bit sample (P010/P210 without the shift).
+ *
+ * Kernels exist for AVX2, SSSE3, NEON and plain C; the best one the CPU
+ * supports is picked at run time unless vcu_tile_set_isa() says
+ * otherwise.  Width must be a multiple of tile_w and the plane heights a
+ * multiple of tile_h.
+ */
+
+#ifndef VCU_TILE_H__
+#define VCU_TILE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum vcu_tile_chroma {
+	VCU_TILE_NV12,
+	VCU_TILE_NV16,
+};
+
+enum vcu_tile_isa {
+	VCU_TILE_ISA_AUTO,
+	VCU_TILE_ISA_SCALAR,
+	VCU_TILE_ISA_SSSE3,
+	VCU_TILE_ISA_AVX2,
+	VCU_TILE_ISA_NEON,
+};
+
+struct vcu_tile_format {
+	unsigned int width;
+	unsigned int height;
+	unsigned int bit_depth;		/* 8 or 10 */
+	enum vcu_tile_chroma chroma;
+	unsigned int tile_w;		/* samples */
+	unsigned int tile_h;		/* lines */
+};
+
+/* 64x4 tiles.  */
+void vcu_tile_format_init(struct vcu_tile_format *fmt, unsigned int width,
+			  unsigned int height, unsigned int bit_depth,
+			  enum vcu_tile_chroma chroma);
+
+/* Returns 0 if the format can be converted.  */
+int vcu_tile_format_check(const struct vcu_tile_format *fmt);
+
+size_t vcu_tile_frame_size(const struct vcu_tile_format *fmt);
+size_t vcu_linear_frame_size(const struct vcu_tile_format *fmt);
+
+void vcu_detile(const struct vcu_tile_format *fmt, const uint8_t *tiled,
+		uint8_t *linear);
+void vcu_retile(const struct vcu_tile_format *fmt, const uint8_t *linear,
+		uint8_t *tiled);
+
+/*
+ * Select the kernels.  Returns the ISA in use, which falls back to the
+ * best supported one if the requested ISA is not available.
+ */
+enum vcu_tile_isa vcu_tile_set_isa(enum vcu_tile_isa isa);
+const char *vcu_tile_isa_name(enum vcu_tile_isa isa);
+
+#endif
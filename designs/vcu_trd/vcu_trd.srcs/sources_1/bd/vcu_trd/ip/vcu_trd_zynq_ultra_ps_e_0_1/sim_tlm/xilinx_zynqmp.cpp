@@ -48,6 +48,9 @@ extern "C" {
 };
 #include "xilinx_zynqmp.h"
 #include "genattr.h"
+#include "sc_profiler.h"
+#include "trace_probe.h"
+#include "trace_writer.h"
 #include <sys/types.h>
 
 xilinx_emio_bank::xilinx_emio_bank(const char *name_in, const char *name_out,
@@ -82,6 +85,10 @@ xilinx_zynqmp::xilinx_zynqmp(sc_module_name name, const char *sk_descr)
 	  rp_emio2("emio2", 32, 64),
 	  proxy_in("proxy-in", 9),
 	  proxy_out("proxy-out", 9),
+	  hpm_proxy_in("hpm-proxy-in", 4),
+	  hpm_proxy_out("hpm-proxy-out", 4),
+	  quantum_policy(NULL),
+	  sync_trace(NULL),
 	  pl2ps_irq("pl2ps_irq", 16),
 	  ps2pl_irq("ps2pl_irq", 164),
 	  pl_resetn("pl_resetn", 4)
@@ -108,6 +115,18 @@ xilinx_zynqmp::xilinx_zynqmp(sc_module_name name, const char *sk_descr)
 		&s_axi_acp_fpd,
 		&s_axi_ace_fpd,
 	};
+	tlm_utils::simple_initiator_socket<remoteport_tlm_memory_master> * const masters[] = {
+		&rp_axi_hpm0_fpd.sk,
+		&rp_axi_hpm1_fpd.sk,
+		&rp_axi_hpm_lpd.sk,
+		&rp_lpd_reserved.sk,
+	};
+	tlm_utils::simple_initiator_socket<remoteport_tlm_memory_master> ** const masters_named[] = {
+		&s_axi_hpm_fpd[0],
+		&s_axi_hpm_fpd[1],
+		&s_axi_hpm_lpd,
+		&s_lpd_reserved,
+	};
 	unsigned int i;
 
 	for (i = 0; i < 3; i++) {
@@ -123,11 +142,17 @@ xilinx_zynqmp::xilinx_zynqmp(sc_module_name name, const char *sk_descr)
                                       emio_out_en_name, 32);
 	}
 
-	/* Expose friendly named PS Master ports.  */
-	s_axi_hpm_fpd[0] = &rp_axi_hpm0_fpd.sk;
-	s_axi_hpm_fpd[1] = &rp_axi_hpm1_fpd.sk;
-	s_axi_hpm_lpd = &rp_axi_hpm_lpd.sk;
-	s_lpd_reserved = &rp_lpd_reserved.sk;
+	/* Expose friendly named PS Master ports, through their proxies.  */
+	for (i = 0; i < hpm_proxy_in.size(); i++) {
+		hpm_proxy_in[i].register_b_transport(this,
+						&xilinx_zynqmp::hpm_b_transport,
+						i);
+		hpm_proxy_in[i].register_transport_dbg(this,
+						&xilinx_zynqmp::hpm_transport_dbg,
+						i);
+		masters[i]->bind(hpm_proxy_in[i]);
+		masters_named[i][0] = &hpm_proxy_out[i];
+	}
 
 	// Connect our Master ID injecting proxies.
 	for (i = 0; i < proxy_in.size(); i++) {
@@ -144,6 +169,9 @@ xilinx_zynqmp::xilinx_zynqmp(sc_module_name name, const char *sk_descr)
 		proxy_out[i].bind(*out[i]);
 	}
 
+	if (trace_writer::enabled)
+		sync_trace = new rp_sync_trace(this->name());
+
 	for (i = 0; i < 16; i++) {
 		rp_wires_in.wires_in[i](pl2ps_irq[i]);
 	}
@@ -209,6 +237,17 @@ void xilinx_zynqmp::tie_off(void)
 
 	remoteport_tlm::tie_off();
 
+	for (i = 0; i < hpm_proxy_out.size(); i++) {
+		tlm_utils::simple_target_socket<xilinx_zynqmp> *tieoff_tgt;
+
+		if (hpm_proxy_out[i].size())
+			continue;
+		tieoff_tgt = new tlm_utils::simple_target_socket<xilinx_zynqmp>();
+		tieoff_tgt->register_b_transport(this,
+					&xilinx_zynqmp::tieoff_b_transport);
+		hpm_proxy_out[i].bind(*tieoff_tgt);
+	}
+
 	for (i = 0; i < proxy_in.size(); i++) {
 		if (proxy_in[i].size())
 			continue;
@@ -217,11 +256,32 @@ void xilinx_zynqmp::tie_off(void)
 	}
 }
 
+void xilinx_zynqmp::enable_adaptive_quantum(const sc_time &min,
+					    const sc_time &max,
+					    unsigned int busy_threshold)
+{
+	unsigned int i;
+
+	if (quantum_policy)
+		return;
+
+	quantum_policy = new boundary_quantum("quantum_policy", min, max,
+					      busy_threshold);
+	for (i = 0; i < pl2ps_irq.size(); i++) {
+		quantum_policy->watch(pl2ps_irq[i].value_changed_event());
+	}
+	for (i = 0; i < ps2pl_irq.size(); i++) {
+		quantum_policy->watch(ps2pl_irq[i].value_changed_event());
+	}
+}
+
 xilinx_zynqmp::~xilinx_zynqmp(void)
 {
 	for(int i = 0; i < 3; i++) {
 		delete(emio[i]);
 	}
+	delete quantum_policy;
+	delete sync_trace;
 }
 
 // Modify the Master ID and pass through transactions.
@@ -246,6 +306,13 @@ void xilinx_zynqmp::b_transport(int id,
 		MASTER_ID(0, 2), /* ACP. No TBU. AXI IDs? */
 		MASTER_ID(0, 15), /* ACE. No TBU.  */
 	};
+	static const char *port_name[9] = {
+		"s_axi_hpc0_fpd", "s_axi_hpc1_fpd",
+		"s_axi_hp0_fpd", "s_axi_hp1_fpd",
+		"s_axi_hp2_fpd", "s_axi_hp3_fpd",
+		"s_axi_lpd", "s_axi_acp_fpd", "s_axi_ace_fpd",
+	};
+	SC_PROFILE_SCOPE(port_name[id]);
 	uint64_t mid;
 	genattr_extension *genattr;
 
@@ -261,10 +328,42 @@ void xilinx_zynqmp::b_transport(int id,
 	mid |= master_id[id];
 	genattr->set_master_id(mid);
 
+	if (quantum_policy)
+		quantum_policy->sync(delay);
+
+	SC_PROFILE_SCOPE("remoteport");
 	proxy_out[id]->b_transport(trans, delay);
+	if (sync_trace)
+		sync_trace->mark("pl2ps", sc_time_stamp() + delay);
 }
 
 // Passthrough.
 unsigned int xilinx_zynqmp::transport_dbg(int id, tlm::tlm_generic_payload& trans) {
+	SC_PROFILE_SCOPE("transport_dbg");
 	return proxy_out[id]->transport_dbg(trans);
 }
+
+// PS to PL passthrough, counted by the quantum policy.
+void xilinx_zynqmp::hpm_b_transport(int id,
+				    tlm::tlm_generic_payload& trans,
+				    sc_time &delay)
+{
+	if (quantum_policy)
+		quantum_policy->note_activity();
+	if (sync_trace)
+		sync_trace->mark("ps2pl", sc_time_stamp() + delay);
+	hpm_proxy_out[id]->b_transport(trans, delay);
+}
+
+unsigned int xilinx_zynqmp::hpm_transport_dbg(int id,
+					      tlm::tlm_generic_payload& trans)
+{
+	return hpm_proxy_out[id]->transport_dbg(trans);
+}
+
+// Nothing in the PL behind an unused PS master.
+void xilinx_zynqmp::tieoff_b_transport(tlm::tlm_generic_payload& trans,
+				       sc_time &delay)
+{
+	trans.set_response_status(tlm::TLM_ADDRESS_ERROR_RESPONSE);
+}
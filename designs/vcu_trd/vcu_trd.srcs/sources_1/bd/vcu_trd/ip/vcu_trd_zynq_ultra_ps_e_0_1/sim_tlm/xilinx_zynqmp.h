@@ -41,6 +41,9 @@
 #include "remote_port_tlm_memory_slave.h"
 #include "remote_port_tlm_wires.h"
 #include "wire_splitter.h"
+#include "boundary_quantum.h"
+
+class rp_sync_trace;
 
 class xilinx_emio_bank
 {
@@ -86,16 +89,36 @@ private:
 	sc_vector<tlm_utils::simple_target_socket_tagged<xilinx_zynqmp> > proxy_in;
 	sc_vector<tlm_utils::simple_initiator_socket_tagged<xilinx_zynqmp> > proxy_out;
 
+	/*
+	 * The PS masters are proxied too, so the quantum policy sees the
+	 * PS to PL traffic.
+	 */
+	sc_vector<tlm_utils::simple_target_socket_tagged<xilinx_zynqmp> > hpm_proxy_in;
+	sc_vector<tlm_utils::simple_initiator_socket<remoteport_tlm_memory_master> > hpm_proxy_out;
+
 	/*
 	 * Proxies for friendly named pl_resets.
 	 */
 	wire_splitter *pl_resetn_splitter[4];
 
+	/* Optional adaptive PL quantum, see enable_adaptive_quantum().  */
+	boundary_quantum *quantum_policy;
+
+	/* Remote-port time exchanges, recorded while tracing.  */
+	rp_sync_trace *sync_trace;
+
 	virtual void b_transport(int id,
 				 tlm::tlm_generic_payload& trans,
 				 sc_time& delay);
 	virtual unsigned int transport_dbg(int id,
 					   tlm::tlm_generic_payload& trans);
+	virtual void hpm_b_transport(int id,
+				     tlm::tlm_generic_payload& trans,
+				     sc_time& delay);
+	virtual unsigned int hpm_transport_dbg(int id,
+					       tlm::tlm_generic_payload& trans);
+	void tieoff_b_transport(tlm::tlm_generic_payload& trans,
+				sc_time& delay);
 public:
 	/*
 	 * HPM0 - 1 _FPD.
@@ -151,4 +174,14 @@ public:
 	xilinx_zynqmp(sc_core::sc_module_name name, const char *sk_descr);
 	~xilinx_zynqmp(void);
 	void tie_off(void);
+
+	/*
+	 * Let PS/PL boundary activity drive the quantum PL to PS
+	 * transactions are held against, between min and max; a window with
+	 * busy_threshold boundary events halves it.  The remote-port sync
+	 * interval with QEMU is not affected.  Must be called during
+	 * elaboration.
+	 */
+	void enable_adaptive_quantum(const sc_time &min, const sc_time &max,
+				     unsigned int busy_threshold = 8);
 };
@@ -57,8 +57,16 @@
 #include "tlm_utils/simple_initiator_socket.h"
 #include "tlm_utils/simple_target_socket.h"
 #include <vector>
+#include <map>
+#include <string>
 #include "genattr.h"
 #include "xilinx_zynqmp.h"
+#include "sc_profiler.h"
+#include "trace_writer.h"
+#include "trace_probe.h"
+#include "frame_capture.h"
+#include "irq_concat.h"
+#include "clock_domains.h"
 
 /***************************************************************************************
 *   Global method, get registered with tlm2xtlm bridge
@@ -120,9 +128,15 @@ void add_extensions_to_tlm(const xtlm::aximm_payload* xtlm_pay, tlm::tlm_generic
         return;
     //portion of master ID bits(master_id[5:0]) are derived from the AXI ID(AWID/ARID). (refere Zynq UltraScale+ TRM page.no:414,415)
     //val = (*(uint8_t*)(xtlm_pay->get_axi_id())) && 0x3F;
-    genattr_extension* ext = new genattr_extension;
+    //bridges recycle their payloads, so reuse the extension from the previous burst
+    //instead of allocating (and leaking) a new one for every transaction
+    genattr_extension* ext = NULL;
+    gp->get_extension(ext);
+    if(ext == NULL)  {
+        ext = new genattr_extension;
+        gp->set_extension(ext);
+    }
     ext->set_master_id(val);
-    gp->set_extension(ext);    
     gp->set_streaming_width(gp->get_data_length());
     if(gp->get_command() != tlm::TLM_WRITE_COMMAND)
     {
@@ -187,7 +201,7 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
     // All the model parameters (integer and string) which are configuration parameters 
     // of ZynqUltraScale+ IP propogated from Vivado
     zynq_ultra_ps_e_tlm(sc_core::sc_module_name name,
-    xsc::common::properties&): sc_module(name)//registering module name with parent
+    xsc::common::properties& props): sc_module(name)//registering module name with parent
         ,maxihpm0_lpd_aclk("maxihpm0_lpd_aclk")
         ,saxihpc0_fpd_aclk("saxihpc0_fpd_aclk")
         ,saxihp0_fpd_aclk("saxihp0_fpd_aclk")
@@ -215,7 +229,16 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
         M_AXI_HPM0_LPD_wr_socket = new xtlm::xtlm_aximm_initiator_socket("M_AXI_HPM0_LPD_wr_socket", 32);
         M_AXI_HPM0_LPD_rd_socket = new xtlm::xtlm_aximm_initiator_socket("M_AXI_HPM0_LPD_rd_socket", 32);
 
-        char* tcpip_addr = getenv("COSIM_MACHINE_TCPIP_ADDRESS");
+        //remote-port endpoint is taken from the instance scoped COSIM_MACHINE_TCPIP_ADDRESS
+        //parameter when given, so several PS instances in one process each talk to their own QEMU.
+        //Otherwise fall back to the process wide environment variable.
+        const char* tcpip_addr = NULL;
+        std::map<std::string, std::string>::const_iterator addr_it =
+            props._string_property_map.find("COSIM_MACHINE_TCPIP_ADDRESS");
+        if(addr_it != props._string_property_map.end())
+            tcpip_addr = addr_it->second.c_str();
+        else
+            tcpip_addr = getenv("COSIM_MACHINE_TCPIP_ADDRESS");
         if(tcpip_addr == NULL)  {
             tcpip_addr = "NO_IP_ADDRESS";
             //std::cerr << "ERROR: Environment Variable COSIM_MACHINE_TCPIP_ADDRESS is not specified.\n Please Specify COSIM_MACHINE_TCPIP_ADDRESS for TCP Socket Communication.\n" << std::endl;
@@ -224,6 +247,24 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
         char* skt_name = strdup(tcpip_addr);
         m_zynqmp_tlm_model = new xilinx_zynqmp("xilinx_zynqmp",skt_name);
 
+        //adaptive quantum for PL to PS transactions, enabled when both bounds (in ns) are
+        //given as instance parameters or environment variables; COSIM_PL_QUANTUM_BUSY_THRESHOLD
+        //is the number of boundary events in a quantum that halves it (default 8).
+        //The remote-port sync interval with QEMU is QEMU's sync-quantum and is not changed.
+        long long quantum_min_ns = get_cosim_param(props, "COSIM_PL_QUANTUM_MIN_NS");
+        long long quantum_max_ns = get_cosim_param(props, "COSIM_PL_QUANTUM_MAX_NS");
+        long long quantum_busy = get_cosim_param(props, "COSIM_PL_QUANTUM_BUSY_THRESHOLD");
+        if((quantum_min_ns > 0) && (quantum_max_ns > 0))  {
+            m_zynqmp_tlm_model->enable_adaptive_quantum(sc_time((double)quantum_min_ns, sc_core::SC_NS),
+                                                        sc_time((double)quantum_max_ns, sc_core::SC_NS),
+                                                        (quantum_busy > 0) ? (unsigned int)quantum_busy : 8);
+        }
+
+        //frame buffer capture on HP0-3, when COSIM_CAPTURE is set
+        m_frame_capture = NULL;
+        if(frame_capture::enabled)
+            m_frame_capture = new frame_capture("frame_capture");
+
         m_xtlm2tlm = new xtlm::xaximm_xtlm2tlm*[9];
         m_tlm2xtlm = new xtlm::xaximm_tlm2xtlm*[3];
         for(int index = 0; index < 9; index++)  {
@@ -237,46 +278,61 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
         m_xtlm2tlm[2] = new xtlm::xaximm_xtlm2tlm("S_AXI_HPC0_FPD_xtlm2tlm_bg",32);
         S_AXI_HPC0_FPD_wr_socket->bind(*m_xtlm2tlm[2]->wr_socket);
         S_AXI_HPC0_FPD_rd_socket->bind(*m_xtlm2tlm[2]->rd_socket);
-        m_zynqmp_tlm_model->s_axi_hpc_fpd[0]->bind(m_xtlm2tlm[2]->initiator_socket);
+        bind_traced(m_xtlm2tlm[2]->initiator_socket, bind_timed(*m_zynqmp_tlm_model->s_axi_hpc_fpd[0], "S_AXI_HPC0_FPD", 32), "S_AXI_HPC0_FPD");
 
         //instantiating XTLM2TLM bridge and stiching it between 
         //S_AXI_HP0_FPD_wr_socket/rd_socket sockets to s_axi_hp_fpd[0] target socket of Zynqmp Qemu tlm wrapper
         m_xtlm2tlm[4] = new xtlm::xaximm_xtlm2tlm("S_AXI_HP0_FPD_xtlm2tlm_bg",128);
         S_AXI_HP0_FPD_wr_socket->bind(*m_xtlm2tlm[4]->wr_socket);
         S_AXI_HP0_FPD_rd_socket->bind(*m_xtlm2tlm[4]->rd_socket);
-        m_zynqmp_tlm_model->s_axi_hp_fpd[0]->bind(m_xtlm2tlm[4]->initiator_socket);
+        bind_captured(m_xtlm2tlm[4]->initiator_socket, bind_timed(*m_zynqmp_tlm_model->s_axi_hp_fpd[0], "S_AXI_HP0_FPD", 128), "S_AXI_HP0_FPD");
 
         //instantiating XTLM2TLM bridge and stiching it between 
         //S_AXI_HP1_FPD_wr_socket/rd_socket sockets to s_axi_hp_fpd[1] target socket of Zynqmp Qemu tlm wrapper
         m_xtlm2tlm[5] = new xtlm::xaximm_xtlm2tlm("S_AXI_HP1_FPD_xtlm2tlm_bg",128);
         S_AXI_HP1_FPD_wr_socket->bind(*m_xtlm2tlm[5]->wr_socket);
         S_AXI_HP1_FPD_rd_socket->bind(*m_xtlm2tlm[5]->rd_socket);
-        m_zynqmp_tlm_model->s_axi_hp_fpd[1]->bind(m_xtlm2tlm[5]->initiator_socket);
+        bind_captured(m_xtlm2tlm[5]->initiator_socket, bind_timed(*m_zynqmp_tlm_model->s_axi_hp_fpd[1], "S_AXI_HP1_FPD", 128), "S_AXI_HP1_FPD");
 
         //instantiating XTLM2TLM bridge and stiching it between 
         //S_AXI_HP2_FPD_wr_socket/rd_socket sockets to s_axi_hp_fpd[2] target socket of Zynqmp Qemu tlm wrapper
         m_xtlm2tlm[6] = new xtlm::xaximm_xtlm2tlm("S_AXI_HP2_FPD_xtlm2tlm_bg",128);
         S_AXI_HP2_FPD_wr_socket->bind(*m_xtlm2tlm[6]->wr_socket);
         S_AXI_HP2_FPD_rd_socket->bind(*m_xtlm2tlm[6]->rd_socket);
-        m_zynqmp_tlm_model->s_axi_hp_fpd[2]->bind(m_xtlm2tlm[6]->initiator_socket);
+        bind_captured(m_xtlm2tlm[6]->initiator_socket, bind_timed(*m_zynqmp_tlm_model->s_axi_hp_fpd[2], "S_AXI_HP2_FPD", 128), "S_AXI_HP2_FPD");
 
         //instantiating XTLM2TLM bridge and stiching it between 
         //S_AXI_HP3_FPD_wr_socket/rd_socket sockets to s_axi_hp_fpd[3] target socket of Zynqmp Qemu tlm wrapper
         m_xtlm2tlm[7] = new xtlm::xaximm_xtlm2tlm("S_AXI_HP2_FPD_xtlm2tlm_bg",128);
         S_AXI_HP3_FPD_wr_socket->bind(*m_xtlm2tlm[7]->wr_socket);
         S_AXI_HP3_FPD_rd_socket->bind(*m_xtlm2tlm[7]->rd_socket);
-        m_zynqmp_tlm_model->s_axi_hp_fpd[3]->bind(m_xtlm2tlm[7]->initiator_socket);
+        bind_captured(m_xtlm2tlm[7]->initiator_socket, bind_timed(*m_zynqmp_tlm_model->s_axi_hp_fpd[3], "S_AXI_HP3_FPD", 128), "S_AXI_HP3_FPD");
         
         //instantiating TLM2XTLM bridge and stiching it between 
         //s_axi_hpm_lpd initiator socket of zynqmp Qemu tlm wrapper to M_AXI_HPM0_LPD_wr_socket/rd_socket sockets 
         m_tlm2xtlm[2] = new xtlm::xaximm_tlm2xtlm("M_AXI_HPM0_LPD_tlm2xtlm_bg",32);
         m_tlm2xtlm[2]->wr_socket->bind(*M_AXI_HPM0_LPD_wr_socket);
         m_tlm2xtlm[2]->rd_socket->bind(*M_AXI_HPM0_LPD_rd_socket);
-        m_tlm2xtlm[2]->target_socket.bind(*m_zynqmp_tlm_model->s_axi_hpm_lpd);
+        bind_traced(*m_zynqmp_tlm_model->s_axi_hpm_lpd, bind_timed(m_tlm2xtlm[2]->target_socket, "M_AXI_HPM0_LPD", 32), "M_AXI_HPM0_LPD");
 
         m_zynqmp_tlm_model->tie_off();
 
+        //IRQ edges, when COSIM_TRACE is set
+        m_trace_probe = NULL;
+        if(trace_writer::enabled)   {
+            m_trace_probe = new trace_probe("trace_probe");
+            for(unsigned int i = 0; i < m_zynqmp_tlm_model->pl2ps_irq.size(); i++)
+                m_trace_probe->watch(m_zynqmp_tlm_model->pl2ps_irq[i]);
+            for(unsigned int i = 0; i < m_zynqmp_tlm_model->ps2pl_irq.size(); i++)
+                m_trace_probe->watch(m_zynqmp_tlm_model->ps2pl_irq[i]);
+        }
+        if(frame_capture::enabled)  {
+            for(unsigned int i = 0; i < m_zynqmp_tlm_model->pl2ps_irq.size(); i++)
+                m_frame_capture->watch_irq(i, m_zynqmp_tlm_model->pl2ps_irq[i]);
+        }
+
  
+        m_irq_direct = false;
         SC_METHOD(pl_ps_irq0_method);
         sensitive << pl_ps_irq0 ;
         dont_initialize();
@@ -317,10 +373,93 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
         delete m_tlm2xtlm[2];
         delete[] m_tlm2xtlm;
         delete[] m_xtlm2tlm;
+        for(size_t i = 0; i < m_trace_taps.size(); i++)
+            delete m_trace_taps[i];
+        delete m_trace_probe;
+        for(size_t i = 0; i < m_capture_taps.size(); i++)
+            delete m_capture_taps[i];
+        delete m_frame_capture;
+        for(size_t i = 0; i < m_profile_taps.size(); i++)
+            delete m_profile_taps[i];
+        for(std::map<std::string, beat_timing*>::iterator it = m_beat_timing.begin(); it != m_beat_timing.end(); ++it)
+            delete it->second;
     }
     SC_HAS_PROCESS(zynq_ultra_ps_e_tlm);
 
+    //FREQ_HZ and CLK_DOMAIN of an AXI port, called from the Vivado wrapper
+    void set_clock_domain(const char* port, const clock_domain* domain)   {
+        std::map<std::string, beat_timing*>::iterator it = m_beat_timing.find(port);
+        if(it != m_beat_timing.end())
+            it->second->set_domain(domain);
+    }
+
     private:
+
+    //binds a bridge/PS socket pair, through a profile tap when COSIM_PROFILE is set
+    template<typename INIT, typename TGT>
+    void bind_profiled(INIT& init, TGT& tgt, const char* port)    {
+        if(!sc_profiler::enabled)  {
+            init.bind(tgt);
+            return;
+        }
+        std::string tap_name = std::string(port) + "_profile";
+        profile_tap* tap = new profile_tap(tap_name.c_str(), port);
+        m_profile_taps.push_back(tap);
+        init.bind(tap->target_socket);
+        tap->initiator_socket.bind(tgt);
+    }
+
+    //binds a bridge/PS socket pair, through a trace tap when COSIM_TRACE is set,
+    //then through bind_profiled
+    template<typename INIT, typename TGT>
+    void bind_traced(INIT& init, TGT& tgt, const char* port)    {
+        if(!trace_writer::enabled)  {
+            bind_profiled(init, tgt, port);
+            return;
+        }
+        std::string tap_name = std::string(port) + "_trace";
+        trace_tap* tap = new trace_tap(tap_name.c_str());
+        m_trace_taps.push_back(tap);
+        bind_profiled(init, tap->target_socket, port);
+        tap->initiator_socket.bind(tgt);
+    }
+
+    //binds an HP port through a frame capture tap when COSIM_CAPTURE is set,
+    //then through bind_traced
+    template<typename INIT, typename TGT>
+    void bind_captured(INIT& init, TGT& tgt, const char* port)    {
+        if(!frame_capture::enabled)  {
+            bind_traced(init, tgt, port);
+            return;
+        }
+        std::string tap_name = std::string(port) + "_capture";
+        capture_tap* tap = new capture_tap(tap_name.c_str(), m_frame_capture);
+        m_capture_taps.push_back(tap);
+        tap->initiator_socket.bind(tgt);
+        bind_traced(init, tap->target_socket, port);
+    }
+
+    //puts a beat timing tap in front of tgt when COSIM_BEAT_TIMING is set and
+    //returns what to bind to instead; the tap is timed once set_clock_domain names its clock
+    template<typename TGT>
+    tlm::tlm_target_socket<>& bind_timed(TGT& tgt, const char* port, unsigned int data_width)    {
+        if(!clock_domains::enabled)
+            return tgt;
+        std::string tap_name = std::string(port) + "_timing";
+        beat_timing* tap = new beat_timing(tap_name.c_str(), data_width);
+        m_beat_timing[port] = tap;
+        tap->initiator_socket.bind(tgt);
+        return tap->target_socket;
+    }
+
+    //integer parameter from the instance properties, else from the environment, else 0
+    static long long get_cosim_param(const xsc::common::properties& props, const char* key)   {
+        std::map<std::string, long long>::const_iterator it = props._long_property_map.find(key);
+        if(it != props._long_property_map.end())
+            return it->second;
+        const char* env = getenv(key);
+        return (env != NULL) ? strtoll(env, NULL, 0) : 0;
+    }
     
     //zynqmp tlm wrapper provided by Edgar
     //module with interfaces of standard tlm 
@@ -343,6 +482,20 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
     // Array of size 3
     xtlm::xaximm_tlm2xtlm **m_tlm2xtlm;
 
+    // Transaction taps and IRQ probe, only created while tracing
+    std::vector<trace_tap*> m_trace_taps;
+    trace_probe* m_trace_probe;
+
+    // Beat timing taps by port, only created with COSIM_BEAT_TIMING
+    std::map<std::string, beat_timing*> m_beat_timing;
+
+    // Frame capture and its taps on HP0-3, only created while capturing
+    frame_capture* m_frame_capture;
+    std::vector<capture_tap*> m_capture_taps;
+
+    // Scope taps on every bridge/PS socket pair, only created while profiling
+    std::vector<profile_tap*> m_profile_taps;
+
     // sc_clocks for generating pl clocks
     // output pins pl_clk0..3 are drived by these clocks
     sc_core::sc_clock pl_clk0_clk;
@@ -351,10 +504,18 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
     //Method which is sentive to pl_clk0_clk sc_clock object
     //pl_clk0 pin written based on pl_clk0_clk clock value 
     void trigger_pl_clk0_pin()    {
+        SC_PROFILE_SCOPE("trigger_pl_clk0_pin");
         pl_clk0.write(pl_clk0_clk.read());
     }
 
+    //Set when pl_ps_irq0 is bound to an irq_concat channel that writes
+    //pl2ps_irq itself, see end_of_elaboration
+    bool m_irq_direct;
+
     void pl_ps_irq0_method()    {
+        if(m_irq_direct)
+            return;
+        SC_PROFILE_SCOPE("pl_ps_irq0_method");
         int irq = ((pl_ps_irq0.read().to_uint()) & 0xFF);
         for(int i = 0; i <8; i++)   {
             if(irq & (0x1<<i))  {
@@ -368,15 +529,38 @@ class zynq_ultra_ps_e_tlm : public sc_core::sc_module   {
     //pl_resetn0 output reset pin get toggle when emio bank 2's 31th signal gets toggled
     //EMIO[2] bank 31th(GPIO[95] signal)acts as reset signal to the PL(refer Zynq UltraScale+ TRM, page no:761)
     void pl_resetn0_trigger()   {
+        SC_PROFILE_SCOPE("pl_resetn0_trigger");
         pl_resetn0.write(m_zynqmp_tlm_model->emio[2]->out[31].read());
     }
 
     sc_signal<bool> qemu_rst;
+
+    //An irq_concat on pl_ps_irq0 (the vcu_interrupt xlconcat) drives the
+    //PS interrupt lines directly, so the word is never unpacked here
+    void end_of_elaboration()
+    {
+        irq_concat<1>* concat = dynamic_cast<irq_concat<1>*>(pl_ps_irq0.get_interface());
+        if(concat != NULL && !concat->is_driving())  {
+            concat->drive(m_zynqmp_tlm_model->pl2ps_irq);
+            m_irq_direct = true;
+        }
+    }
+
     void start_of_simulation()
     {
     //temporary fix to drive the enabled reset pin 
         pl_resetn0.write(true);
         qemu_rst.write(false);
+        sc_profiler::instance().start();
+    }
+
+    void end_of_simulation()
+    {
+        sc_profiler::instance().dump();
+        if(trace_writer::enabled)
+            trace_writer::instance().close();
+        if(frame_capture::enabled)
+            m_frame_capture->close();
     }
 
     
@@ -0,0 +1,416 @@
+/*
+ * VCU encoder buffer (ENC_BUFFER) simulator.
+ *
+ * The encoder buffer keeps a band of reference pixels around the current
+ * CTB on chip, so motion search reads hit PL memory instead of DDR.  This
+ * simulator replays motion-compensated reference reads for a stream mix
+ * and a motion vector distribution and reports, per buffer configuration:
+ *
+ *   - the share of reference reads served by the buffer,
+ *   - DDR reference reads per frame with and without the buffer,
+ *   - the BRAM/URAM blocks the buffer costs on the device.
+ *
+ * Buffer model: per reference picture the buffer holds a window of
+ * (CTB + 2 x vertical range) lines around the current CTB.  When that
+ * band spans the whole picture width it is kept from one CTB row to the
+ * next; otherwise it slides along each CTB row and is emptied when the
+ * next row starts.  Reads are counted in 32 byte bursts: a burst inside
+ * the window is loaded from DDR the first time it is read and then served
+ * from the buffer until it leaves the window, and reads outside the
+ * window go to DDR.  Without the buffer every burst of every prediction
+ * block (with its interpolation margin) is read from DDR, so the buffer
+ * can never cost more DDR traffic than no buffer; the tool fails if it
+ * does.
+ *
+ * Motion ranges follow vcu_enc_traffic: MOTION_VEC_RANGE 0/1/2 searches
+ * +/-64x16, +/-128x32 and +/-256x64 pixels.
+ *
+ * Build: g++ -std=c++11 -O2 -o enc_buffer_sim enc_buffer_sim.cpp
+ * Usage: enc_buffer_sim [options]
+ *
+ *   --stream WxH@FPS[xN]  add N streams (default 4 x 1920x1080@60)
+ *   --bframes N           B frames between P frames (2)
+ *   --depth 8|10          bit depth (10)
+ *   --mv-file FILE        "dx dy weight" lines, in pixels
+ *   --mv-scale PX         otherwise Laplacian vectors of this scale (12)
+ *   --sizes KB,KB,...     buffer sizes to sweep (500,1000,2000,2975,4000)
+ *   --ranges R,R,...      motion ranges to sweep (0,1,2)
+ *   --frames N            frames simulated per configuration (8)
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+#define CTB_SIZE	32
+#define PU_SIZE		16
+#define INTERP_TAPS	7	/* 8 tap luma filter */
+#define BURST_BYTES	32
+
+/* xczu7ev: 312 BRAM36 (36 Kib), 96 URAM (288 Kib).  */
+#define BRAM_BYTES	4608
+#define URAM_BYTES	36864
+#define DEVICE_BRAMS	312
+#define DEVICE_URAMS	96
+
+struct stream {
+	unsigned int width;
+	unsigned int height;
+	unsigned int fps;
+	unsigned int count;
+};
+
+struct mv {
+	int dx;
+	int dy;
+	double weight;
+};
+
+struct range {
+	int h;
+	int v;
+};
+
+static const range ranges[] = {
+	{ 64, 16 }, { 128, 32 }, { 256, 64 },
+};
+
+struct result {
+	double hit_bytes;
+	double miss_bytes;
+	double ddr_with;
+	double ddr_without;
+};
+
+static uint32_t rng = 1;
+
+static uint32_t rand32(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return rng;
+}
+
+static double randf(void)
+{
+	return (rand32() + 0.5) / 4294967296.0;
+}
+
+/* Inverse CDF sampling from the table, or a Laplacian.  */
+static void sample_mv(const vector<mv> &table, const vector<double> &cdf,
+		      double scale, int *dx, int *dy)
+{
+	if (!table.empty()) {
+		double u = randf() * cdf.back();
+		size_t lo = 0, hi = cdf.size() - 1;
+
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+
+			if (cdf[mid] < u)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		*dx = table[lo].dx;
+		*dy = table[lo].dy;
+		return;
+	}
+
+	double ux = randf() - 0.5, uy = randf() - 0.5;
+
+	*dx = (int) (-scale * (ux < 0 ? -1 : 1) * log(1 - 2 * fabs(ux)));
+	*dy = (int) (-scale / 2 * (uy < 0 ? -1 : 1) * log(1 - 2 * fabs(uy)));
+}
+
+/* Bytes per pixel over both planes of 4:2:0.  */
+static double pixel_bytes(unsigned int depth)
+{
+	return (depth > 8 ? 4.0 / 3 : 1.0) * 1.5;
+}
+
+static int floor_div(int a, int b)
+{
+	return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+static int clamp(int v, int lo, int hi)
+{
+	return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/*
+ * One configuration over one stream type: capacity in bytes, for
+ * 'frames' frames.  Results are per frame.
+ */
+static result simulate(const stream &s, unsigned int bframes,
+		       unsigned int depth, double capacity, const range &r,
+		       unsigned int frames, const vector<mv> &table,
+		       const vector<double> &cdf, double scale)
+{
+	result res = { 0, 0, 0, 0 };
+	double bpp = pixel_bytes(depth);
+	int burst_px = (int) (BURST_BYTES / bpp);
+	int band = CTB_SIZE + 2 * r.v;
+	unsigned int ctbs_x = (s.width + CTB_SIZE - 1) / CTB_SIZE;
+	unsigned int ctbs_y = (s.height + CTB_SIZE - 1) / CTB_SIZE;
+	int bursts_x = (s.width + burst_px - 1) / burst_px;
+	/* Per reference, the CTB row each burst was loaded in, or -1.  */
+	vector<int> loaded[2];
+	unsigned int f;
+
+	for (f = 0; f < frames; f++) {
+		unsigned int pos = f % (bframes + 1);
+		unsigned int refs = f == 0 ? 0 : (pos == 0 ? 1 : 2);
+		double per_ref;
+		int win_w;
+		bool full_width;
+		unsigned int cx, cy, ref, pu;
+
+		if (!refs)
+			continue;
+
+		/* Window width each reference gets out of the capacity.  */
+		per_ref = capacity / refs;
+		win_w = (int) (per_ref / (band * bpp));
+		if (win_w > (int) s.width)
+			win_w = s.width;
+		full_width = win_w >= (int) s.width;
+
+		for (ref = 0; ref < refs; ref++)
+			loaded[ref].assign((size_t) bursts_x * s.height, -1);
+
+		for (cy = 0; cy < ctbs_y; cy++) {
+			for (cx = 0; cx < ctbs_x; cx++) {
+				int x0 = cx * CTB_SIZE, y0 = cy * CTB_SIZE;
+				/* Window around the CTB.  */
+				int wx0 = x0 - (win_w - CTB_SIZE) / 2;
+				int wx1 = wx0 + win_w;
+				int wy0 = y0 - r.v, wy1 = y0 + CTB_SIZE + r.v;
+
+				if (full_width) {
+					wx0 = -INTERP_TAPS;
+					wx1 = s.width + INTERP_TAPS;
+				}
+
+				for (ref = 0; ref < refs; ref++)
+				for (pu = 0; pu < (CTB_SIZE / PU_SIZE)
+					     * (CTB_SIZE / PU_SIZE); pu++) {
+					int px = x0 + (pu % 2) * PU_SIZE;
+					int py = y0 + (pu / 2) * PU_SIZE;
+					int dx, dy, bx0, bx1, by0, by1, y, b;
+					int bw = PU_SIZE + INTERP_TAPS;
+
+					sample_mv(table, cdf, scale, &dx, &dy);
+					bx0 = px + dx - INTERP_TAPS / 2;
+					by0 = py + dy - INTERP_TAPS / 2;
+					bx1 = bx0 + bw;
+					by1 = by0 + bw;
+
+					for (y = by0; y < by1; y++)
+					for (b = floor_div(bx0, burst_px);
+					     b <= floor_div(bx1 - 1, burst_px);
+					     b++) {
+						int x = b * burst_px;
+						/* Edge padding repeats the
+						 * border bursts.  */
+						int *row = &loaded[ref][
+							clamp(y, 0,
+							      s.height - 1)
+							* bursts_x
+							+ clamp(b, 0,
+								bursts_x - 1)];
+						bool in = win_w >= CTB_SIZE
+							  && y >= wy0
+							  && y < wy1
+							  && x < wx1
+							  && x + burst_px > wx0;
+
+						res.ddr_without += BURST_BYTES;
+						if (in && *row >= 0
+						    && (full_width
+							|| *row == (int) cy)) {
+							res.hit_bytes +=
+								BURST_BYTES;
+							continue;
+						}
+						res.miss_bytes += BURST_BYTES;
+						res.ddr_with += BURST_BYTES;
+						if (in)
+							*row = cy;
+					}
+				}
+			}
+		}
+	}
+
+	res.hit_bytes /= frames;
+	res.miss_bytes /= frames;
+	res.ddr_with /= frames;
+	res.ddr_without /= frames;
+	return res;
+}
+
+static bool parse_stream(const char *arg, stream &s)
+{
+	s.count = 1;
+	return sscanf(arg, "%ux%u@%ux%u", &s.width, &s.height, &s.fps,
+		      &s.count) >= 3;
+}
+
+static bool load_mv_file(const char *path, vector<mv> &table,
+			 vector<double> &cdf)
+{
+	ifstream in(path);
+	string line;
+	double sum = 0;
+
+	if (!in) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+	while (getline(in, line)) {
+		istringstream ss(line);
+		mv m;
+
+		if (line.empty() || line[0] == '#')
+			continue;
+		if (!(ss >> m.dx >> m.dy >> m.weight) || m.weight <= 0)
+			continue;
+		sum += m.weight;
+		table.push_back(m);
+		cdf.push_back(sum);
+	}
+	if (table.empty()) {
+		fprintf(stderr, "%s: no vectors\n", path);
+		return false;
+	}
+	return true;
+}
+
+static vector<double> parse_list(const char *arg)
+{
+	vector<double> v;
+	const char *p = arg;
+
+	while (*p) {
+		char *end;
+
+		v.push_back(strtod(p, &end));
+		if (*end != ',')
+			break;
+		p = end + 1;
+	}
+	return v;
+}
+
+int main(int argc, char *argv[])
+{
+	vector<stream> streams;
+	vector<mv> table;
+	vector<double> cdf;
+	vector<double> sizes = parse_list("500,1000,2000,2975,4000");
+	vector<double> rlist = parse_list("0,1,2");
+	unsigned int bframes = 2, depth = 10, frames = 8;
+	double scale = 12;
+	size_t si, ri, mi, k;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--stream") && i + 1 < argc) {
+			stream s;
+
+			if (!parse_stream(argv[++i], s)) {
+				fprintf(stderr, "bad stream %s\n", argv[i]);
+				return 2;
+			}
+			streams.push_back(s);
+		} else if (!strcmp(argv[i], "--bframes") && i + 1 < argc) {
+			bframes = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "--depth") && i + 1 < argc) {
+			depth = atoi(argv[++i]);
+		} else if (!strcmp(argv[i], "--mv-file") && i + 1 < argc) {
+			if (!load_mv_file(argv[++i], table, cdf))
+				return 2;
+		} else if (!strcmp(argv[i], "--mv-scale") && i + 1 < argc) {
+			scale = atof(argv[++i]);
+		} else if (!strcmp(argv[i], "--sizes") && i + 1 < argc) {
+			sizes = parse_list(argv[++i]);
+		} else if (!strcmp(argv[i], "--ranges") && i + 1 < argc) {
+			rlist = parse_list(argv[++i]);
+		} else if (!strcmp(argv[i], "--frames") && i + 1 < argc) {
+			frames = atoi(argv[++i]);
+		} else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return 2;
+		}
+	}
+	if (streams.empty()) {
+		stream s = { 1920, 1080, 60, 4 };
+
+		streams.push_back(s);
+	}
+	if (frames < bframes + 2)
+		frames = bframes + 2;
+
+	printf("%8s %5s %5s %7s %6s %8s %12s %12s %10s\n",
+	       "size KB", "range", "mem", "blocks", "device", "hit",
+	       "DDR MB/frm", "no-buf MB/frm", "saved MB/s");
+
+	for (si = 0; si < sizes.size(); si++)
+	for (ri = 0; ri < rlist.size(); ri++)
+	for (mi = 0; mi < 2; mi++) {
+		unsigned int rv = (unsigned int) rlist[ri];
+		bool uram = mi == 1;
+		double granule = uram ? URAM_BYTES : BRAM_BYTES;
+		double want = sizes[si] * 1024;
+		unsigned int blocks = (unsigned int) ceil(want / granule);
+		unsigned int device = uram ? DEVICE_URAMS : DEVICE_BRAMS;
+		double capacity = blocks * granule;
+		double hit = 0, miss = 0, with = 0, without = 0, saved = 0;
+		unsigned int nframes = 0;
+
+		if (rv > 2)
+			continue;
+
+		for (k = 0; k < streams.size(); k++) {
+			result res;
+
+			rng = 1;
+			res = simulate(streams[k], bframes, depth, capacity,
+				       ranges[rv], frames, table, cdf, scale);
+			if (res.ddr_with > res.ddr_without) {
+				fprintf(stderr, "%.0f KB range %u: buffer "
+					"costs more DDR than none\n",
+					sizes[si], rv);
+				return 1;
+			}
+			hit += res.hit_bytes * streams[k].count;
+			miss += res.miss_bytes * streams[k].count;
+			with += res.ddr_with * streams[k].count;
+			without += res.ddr_without * streams[k].count;
+			saved += (res.ddr_without - res.ddr_with)
+				 * streams[k].fps * streams[k].count;
+			nframes += streams[k].count;
+		}
+
+		printf("%8.0f %5u %5s %7u %5.0f%% %7.1f%% %12.2f %12.2f "
+		       "%10.0f%s\n",
+		       sizes[si], rv, uram ? "URAM" : "BRAM", blocks,
+		       100.0 * blocks / device,
+		       hit + miss > 0 ? 100 * hit / (hit + miss) : 0,
+		       with / nframes / 1e6, without / nframes / 1e6,
+		       saved / 1e6, blocks > device ? "  (does not fit)" : "");
+	}
+	return 0;
+}
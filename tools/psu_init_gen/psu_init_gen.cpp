@@ -0,0 +1,891 @@
+/*
+ * psu_init table generator.
+ *
+ * psu_init.c programs the PS with one function per init sequence, each a
+ * long run of PSU_Mask_Write() calls between comment blocks, all of which
+ * ends up as code in the FSBL.  This turns the sequences into const
+ * tables of { offset, mask, value, opcode } records and writes
+ *
+ *   psu_init_ops.h   the tables, plain data with no Xilinx headers, so
+ *                    host tools can include them as well (define
+ *                    PSU_INIT_OPS_INDEX for a list of the sequences)
+ *   psu_init_tbl.c   a drop-in replacement for psu_init.c where every
+ *                    converted sequence runs its table through psu_run();
+ *                    everything else is kept as is
+ *
+ * A sequence is converted when its body holds nothing but
+ *
+ *   PSU_Mask_Write(a, m, v);     MASK_WRITE
+ *   Xil_Out32(a, v);             WRITE
+ *   mask_poll(a, m);             POLL until (a & m) == m, m a single bit
+ *   mask_pollOnValue(a, m, v);   POLL until (a & m) == v
+ *   mask_delay(us);              DELAY
+ *   psu_..._data();              CALL of another sequence
+ *   return 1;
+ *
+ * with constant arguments, numbers or psu_init.h macros.  Sequences with
+ * anything else, such as the loops of psu_ddr_phybringup_data(), stay C.
+ *
+ * PSU_Mask_Write() always reads the register back first, and APB reads
+ * are slow.  Unless told otherwise the tables are then optimized:
+ *
+ *   - a MASK_WRITE and the MASK_WRITE right after it to the same register
+ *     become one, if their masks do not overlap (else the first value is
+ *     a step the hardware has to see) and neither touches a PLL BYPASS or
+ *     RESET bit, which must change in order;
+ *   - a MASK_WRITE with a full mask becomes a blind WRITE.
+ *
+ * and dpll_prog(), which does eleven read-modify-writes on the DDR PLL,
+ * is replaced by one that merges its divider and loop settings into one
+ * write per register.  The bus reads saved are reported.
+ *
+ * Build: g++ -std=c++11 -O2 -o psu_init_gen psu_init_gen.cpp
+ * Usage: psu_init_gen [options] psu_init.c psu_init.h
+ *
+ *   -o DIR     write the two files to DIR (.)
+ *   -v         list the sequences and what became of them
+ *   --no-opt   keep every PSU_Mask_Write a read-modify-write
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/* Record opcodes, as in psu_init_ops.h.  */
+enum {
+	OP_END,
+	OP_WRITE,
+	OP_MASK_WRITE,
+	OP_POLL,
+	OP_DELAY,
+	OP_CALL,
+};
+
+static const char *op_names[] = {
+	"PSU_OP_END", "PSU_OP_WRITE", "PSU_OP_MASK_WRITE", "PSU_OP_POLL",
+	"PSU_OP_DELAY", "PSU_OP_CALL",
+};
+
+struct psu_op {
+	uint32_t offset;
+	uint32_t mask;
+	uint32_t value;
+	uint32_t opcode;
+	string reg;		/* register name, for the listing */
+};
+
+struct sequence {
+	string name;
+	size_t first;		/* lines of the definition */
+	size_t last;
+	bool converted;
+	string why;		/* if not */
+	vector<psu_op> ops;
+	size_t reads;		/* MASK_WRITEs as parsed */
+	size_t fused;
+	size_t blind;
+};
+
+struct options {
+	string outdir;
+	bool verbose;
+	bool optimize;
+};
+
+/*
+ * Control bits that sequence the hardware rather than configure it.  A
+ * PLL must be in bypass before its reset is asserted and stay there
+ * until it locks (UG1087), so writes to these are never merged.
+ */
+static const struct {
+	uint32_t offset;
+	uint32_t mask;
+} ordered_bits[] = {
+	{ 0xFD1A0020, 0x00000009 },	/* CRF_APB_APLL_CTRL */
+	{ 0xFD1A002C, 0x00000009 },	/* CRF_APB_DPLL_CTRL */
+	{ 0xFD1A0038, 0x00000009 },	/* CRF_APB_VPLL_CTRL */
+	{ 0xFF5E0020, 0x00000009 },	/* CRL_APB_IOPLL_CTRL */
+	{ 0xFF5E0030, 0x00000009 },	/* CRL_APB_RPLL_CTRL */
+};
+
+static bool read_lines(const char *path, vector<string> &lines)
+{
+	ifstream in(path);
+	string line;
+
+	if (!in) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+	while (getline(in, line)) {
+		if (!line.empty() && line[line.size() - 1] == '\r')
+			line.erase(line.size() - 1);
+		lines.push_back(line);
+	}
+	return true;
+}
+
+static string trim(const string &s)
+{
+	size_t b = s.find_first_not_of(" \t\n");
+	size_t e = s.find_last_not_of(" \t\n");
+
+	if (b == string::npos)
+		return "";
+	return s.substr(b, e - b + 1);
+}
+
+/* A C integer constant such as 0XFF5E0034 or 0x00000001U.  */
+static bool parse_number(const string &s, uint32_t &v)
+{
+	char *end;
+	unsigned long long n;
+
+	if (s.empty() || s[0] < '0' || s[0] > '9')
+		return false;
+	n = strtoull(s.c_str(), &end, 0);
+	while (*end == 'U' || *end == 'u' || *end == 'L' || *end == 'l')
+		end++;
+	if (*end || n > 0xffffffffULL)
+		return false;
+	v = n;
+	return true;
+}
+
+/* "#define NAME number" lines.  Later definitions win, as in cpp.  */
+static void parse_defines(const vector<string> &lines,
+			  map<string, uint32_t> &defs)
+{
+	size_t i;
+
+	for (i = 0; i < lines.size(); i++) {
+		char name[256], value[256];
+		uint32_t v;
+
+		if (sscanf(lines[i].c_str(), " #define %255s %255s",
+			   name, value) == 2
+		    && parse_number(value, v))
+			defs[name] = v;
+	}
+}
+
+static bool is_ident(char c)
+{
+	return c == '_' || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')
+	       || (c >= '0' && c <= '9');
+}
+
+/* The name in "unsigned long NAME(void)", or "".  */
+static string sequence_name(const string &line)
+{
+	static const char prefix[] = "unsigned long ";
+	string s = trim(line);
+	size_t n = sizeof prefix - 1;
+	size_t i;
+
+	if (s.compare(0, n, prefix) != 0
+	    || s.size() < n + 6 || s.compare(s.size() - 6, 6, "(void)") != 0)
+		return "";
+	s = s.substr(n, s.size() - n - 6);
+	for (i = 0; i < s.size(); i++) {
+		if (!is_ident(s[i]))
+			return "";
+	}
+	return s;
+}
+
+static void find_sequences(const vector<string> &lines,
+			   vector<sequence> &seqs)
+{
+	size_t i;
+
+	for (i = 0; i + 1 < lines.size(); i++) {
+		sequence s;
+
+		s.name = sequence_name(lines[i]);
+		if (s.name.empty() || trim(lines[i + 1]) != "{")
+			continue;
+		s.first = i;
+		for (i += 2; i < lines.size() && lines[i] != "}"; i++)
+			;
+		if (i == lines.size())
+			break;
+		s.last = i;
+		s.converted = false;
+		seqs.push_back(s);
+	}
+}
+
+/* Body of a definition with the comments blanked out.  */
+static string body_text(const vector<string> &lines, const sequence &s)
+{
+	string text, out;
+	size_t i;
+
+	for (i = s.first + 2; i < s.last; i++)
+		text += lines[i] + "\n";
+	for (i = 0; i < text.size(); i++) {
+		if (text.compare(i, 2, "/*") == 0) {
+			i = text.find("*/", i + 2);
+			if (i == string::npos)
+				break;
+			i++;
+			out += ' ';
+		} else {
+			out += text[i];
+		}
+	}
+	return out;
+}
+
+static bool eval_arg(const string &arg, const map<string, uint32_t> &defs,
+		     uint32_t &v, string &why)
+{
+	map<string, uint32_t>::const_iterator it;
+
+	if (parse_number(arg, v))
+		return true;
+	it = defs.find(arg);
+	if (it == defs.end()) {
+		why = "not a constant: " + arg;
+		return false;
+	}
+	v = it->second;
+	return true;
+}
+
+/* One statement of a sequence body, without the semicolon.  */
+static bool parse_statement(const string &stmt,
+			    const map<string, uint32_t> &defs,
+			    const set<string> &seq_names,
+			    vector<string> &calls, vector<psu_op> &ops,
+			    string &why)
+{
+	vector<string> args;
+	uint32_t a[3];
+	string fn, rest;
+	size_t i, start;
+	psu_op op;
+
+	if (stmt == "return 1")
+		return true;
+
+	for (i = 0; i < stmt.size() && is_ident(stmt[i]); i++)
+		;
+	fn = stmt.substr(0, i);
+	rest = trim(stmt.substr(i));
+	if (fn.empty() || rest.size() < 2 || rest[0] != '('
+	    || rest[rest.size() - 1] != ')'
+	    || rest.find_first_of("(){}", 1) != rest.size() - 1) {
+		why = "not a plain call: " + stmt;
+		return false;
+	}
+	rest = rest.substr(1, rest.size() - 2);
+	for (start = 0; !trim(rest).empty(); start = i + 1) {
+		i = rest.find(',', start);
+		args.push_back(trim(rest.substr(start, i - start)));
+		if (i == string::npos)
+			break;
+	}
+	if (args.size() > 3) {
+		why = "too many arguments: " + stmt;
+		return false;
+	}
+	for (i = 0; i < args.size(); i++) {
+		if (!eval_arg(args[i], defs, a[i], why))
+			return false;
+	}
+
+	op.offset = 0;
+	op.mask = 0;
+	op.value = 0;
+	if (!args.empty() && args[0].size() > 7
+	    && args[0].compare(args[0].size() - 7, 7, "_OFFSET") == 0)
+		op.reg = args[0].substr(0, args[0].size() - 7);
+
+	if (fn == "PSU_Mask_Write" && args.size() == 3) {
+		op.opcode = OP_MASK_WRITE;
+		op.offset = a[0];
+		op.mask = a[1];
+		op.value = a[2];
+	} else if (fn == "Xil_Out32" && args.size() == 2) {
+		op.opcode = OP_WRITE;
+		op.offset = a[0];
+		op.mask = 0xffffffff;
+		op.value = a[1];
+	} else if (fn == "mask_poll" && args.size() == 2) {
+		/* Any bit set; only the same as a compare for one bit.  */
+		if (!a[1] || (a[1] & (a[1] - 1))) {
+			why = "mask_poll on more than one bit";
+			return false;
+		}
+		op.opcode = OP_POLL;
+		op.offset = a[0];
+		op.mask = a[1];
+		op.value = a[1];
+	} else if (fn == "mask_pollOnValue" && args.size() == 3) {
+		op.opcode = OP_POLL;
+		op.offset = a[0];
+		op.mask = a[1];
+		op.value = a[2];
+	} else if (fn == "mask_delay" && args.size() == 1) {
+		op.opcode = OP_DELAY;
+		op.value = a[0];
+	} else if (seq_names.count(fn) && args.empty()) {
+		op.opcode = OP_CALL;
+		for (i = 0; i < calls.size() && calls[i] != fn; i++)
+			;
+		if (i == calls.size())
+			calls.push_back(fn);
+		op.value = i;
+		op.reg = fn;
+	} else {
+		why = "unknown call: " + stmt;
+		return false;
+	}
+	ops.push_back(op);
+	return true;
+}
+
+static void convert(const vector<string> &lines,
+		    const map<string, uint32_t> &defs,
+		    const set<string> &seq_names, vector<string> &calls,
+		    sequence &s)
+{
+	string text = body_text(lines, s);
+	vector<string> seq_calls = calls;
+	size_t start, end;
+
+	for (start = 0; ; start = end + 1) {
+		end = text.find(';', start);
+		if (end == string::npos) {
+			if (!trim(text.substr(start)).empty()) {
+				s.why = "trailing text";
+				break;
+			}
+			s.converted = true;
+			break;
+		}
+		if (!parse_statement(trim(text.substr(start, end - start)),
+				     defs, seq_names, seq_calls, s.ops,
+				     s.why))
+			break;
+	}
+	if (!s.converted) {
+		s.ops.clear();
+		return;
+	}
+	calls = seq_calls;
+}
+
+static bool ordered(const psu_op &op)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof ordered_bits / sizeof ordered_bits[0]; i++) {
+		if (op.offset == ordered_bits[i].offset
+		    && (op.mask & ordered_bits[i].mask))
+			return true;
+	}
+	return false;
+}
+
+/* Fuses neighbouring read-modify-writes, then drops full mask reads.  */
+static void optimize(sequence &s)
+{
+	vector<psu_op> out;
+	size_t i;
+
+	for (i = 0; i < s.ops.size(); i++) {
+		const psu_op &op = s.ops[i];
+		psu_op *prev = out.empty() ? NULL : &out.back();
+
+		if (prev && op.opcode == OP_MASK_WRITE
+		    && prev->opcode == OP_MASK_WRITE
+		    && prev->offset == op.offset && !(prev->mask & op.mask)
+		    && !ordered(*prev) && !ordered(op)) {
+			prev->value = (prev->value & prev->mask)
+				      | (op.value & op.mask);
+			prev->mask |= op.mask;
+			s.fused++;
+			continue;
+		}
+		out.push_back(op);
+	}
+	for (i = 0; i < out.size(); i++) {
+		if (out[i].opcode == OP_MASK_WRITE
+		    && out[i].mask == 0xffffffff) {
+			out[i].opcode = OP_WRITE;
+			s.blind++;
+		}
+	}
+	s.ops = out;
+}
+
+/*
+ * Lines of the definition starting with head, false if there is none.
+ * The prototype ends in a semicolon, the definition in a brace, on the
+ * same line or the next.
+ */
+static bool find_definition(const vector<string> &lines, const string &head,
+			    size_t &first, size_t &last)
+{
+	size_t i;
+	string s;
+
+	for (i = 0; i < lines.size(); i++) {
+		if (lines[i].compare(0, head.size(), head) != 0)
+			continue;
+		first = i;
+		while (i < lines.size() && lines[i].find(')') == string::npos)
+			i++;
+		if (i == lines.size())
+			return false;
+		s = trim(lines[i]);
+		if (s.empty() || s[s.size() - 1] == ';')
+			continue;
+		if (s[s.size() - 1] != '{'
+		    && (i + 1 == lines.size() || trim(lines[i + 1]) != "{"))
+			continue;
+		while (i < lines.size() && lines[i] != "}")
+			i++;
+		if (i == lines.size())
+			return false;
+		last = i;
+		return true;
+	}
+	return false;
+}
+
+static bool find_dpll_prog(const vector<string> &lines, size_t &first,
+			   size_t &last)
+{
+	return find_definition(lines, "static void dpll_prog(", first, last);
+}
+
+/*
+ * Drops the prototype and definition of the static helper fn when the
+ * C kept in psu_init_tbl.c no longer calls it, so the output builds as
+ * warning free as psu_init.c.  mask_poll() is the case: every call is
+ * lowered to PSU_OP_POLL.
+ */
+static void drop_unused_helper(const vector<string> &lines,
+			       const vector<sequence> &seqs,
+			       const string &fn, vector<bool> &dropped)
+{
+	string head = "static int " + fn + "(";
+	string call = fn + "(";
+	size_t first, last, i, k, at;
+
+	if (!find_definition(lines, head, first, last))
+		return;
+	for (i = 0, k = 0; i < lines.size(); i++) {
+		while (k < seqs.size() && seqs[k].last < i)
+			k++;
+		if ((k < seqs.size() && seqs[k].converted
+		     && i >= seqs[k].first)
+		    || (i >= first && i <= last)
+		    || lines[i].compare(0, head.size(), head) == 0)
+			continue;
+		for (at = lines[i].find(call); at != string::npos;
+		     at = lines[i].find(call, at + 1)) {
+			if (at == 0 || !is_ident(lines[i][at - 1]))
+				return;
+		}
+	}
+
+	for (i = 0; i < lines.size(); i++) {
+		if (lines[i].compare(0, head.size(), head) != 0
+		    && (i < first || i > last))
+			continue;
+		dropped[i] = true;
+		/* And the blank line that separated it.  */
+		if ((i < first || i == last) && i + 1 < lines.size()
+		    && trim(lines[i + 1]).empty())
+			dropped[i + 1] = true;
+	}
+}
+
+/* Read-modify-writes in the dpll_prog() of psu_init.c and below.  */
+#define DPLL_PROG_RMWS		11
+#define DPLL_PROG_FUSED_RMWS	6
+
+static const char dpll_prog_fused[] =
+"/*\n"
+" * dpll_prog() with its read-modify-writes merged by psu_init_gen.  The\n"
+" * divider and loop filter settings only take effect through the reset,\n"
+" * so they go out as one write per register; bypass and reset keep their\n"
+" * own writes, in order.\n"
+" */\n"
+"static void dpll_prog(int ddr_pll_fbdiv, int d_lock_dly, int d_lock_cnt,\n"
+"\tint d_lfhf, int d_cp, int d_res) {\n"
+"\n"
+"\tunsigned int pll_status_regval;\n"
+"\n"
+"\tPSU_Mask_Write(CRF_APB_DPLL_CFG, CRF_APB_DPLL_CFG_LOCK_DLY_MASK |\n"
+"\t\tCRF_APB_DPLL_CFG_LOCK_CNT_MASK | CRF_APB_DPLL_CFG_LFHF_MASK |\n"
+"\t\tCRF_APB_DPLL_CFG_CP_MASK | CRF_APB_DPLL_CFG_RES_MASK,\n"
+"\t\t(d_lock_dly << CRF_APB_DPLL_CFG_LOCK_DLY_SHIFT) |\n"
+"\t\t(d_lock_cnt << CRF_APB_DPLL_CFG_LOCK_CNT_SHIFT) |\n"
+"\t\t(d_lfhf << CRF_APB_DPLL_CFG_LFHF_SHIFT) |\n"
+"\t\t(d_cp << CRF_APB_DPLL_CFG_CP_SHIFT) |\n"
+"\t\t(d_res << CRF_APB_DPLL_CFG_RES_SHIFT));\n"
+"\tPSU_Mask_Write(CRF_APB_DPLL_CTRL,\n"
+"\t\tCRF_APB_DPLL_CTRL_DIV2_MASK | CRF_APB_DPLL_CTRL_FBDIV_MASK,\n"
+"\t\t(1 << CRF_APB_DPLL_CTRL_DIV2_SHIFT) |\n"
+"\t\t(ddr_pll_fbdiv << CRF_APB_DPLL_CTRL_FBDIV_SHIFT));\n"
+"\n"
+"\t/*Setting PLL BYPASS*/\n"
+"\tPSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_BYPASS_MASK,\n"
+"\t\tCRF_APB_DPLL_CTRL_BYPASS_MASK);\n"
+"\t/*Setting PLL RESET*/\n"
+"\tPSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_RESET_MASK,\n"
+"\t\tCRF_APB_DPLL_CTRL_RESET_MASK);\n"
+"\t/*Clearing PLL RESET*/\n"
+"\tPSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_RESET_MASK, 0);\n"
+"\n"
+"\t/*Checking PLL lock*/\n"
+"\tpll_status_regval = 0x00000000;\n"
+"\twhile ((pll_status_regval & CRF_APB_PLL_STATUS_DPLL_LOCK_MASK) !=\n"
+"\t\tCRF_APB_PLL_STATUS_DPLL_LOCK_MASK)\n"
+"\t\tpll_status_regval = Xil_In32(CRF_APB_PLL_STATUS);\n"
+"\n"
+"\t/*Clearing PLL BYPASS*/\n"
+"\tPSU_Mask_Write(CRF_APB_DPLL_CTRL, CRF_APB_DPLL_CTRL_BYPASS_MASK, 0);\n"
+"}\n";
+
+static string hex32(uint32_t v)
+{
+	char buf[16];
+
+	snprintf(buf, sizeof buf, "0x%08XU", v);
+	return buf;
+}
+
+static bool write_header(const string &path, const char *src,
+			 const vector<sequence> &seqs,
+			 const vector<string> &calls)
+{
+	FILE *fp = fopen(path.c_str(), "w");
+	size_t i, j;
+
+	if (!fp) {
+		fprintf(stderr, "%s: cannot create\n", path.c_str());
+		return false;
+	}
+	fprintf(fp,
+"/*\n"
+" * Generated by psu_init_gen from %s, do not edit.\n"
+" *\n"
+" * Each init sequence is a table of records run in order until\n"
+" * PSU_OP_END:\n"
+" *\n"
+" *   PSU_OP_WRITE       offset = value\n"
+" *   PSU_OP_MASK_WRITE  offset = (offset & ~mask) | (value & mask)\n"
+" *   PSU_OP_POLL        until (offset & mask) == value\n"
+" *   PSU_OP_DELAY       wait value us\n"
+" *   PSU_OP_CALL        run sequence number value of psu_calls\n"
+" */\n"
+"\n"
+"#ifndef PSU_INIT_OPS_H__\n"
+"#define PSU_INIT_OPS_H__\n"
+"\n"
+"#include <stdint.h>\n"
+"\n", src);
+	for (i = 0; i < sizeof op_names / sizeof op_names[0]; i++)
+		fprintf(fp, "#define %-24s%zu\n", op_names[i], i);
+	fprintf(fp,
+"\n"
+"struct psu_op {\n"
+"\tuint32_t offset;\n"
+"\tuint32_t mask;\n"
+"\tuint32_t value;\n"
+"\tuint32_t opcode;\n"
+"};\n");
+
+	for (i = 0; i < seqs.size(); i++) {
+		const sequence &s = seqs[i];
+
+		if (!s.converted)
+			continue;
+		fprintf(fp, "\nstatic const struct psu_op %s_ops[] = {\n",
+			s.name.c_str());
+		for (j = 0; j < s.ops.size(); j++) {
+			const psu_op &op = s.ops[j];
+
+			fprintf(fp, "\t{ %s, %s, %s, %s },",
+				hex32(op.offset).c_str(),
+				hex32(op.mask).c_str(),
+				hex32(op.value).c_str(),
+				op_names[op.opcode]);
+			if (!op.reg.empty())
+				fprintf(fp, "\t/* %s */", op.reg.c_str());
+			fprintf(fp, "\n");
+		}
+		fprintf(fp, "\t{ 0, 0, 0, PSU_OP_END },\n};\n");
+	}
+
+	fprintf(fp,
+"\n"
+"#ifdef PSU_INIT_OPS_INDEX\n"
+"static const struct psu_seq {\n"
+"\tconst char *name;\n"
+"\tconst struct psu_op *ops;\n"
+"} psu_seqs[] = {\n");
+	for (i = 0; i < seqs.size(); i++) {
+		if (seqs[i].converted)
+			fprintf(fp, "\t{ \"%s\", %s_ops },\n",
+				seqs[i].name.c_str(), seqs[i].name.c_str());
+	}
+	fprintf(fp,
+"\t{ 0, 0 },\n"
+"};\n"
+"\n"
+"/* PSU_OP_CALL targets, by value.  */\n"
+"static const char *const psu_call_names[] = {\n");
+	for (i = 0; i < calls.size(); i++)
+		fprintf(fp, "\t\"%s\",\n", calls[i].c_str());
+	fprintf(fp,
+"\t0,\n"
+"};\n"
+"#endif\n"
+"\n"
+"#endif\n");
+	fclose(fp);
+	return true;
+}
+
+static const char interpreter[] =
+"/*\n"
+" * Runs a table from psu_init_ops.h.  As in the code it replaces, a poll\n"
+" * that times out does not stop the sequence.\n"
+" */\n"
+"static unsigned long psu_run(const struct psu_op *op)\n"
+"{\n"
+"\tunsigned long status = 1;\n"
+"\n"
+"\tfor (;; op++) {\n"
+"\t\tswitch (op->opcode) {\n"
+"\t\tcase PSU_OP_END:\n"
+"\t\t\treturn status;\n"
+"\t\tcase PSU_OP_WRITE:\n"
+"\t\t\tXil_Out32(op->offset, op->value);\n"
+"\t\t\tbreak;\n"
+"\t\tcase PSU_OP_MASK_WRITE:\n"
+"\t\t\tPSU_Mask_Write(op->offset, op->mask, op->value);\n"
+"\t\t\tbreak;\n"
+"\t\tcase PSU_OP_POLL:\n"
+"\t\t\tmask_pollOnValue(op->offset, op->mask, op->value);\n"
+"\t\t\tbreak;\n"
+"\t\tcase PSU_OP_DELAY:\n"
+"\t\t\tmask_delay(op->value);\n"
+"\t\t\tbreak;\n"
+"\t\tcase PSU_OP_CALL:\n"
+"\t\t\tstatus &= psu_calls[op->value]();\n"
+"\t\t\tbreak;\n"
+"\t\t}\n"
+"\t}\n"
+"}\n"
+"\n";
+
+static bool write_source(const string &path, const char *src,
+			 const vector<string> &lines,
+			 const vector<sequence> &seqs,
+			 const vector<string> &calls, size_t dpll_first,
+			 size_t dpll_last, const vector<bool> &dropped)
+{
+	FILE *fp;
+	size_t i, j, k, first = lines.size();
+	bool banner = false, included = false;
+
+	for (k = 0; k < seqs.size(); k++) {
+		if (seqs[k].converted && seqs[k].first < first)
+			first = seqs[k].first;
+	}
+
+	fp = fopen(path.c_str(), "w");
+	if (!fp) {
+		fprintf(stderr, "%s: cannot create\n", path.c_str());
+		return false;
+	}
+	for (i = 0, k = 0; i < lines.size(); i++) {
+		if (i == first) {
+			fprintf(fp, "/* Targets of PSU_OP_CALL.  */\n");
+			for (j = 0; j < calls.size(); j++)
+				fprintf(fp, "unsigned long %s(void);\n",
+					calls[j].c_str());
+			fprintf(fp, "static unsigned long "
+				"(*const psu_calls[])(void) = {\n");
+			for (j = 0; j < calls.size(); j++)
+				fprintf(fp, "\t%s,\n", calls[j].c_str());
+			fprintf(fp, "\t0,\n};\n\n%s", interpreter);
+		}
+		while (k < seqs.size() && seqs[k].last < i)
+			k++;
+		if (k < seqs.size() && seqs[k].converted
+		    && i >= seqs[k].first) {
+			if (i == seqs[k].first)
+				fprintf(fp, "%s\n{\n"
+					"\treturn psu_run(%s_ops);\n}\n",
+					lines[i].c_str(),
+					seqs[k].name.c_str());
+			continue;
+		}
+		if (i >= dpll_first && i <= dpll_last) {
+			if (i == dpll_first)
+				fprintf(fp, "%s", dpll_prog_fused);
+			continue;
+		}
+		if (dropped[i])
+			continue;
+		if (!banner && lines[i].compare(0, 8, "#include") == 0) {
+			banner = true;
+			fprintf(fp,
+"/*\n"
+" * Generated by psu_init_gen from %s: the init sequences are the\n"
+" * tables of psu_init_ops.h, run by psu_run().\n"
+" */\n", src);
+		}
+		fprintf(fp, "%s\n", lines[i].c_str());
+		if (!included && trim(lines[i]) == "#include \"psu_init.h\"") {
+			fprintf(fp, "#include \"psu_init_ops.h\"\n");
+			included = true;
+		}
+	}
+	fclose(fp);
+	if (!included) {
+		fprintf(stderr, "%s: no #include \"psu_init.h\"\n", src);
+		return false;
+	}
+	return true;
+}
+
+static const char *base_name(const char *path)
+{
+	const char *p = strrchr(path, '/');
+
+	return p ? p + 1 : path;
+}
+
+int main(int argc, char *argv[])
+{
+	vector<string> c_lines, h_lines, calls;
+	map<string, uint32_t> defs;
+	vector<sequence> seqs;
+	vector<bool> dropped;
+	set<string> seq_names;
+	options opt = { ".", false, true };
+	const char *files[2];
+	unsigned int nfiles = 0;
+	size_t i, records = 0, converted = 0, writes = 0;
+	size_t reads = 0, fused = 0, blind = 0;
+	size_t dpll_first, dpll_last;
+	bool dpll = false;
+	int j;
+
+	for (j = 1; j < argc; j++) {
+		if (!strcmp(argv[j], "-o") && j + 1 < argc)
+			opt.outdir = argv[++j];
+		else if (!strcmp(argv[j], "-v"))
+			opt.verbose = true;
+		else if (!strcmp(argv[j], "--no-opt"))
+			opt.optimize = false;
+		else if (nfiles < 2)
+			files[nfiles++] = argv[j];
+		else
+			nfiles = 3;
+	}
+	if (nfiles != 2) {
+		fprintf(stderr, "Usage: %s [-o dir] [-v] [--no-opt] "
+			"psu_init.c psu_init.h\n", argv[0]);
+		return 2;
+	}
+	if (!read_lines(files[0], c_lines) || !read_lines(files[1], h_lines))
+		return 2;
+	dropped.resize(c_lines.size());
+
+	parse_defines(h_lines, defs);
+	parse_defines(c_lines, defs);
+	find_sequences(c_lines, seqs);
+	for (i = 0; i < seqs.size(); i++)
+		seq_names.insert(seqs[i].name);
+	for (i = 0; i < seqs.size(); i++) {
+		sequence &s = seqs[i];
+		size_t k;
+
+		convert(c_lines, defs, seq_names, calls, s);
+		s.reads = 0;
+		s.fused = 0;
+		s.blind = 0;
+		for (k = 0; k < s.ops.size(); k++) {
+			if (s.ops[k].opcode == OP_MASK_WRITE)
+				s.reads++;
+		}
+		if (opt.optimize)
+			optimize(s);
+	}
+	if (opt.optimize)
+		dpll = find_dpll_prog(c_lines, dpll_first, dpll_last);
+	if (!dpll) {
+		dpll_first = c_lines.size();
+		dpll_last = c_lines.size();
+	}
+	drop_unused_helper(c_lines, seqs, "mask_poll", dropped);
+
+	for (i = 0; i < seqs.size(); i++) {
+		const sequence &s = seqs[i];
+		size_t k, n = 0;
+
+		if (s.converted) {
+			converted++;
+			records += s.ops.size() + 1;
+			for (k = 0; k < s.ops.size(); k++) {
+				if (s.ops[k].opcode == OP_WRITE
+				    || s.ops[k].opcode == OP_MASK_WRITE)
+					n++;
+			}
+			writes += n;
+			reads += s.reads;
+			fused += s.fused;
+			blind += s.blind;
+		}
+		if (!opt.verbose)
+			continue;
+		if (s.converted)
+			printf("%-36s %4zu records, %4zu writes, %4zu reads "
+			       "saved\n", s.name.c_str(), s.ops.size() + 1, n,
+			       s.fused + s.blind);
+		else
+			printf("%-36s kept as C: %s\n", s.name.c_str(),
+			       s.why.c_str());
+	}
+
+	if (!write_header(opt.outdir + "/psu_init_ops.h",
+			  base_name(files[0]), seqs, calls)
+	    || !write_source(opt.outdir + "/psu_init_tbl.c",
+			     base_name(files[0]), c_lines, seqs, calls,
+			     dpll_first, dpll_last, dropped))
+		return 1;
+
+	printf("%zu of %zu sequences converted, %zu records (%zu bytes), "
+	       "%zu register writes\n", converted, seqs.size(), records,
+	       records * 16, writes);
+	if (opt.optimize) {
+		printf("bus reads %zu -> %zu: %zu eliminated, %zu by fusing "
+		       "(as many writes), %zu by blind writes\n", reads,
+		       reads - fused - blind, fused + blind, fused, blind);
+		if (dpll)
+			printf("dpll_prog: %d -> %d reads per call\n",
+			       DPLL_PROG_RMWS, DPLL_PROG_FUSED_RMWS);
+	}
+	return 0;
+}
@@ -0,0 +1,546 @@
+/*
+ * VCU bandwidth and reachability checker.
+ *
+ * Cross-checks the VCU AXI masters of a block design against the PS ports
+ * they land on:
+ *
+ *   - vcu_trd.hwh gives each master's address ranges, the PS slave port it
+ *     reaches them through, the port clocks and data widths, and the DDR
+ *     configuration.
+ *   - the VCU .xci gives the configured resolutions and frame rates.
+ *   - psu_init.c gives the AFI FIFO fabric widths actually programmed.
+ *
+ * For each master the required read/write bandwidth is estimated from the
+ * configuration, compared against the port's theoretical capacity, and
+ * the DDR segments assigned to the master through one of its PS ports
+ * must hold its frame buffers.  A master with no DDR segment assigned
+ * (one mapped only to OCM, say) fails.  A pass/fail table is printed;
+ * the exit status is 1 if anything failed.
+ *
+ * Build: g++ -std=c++11 -O2 -o vcu_bw_check vcu_bw_check.cpp
+ * Usage: vcu_bw_check [options] vcu_trd.hwh vcu_trd_vcu_0_1.xci psu_init.c
+ *
+ *   --ref-hit F     decoder reference cache hit rate (0.5)
+ *   --dec-bframes N decoder stream B frames (0)
+ *   --warn F        warn above this port utilization (0.8)
+ *   --mcu-mbps N    MCU firmware traffic, MB/s (50)
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct mem_range {
+	string block;
+	string slave;
+	string memtype;
+	uint64_t base;
+	uint64_t high;
+};
+
+struct vcu_master {
+	string name;
+	unsigned int width;
+	double freq_hz;
+	vector<mem_range> ranges;
+};
+
+struct ps_port {
+	unsigned int width;	/* PSU__SAXIGPn__DATA_WIDTH */
+	double freq_hz;		/* saxi*_aclk */
+	int afi_width;		/* from psu_init.c, -1 if not found */
+};
+
+struct options {
+	double ref_hit;
+	unsigned int dec_bframes;
+	double warn;
+	double mcu_mbps;
+};
+
+/* Value of attr="..." on an XML line, or "" if absent.  */
+static string attr(const string &line, const char *name)
+{
+	string key = string(" ") + name + "=\"";
+	size_t pos = line.find(key);
+	size_t end;
+
+	if (pos == string::npos)
+		return "";
+	pos += key.size();
+	end = line.find('"', pos);
+	return line.substr(pos, end - pos);
+}
+
+/* S_AXI_HP2_FPD -> SAXIGP4 / AFIFM4 index.  */
+static int saxigp_index(const string &slave)
+{
+	static const char *names[] = {
+		"S_AXI_HPC0_FPD", "S_AXI_HPC1_FPD",
+		"S_AXI_HP0_FPD", "S_AXI_HP1_FPD",
+		"S_AXI_HP2_FPD", "S_AXI_HP3_FPD",
+		"S_AXI_LPD",
+	};
+	unsigned int i;
+
+	for (i = 0; i < sizeof names / sizeof names[0]; i++) {
+		if (slave == names[i])
+			return i;
+	}
+	return -1;
+}
+
+static string aclk_port(int gp)
+{
+	static const char *names[] = {
+		"saxihpc0_fpd_aclk", "saxihpc1_fpd_aclk",
+		"saxihp0_fpd_aclk", "saxihp1_fpd_aclk",
+		"saxihp2_fpd_aclk", "saxihp3_fpd_aclk",
+		"saxi_lpd_aclk",
+	};
+	return names[gp];
+}
+
+static bool parse_hwh(const char *path, map<string, vcu_master> &masters,
+		      map<string, string> &vcu_params,
+		      map<string, string> &ps_params,
+		      map<string, double> &ps_clocks)
+{
+	ifstream in(path);
+	string line;
+	string module;
+	vcu_master *cur_bus = NULL;
+
+	if (!in) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+
+	while (getline(in, line)) {
+		if (line.find("<MODULE ") != string::npos) {
+			module = attr(line, "INSTANCE");
+			continue;
+		}
+		if (line.find("</MODULE>") != string::npos) {
+			module.clear();
+			continue;
+		}
+
+		if (module == "vcu_0") {
+			if (line.find("<BUSINTERFACE ") != string::npos) {
+				string name = attr(line, "NAME");
+
+				cur_bus = NULL;
+				if (attr(line, "TYPE") == "MASTER"
+				    && name.compare(0, 6, "M_AXI_") == 0) {
+					cur_bus = &masters[name];
+					cur_bus->name = name;
+					cur_bus->width = atoi(attr(line,
+							"DATAWIDTH").c_str());
+				}
+			} else if (line.find("</BUSINTERFACE>")
+				   != string::npos) {
+				cur_bus = NULL;
+			} else if (line.find("<PARAMETER ") != string::npos) {
+				string name = attr(line, "NAME");
+
+				if (cur_bus && name == "FREQ_HZ")
+					cur_bus->freq_hz = atof(attr(line,
+							"VALUE").c_str());
+				else if (!cur_bus)
+					vcu_params[name] = attr(line, "VALUE");
+			} else if (line.find("<MEMRANGE ") != string::npos) {
+				mem_range r;
+				string m = attr(line, "MASTERBUSINTERFACE");
+
+				r.block = attr(line, "ADDRESSBLOCK");
+				r.slave = attr(line, "SLAVEBUSINTERFACE");
+				r.memtype = attr(line, "MEMTYPE");
+				r.base = strtoull(attr(line,
+						"BASEVALUE").c_str(), NULL, 0);
+				r.high = strtoull(attr(line,
+						"HIGHVALUE").c_str(), NULL, 0);
+				masters[m].name = m;
+				masters[m].ranges.push_back(r);
+			}
+		} else if (module == "zynq_ultra_ps_e_0") {
+			if (line.find("<PARAMETER ") != string::npos) {
+				ps_params[attr(line, "NAME")] =
+					attr(line, "VALUE");
+			} else if (line.find("<PORT ") != string::npos
+				   && !attr(line, "CLKFREQUENCY").empty()) {
+				ps_clocks[attr(line, "NAME")] =
+					atof(attr(line,
+						"CLKFREQUENCY").c_str());
+			}
+		}
+	}
+	return true;
+}
+
+/* HDL_* values from spirit:configurableElementValue entries.  */
+static bool parse_xci(const char *path, map<string, string> &params)
+{
+	static const char *prefixes[] = {
+		"\"MODELPARAM_VALUE.", "\"PARAM_VALUE.",
+	};
+	ifstream in(path);
+	string line;
+	unsigned int i;
+
+	if (!in) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+
+	while (getline(in, line)) {
+		for (i = 0; i < 2; i++) {
+			size_t pos = line.find(prefixes[i]);
+			size_t end, vstart, vend;
+
+			if (pos == string::npos)
+				continue;
+			pos += strlen(prefixes[i]);
+			end = line.find('"', pos);
+			vstart = line.find('>', end) + 1;
+			vend = line.find('<', vstart);
+			if (vstart == 0 || vend == string::npos)
+				continue;
+			params[line.substr(pos, end - pos)] =
+				line.substr(vstart, vend - vstart);
+		}
+	}
+	return true;
+}
+
+/*
+ * AFIFMn_AFIFM_RDCTRL/WRCTRL FABRIC_WIDTH: 0 = 128, 1 = 64, 2 = 32 bits.
+ * Read and write widths are recorded separately and must agree.
+ */
+static bool parse_psu_init(const char *path, ps_port *ports)
+{
+	ifstream in(path);
+	string line;
+
+	if (!in) {
+		fprintf(stderr, "%s: cannot open\n", path);
+		return false;
+	}
+
+	while (getline(in, line)) {
+		size_t pos = line.find("PSU_Mask_Write(AFIFM");
+		unsigned int n, mask, value;
+		char dir[8];
+		int width;
+
+		if (pos == string::npos)
+			continue;
+		if (sscanf(line.c_str() + pos,
+			   "PSU_Mask_Write(AFIFM%u_AFIFM_%2sCTRL_OFFSET, "
+			   "%x%*[U], %x", &n, dir, &mask, &value) != 4)
+			continue;
+		if (n > 6 || !(mask & 3))
+			continue;
+		width = 128 >> (value & 3);
+		if (ports[n].afi_width > 0 && ports[n].afi_width != width)
+			ports[n].afi_width = 0;	/* rd/wr disagree */
+		else
+			ports[n].afi_width = width;
+	}
+	return true;
+}
+
+static unsigned long param(const map<string, string> &xci,
+			   const map<string, string> &hwh,
+			   const char *name, unsigned long def)
+{
+	map<string, string>::const_iterator it;
+
+	it = xci.find(name);
+	if (it != xci.end())
+		return strtoul(it->second.c_str(), NULL, 0);
+	it = hwh.find(name);
+	if (it != hwh.end())
+		return strtoul(it->second.c_str(), NULL, 0);
+	return def;
+}
+
+/* Bytes per picture; HDL_COLOR_FORMAT 0: 4:0:0, 1: 4:2:0, 2: 4:2:2.  */
+static double frame_bytes(unsigned long w, unsigned long h,
+			  unsigned long depth, unsigned long format)
+{
+	double luma = (double) w * h;
+	static const double chroma[] = { 1.0, 1.5, 2.0 };
+
+	/*
+	 * 10 bit samples are packed three to a 32 bit word (linear XV15/XV20).
+	 * Tiled frames pack four to five bytes (tools/vcu_tile), 1/16
+	 * less, so the linear size errs on the safe side.
+	 */
+	if (depth)
+		luma = luma * 4 / 3;
+	return luma * chroma[format > 2 ? 1 : format];
+}
+
+struct demand {
+	double rd;	/* bytes/s */
+	double wr;
+	double footprint;	/* bytes of buffers the master must reach */
+};
+
+int main(int argc, char *argv[])
+{
+	map<string, vcu_master> masters;
+	map<string, string> vcu_params, xci_params, ps_params;
+	map<string, double> ps_clocks;
+	map<string, demand> need;
+	ps_port ports[7];
+	options opt = { 0.5, 0, 0.8, 50 };
+	const char *files[3];
+	unsigned int nfiles = 0;
+	bool failed = false;
+	double ddr_peak, ddr_need = 0;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "--ref-hit") && i + 1 < argc)
+			opt.ref_hit = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--dec-bframes") && i + 1 < argc)
+			opt.dec_bframes = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--warn") && i + 1 < argc)
+			opt.warn = atof(argv[++i]);
+		else if (!strcmp(argv[i], "--mcu-mbps") && i + 1 < argc)
+			opt.mcu_mbps = atof(argv[++i]);
+		else if (nfiles < 3)
+			files[nfiles++] = argv[i];
+		else
+			nfiles = 4;
+	}
+	if (nfiles != 3) {
+		fprintf(stderr, "Usage: %s [options] design.hwh vcu.xci "
+			"psu_init.c\n", argv[0]);
+		return 2;
+	}
+
+	for (i = 0; i < 7; i++) {
+		ports[i].width = 0;
+		ports[i].freq_hz = 0;
+		ports[i].afi_width = -1;
+	}
+	if (!parse_hwh(files[0], masters, vcu_params, ps_params, ps_clocks)
+	    || !parse_xci(files[1], xci_params)
+	    || !parse_psu_init(files[2], ports))
+		return 2;
+
+	for (i = 0; i < 7; i++) {
+		char name[32];
+
+		snprintf(name, sizeof name, "PSU__SAXIGP%d__DATA_WIDTH", i);
+		ports[i].width = atoi(ps_params[name].c_str());
+		ports[i].freq_hz = ps_clocks[aclk_port(i)];
+	}
+
+	/* Encoder: I P B.. GOP, encoder buffer keeps the search band.  */
+	{
+		unsigned long w = param(xci_params, vcu_params,
+					"HDL_FRAME_SIZE_X", 1920);
+		unsigned long h = param(xci_params, vcu_params,
+					"HDL_FRAME_SIZE_Y", 1080);
+		unsigned long fps = param(xci_params, vcu_params,
+					  "HDL_FPS", 60);
+		unsigned long depth = param(xci_params, vcu_params,
+					    "HDL_COLOR_DEPTH", 0);
+		unsigned long fmt = param(xci_params, vcu_params,
+					  "HDL_COLOR_FORMAT", 1);
+		unsigned long streams = param(xci_params, vcu_params,
+					"HDL_NUM_CONCURRENT_STREAMS", 1);
+		unsigned long b = param(xci_params, vcu_params,
+					"HDL_ENC_BUFFER_B_FRAME", 0);
+		unsigned long buf = param(xci_params, vcu_params,
+					  "HDL_ENC_BUFFER_EN", 0);
+		double fb = frame_bytes(w, h, depth, fmt);
+		double refs = (1.0 + 2.0 * b) / (1 + b);
+		double ref_factor = buf ? 1.0 : 3.0;
+		double rate = fb * fps * streams / 2;	/* per port */
+		demand d;
+
+		d.rd = rate * (1 + refs * ref_factor);
+		d.wr = rate / (1 + b);
+		d.footprint = fb * (3 + b + 2) * ((streams + 1) / 2);
+		need["M_AXI_ENC0"] = d;
+		need["M_AXI_ENC1"] = d;
+		printf("encoder: %lu x %lux%lu@%lu, %s bit, %lu B frames, "
+		       "encoder buffer %s\n", streams, w, h, fps,
+		       depth ? "10" : "8", b, buf ? "on" : "off");
+	}
+
+	/* Decoder: two cores on alternate CTB rows, one per port.  */
+	{
+		unsigned long w = param(xci_params, vcu_params,
+					"HDL_DEC_FRAME_SIZE_X", 3840);
+		unsigned long h = param(xci_params, vcu_params,
+					"HDL_DEC_FRAME_SIZE_Y", 2160);
+		unsigned long fps = param(xci_params, vcu_params,
+					  "HDL_DEC_FPS", 60);
+		unsigned long depth = param(xci_params, vcu_params,
+					    "HDL_DEC_COLOR_DEPTH", 0);
+		unsigned long fmt = param(xci_params, vcu_params,
+					  "HDL_DEC_COLOR_FORMAT", 1);
+		unsigned long b = opt.dec_bframes;
+		double fb = frame_bytes(w, h, depth, fmt);
+		double refs = (1.0 + 2.0 * b) / (1 + b);
+		double rate = fb * fps / 2;
+		demand d;
+
+		d.rd = rate * refs * 1.5 * (1.0 - opt.ref_hit);
+		d.wr = rate;
+		d.footprint = fb * 5;
+		need["M_AXI_DEC0"] = d;
+		need["M_AXI_DEC1"] = d;
+		printf("decoder: %lux%lu@%lu, %s bit, reference hit rate "
+		       "%.2f\n", w, h, fps, depth ? "10" : "8", opt.ref_hit);
+	}
+
+	/* MCU firmware and mailbox traffic.  */
+	{
+		demand d;
+
+		d.rd = opt.mcu_mbps * 1e6 * 0.8;
+		d.wr = opt.mcu_mbps * 1e6 * 0.2;
+		d.footprint = 1 << 20;
+		need["M_AXI_MCU"] = d;
+	}
+
+	/* DDR4_1600J x 64 bit.  */
+	{
+		string bin = ps_params["PSU__DDRC__SPEED_BIN"];
+		size_t pos = bin.find('_');
+		double mts = pos == string::npos ? 0 :
+			     atof(bin.c_str() + pos + 1);
+		double bus = atof(ps_params["PSU__DDRC__BUS_WIDTH"].c_str());
+
+		ddr_peak = mts * 1e6 * bus / 8;
+	}
+
+	printf("\n%-11s %-15s %5s %8s %11s %11s %5s  %-24s %s\n",
+	       "master", "port", "width", "MHz", "cap MB/s", "need rd/wr",
+	       "util", "reach", "result");
+
+	map<string, vcu_master>::const_iterator it;
+
+	for (it = masters.begin(); it != masters.end(); ++it) {
+		const vcu_master &m = it->second;
+		const demand &d = need[m.name];
+		string slave, reach, result = "PASS";
+		vector<string> slaves;
+		map<string, uint64_t> ddr_by_slave;
+		uint64_t ddr_bytes = 0;
+		unsigned int width;
+		double freq, cap, util;
+		int gp = -1;
+		size_t r;
+		char buf[64];
+
+		if (need.find(m.name) == need.end())
+			continue;
+
+		for (r = 0; r < m.ranges.size(); r++) {
+			const mem_range &mr = m.ranges[r];
+			uint64_t size = mr.high - mr.base + 1;
+
+			if (!ddr_by_slave.count(mr.slave)) {
+				slaves.push_back(mr.slave);
+				ddr_by_slave[mr.slave] = 0;
+			}
+			if (mr.memtype == "MEMORY"
+			    && mr.block.find("DDR") != string::npos)
+				ddr_by_slave[mr.slave] += size;
+			if (!reach.empty())
+				reach += ",";
+			snprintf(buf, sizeof buf, "%s %llu MiB",
+				 mr.block.c_str(),
+				 (unsigned long long) (size >> 20));
+			reach += buf;
+		}
+		/*
+		 * Judge the master on the PS port through which it reaches
+		 * the most DDR, else on the first PS port it reaches.
+		 */
+		for (r = 0; r < slaves.size(); r++) {
+			uint64_t n = ddr_by_slave[slaves[r]];
+
+			if (n > ddr_bytes
+			    || (ddr_bytes == 0 && gp < 0
+				&& saxigp_index(slaves[r]) >= 0)) {
+				slave = slaves[r];
+				ddr_bytes = n;
+				gp = saxigp_index(slave);
+			}
+		}
+		if (slave.empty() && !slaves.empty())
+			slave = slaves[0];
+
+		/* The narrowest of master, PS port and AFI FIFO limits.  */
+		width = m.width;
+		freq = m.freq_hz;
+		if (gp >= 0) {
+			if (ports[gp].width && ports[gp].width < width)
+				width = ports[gp].width;
+			if (ports[gp].freq_hz && ports[gp].freq_hz < freq)
+				freq = ports[gp].freq_hz;
+		}
+		/* AXI reads and writes have independent channels.  */
+		cap = width / 8 * freq;
+		util = cap > 0 ? max(d.rd, d.wr) / cap : 1e9;
+		ddr_need += d.rd + d.wr;
+
+		if (gp < 0) {
+			result = "FAIL: not mapped to a PS port";
+		} else if (ports[gp].afi_width == 0) {
+			result = "FAIL: AFI rd/wr widths differ";
+		} else if (ports[gp].afi_width > 0
+			   && (unsigned int) ports[gp].afi_width
+			      != ports[gp].width) {
+			snprintf(buf, sizeof buf,
+				 "FAIL: AFI programmed %d bit",
+				 ports[gp].afi_width);
+			result = buf;
+		} else if (ddr_bytes == 0) {
+			/* Only the assigned windows are reachable.  */
+			result = "FAIL: no DDR segment assigned";
+		} else if (ddr_bytes < d.footprint) {
+			snprintf(buf, sizeof buf,
+				 "FAIL: buffers need %.0f MiB",
+				 d.footprint / (1 << 20));
+			result = buf;
+		} else if (util > 1.0) {
+			result = "FAIL: over capacity";
+		} else if (util > opt.warn) {
+			result = "WARN: little headroom";
+		}
+		if (result.compare(0, 4, "FAIL") == 0)
+			failed = true;
+
+		snprintf(buf, sizeof buf, "%.0f/%.0f", d.rd / 1e6,
+			 d.wr / 1e6);
+		printf("%-11s %-15s %5u %8.1f %11.0f %11s %4.0f%%  %-24s %s\n",
+		       m.name.c_str(), slave.c_str(), width, freq / 1e6,
+		       cap / 1e6, buf, util * 100, reach.c_str(),
+		       result.c_str());
+	}
+
+	printf("\nDDR: %.0f MB/s needed of %.0f MB/s peak (%.0f%%) %s\n",
+	       ddr_need / 1e6, ddr_peak / 1e6,
+	       ddr_peak > 0 ? ddr_need / ddr_peak * 100 : 0,
+	       ddr_need > ddr_peak * opt.warn ? "WARN" : "PASS");
+
+	return failed ? 1 : 0;
+}
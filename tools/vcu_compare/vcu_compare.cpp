@@ -0,0 +1,965 @@
+/*
+ * VCU golden frame comparator.
+ *
+ * Compares a sequence of frames against a golden sequence and prints, per
+ * plane, PSNR, SSIM and the largest absolute sample difference, followed
+ * by a pass/fail verdict.  Meant as the last step of a VCU regression or
+ * cosim run: a 4096x2160 10 bit frame takes a few milliseconds.
+ *
+ * Inputs are Y4M files (read as a stream, so "-" or a pipe works) or raw
+ * files, which are mapped with mmap.  A raw file is given as FMT:path,
+ * with FMT one of
+ *
+ *   i420, i422   planar YUV
+ *   nv12, nv16   luma plane followed by interleaved CbCr
+ *   tnv12, tnv16 VCU 64x4 tiled NV12/NV16, as dumped from DDR
+ *
+ * Raw 10 bit frames hold one little endian 16 bit word per sample, like
+ * 10 bit Y4M, except the tiled formats which are bit-packed.
+ *
+ * SSIM follows x264: 8x8 windows on a 4x4 grid, no weighting.  Sums over
+ * 4x4 blocks and squared errors are computed with AVX2 when the CPU has
+ * it.  Each frame is cut into 64 line tiles per plane, shared out across
+ * threads.
+ *
+ * Build: g++ -std=c++11 -O2 -pthread -I../vcu_tile -o vcu_compare \
+ *            vcu_compare.cpp ../vcu_tile/vcu_tile.cpp
+ * Usage: vcu_compare [options] <golden> <test>
+ *
+ *   --size WxH         raw frame size
+ *   --depth 8|10       raw bit depth (8)
+ *   --frames N         compare at most N frames
+ *   --skip N           skip N frames of the test sequence
+ *   --threads N        worker threads (all CPUs)
+ *   --min-psnr DB      fail if any plane of any frame is below (none)
+ *   --min-ssim S       fail if any plane of any frame is below (none)
+ *   --max-diff N       fail if any sample differs by more (none)
+ *   --per-frame        print every frame
+ *   --scalar           do not use AVX2
+ *
+ * The exit status is 0 on PASS, 1 on FAIL and 2 on errors.
+ */
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "vcu_tile.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define COMPARE_X86 1
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/* Lines per tile; a multiple of the 4 line SSIM grid.  */
+#define TILE_LINES 64
+#define PSNR_CAP 100.0
+
+enum layout {
+	LAYOUT_PLANAR,
+	LAYOUT_NV,
+	LAYOUT_TILED,
+};
+
+struct plane {
+	const uint8_t *data;
+	size_t stride;		/* bytes */
+	unsigned int width;
+	unsigned int height;
+};
+
+struct frame {
+	plane p[3];
+};
+
+struct plane_stats {
+	uint64_t sse;
+	unsigned int max_diff;
+	double ssim_sum;
+	uint64_t ssim_windows;
+};
+
+/*
+ * A frame sequence.  Raw files are mapped whole; Y4M is read frame by
+ * frame.  NV and tiled frames are converted to planar in scratch buffers,
+ * planar raw frames are used in place.
+ */
+class source
+{
+private:
+	string path;
+	FILE *fp;
+	const uint8_t *map;
+	size_t map_size;
+	size_t frame_size;
+	size_t pos;
+	vector<uint8_t> buf;
+	vector<uint8_t> linear;
+	vector<uint8_t> planar_chroma;
+
+	bool open_y4m(void);
+	bool open_raw(const string &fmt);
+	void setup_planes(const uint8_t *base, frame &f);
+public:
+	unsigned int width;
+	unsigned int height;
+	unsigned int depth;
+	bool chroma422;
+	bool y4m;
+	enum layout layout;
+
+	source(void);
+	~source(void);
+	bool open(const string &spec, unsigned int w, unsigned int h,
+		  unsigned int d);
+	/* False at the end of the sequence.  */
+	bool next(frame &f);
+	string describe(void) const;
+};
+
+source::source(void)
+	: fp(NULL),
+	  map(NULL),
+	  map_size(0),
+	  frame_size(0),
+	  pos(0),
+	  width(0),
+	  height(0),
+	  depth(8),
+	  chroma422(false),
+	  y4m(false),
+	  layout(LAYOUT_PLANAR)
+{
+}
+
+source::~source(void)
+{
+	if (map)
+		munmap((void *) map, map_size);
+	if (fp && fp != stdin)
+		fclose(fp);
+}
+
+static size_t bytes_per_sample(unsigned int depth)
+{
+	return depth > 8 ? 2 : 1;
+}
+
+bool source::open(const string &spec, unsigned int w, unsigned int h,
+		  unsigned int d)
+{
+	size_t colon = spec.find(':');
+	string fmt;
+
+	if (colon != string::npos && colon < 6) {
+		fmt = spec.substr(0, colon);
+		path = spec.substr(colon + 1);
+	} else {
+		path = spec;
+	}
+
+	if (fmt.empty()) {
+		y4m = true;
+		return open_y4m();
+	}
+
+	width = w;
+	height = h;
+	depth = d;
+	if (!width || !height) {
+		fprintf(stderr, "%s: raw input needs --size\n", path.c_str());
+		return false;
+	}
+	return open_raw(fmt);
+}
+
+bool source::open_y4m(void)
+{
+	char line[256];
+	char *tok, *save;
+	string cs = "420";
+
+	fp = path == "-" ? stdin : fopen(path.c_str(), "rb");
+	if (!fp) {
+		perror(path.c_str());
+		return false;
+	}
+	if (!fgets(line, sizeof line, fp) || strncmp(line, "YUV4MPEG2 ", 10)) {
+		fprintf(stderr, "%s: not a Y4M file (raw inputs are FMT:path)\n",
+			path.c_str());
+		return false;
+	}
+
+	for (tok = strtok_r(line + 10, " \n", &save); tok;
+	     tok = strtok_r(NULL, " \n", &save)) {
+		if (tok[0] == 'W')
+			width = atoi(tok + 1);
+		else if (tok[0] == 'H')
+			height = atoi(tok + 1);
+		else if (tok[0] == 'C')
+			cs = tok + 1;
+	}
+
+	if (cs == "420" || cs == "420jpeg" || cs == "420mpeg2" ||
+	    cs == "420paldv" || cs == "422") {
+		depth = 8;
+	} else if (cs == "420p10" || cs == "422p10") {
+		depth = 10;
+	} else {
+		fprintf(stderr, "%s: unsupported colorspace C%s\n",
+			path.c_str(), cs.c_str());
+		return false;
+	}
+	chroma422 = cs.compare(0, 3, "422") == 0;
+	if (!width || !height || width % 2 || (!chroma422 && height % 2)) {
+		fprintf(stderr, "%s: bad frame size %ux%u\n",
+			path.c_str(), width, height);
+		return false;
+	}
+
+	frame_size = (size_t) width * height * bytes_per_sample(depth) *
+		     (chroma422 ? 2 : 3) / (chroma422 ? 1 : 2);
+	buf.resize(frame_size);
+	return true;
+}
+
+bool source::open_raw(const string &fmt)
+{
+	struct vcu_tile_format tf;
+	struct stat st;
+	int fd;
+
+	if (fmt == "i420" || fmt == "i422") {
+		layout = LAYOUT_PLANAR;
+	} else if (fmt == "nv12" || fmt == "nv16") {
+		layout = LAYOUT_NV;
+	} else if (fmt == "tnv12" || fmt == "tnv16") {
+		layout = LAYOUT_TILED;
+	} else {
+		fprintf(stderr, "unknown raw format %s\n", fmt.c_str());
+		return false;
+	}
+	chroma422 = fmt == "i422" || fmt == "nv16" || fmt == "tnv16";
+
+	if (depth != 8 && depth != 10) {
+		fprintf(stderr, "depth must be 8 or 10\n");
+		return false;
+	}
+	if (width % 2 || (!chroma422 && height % 2)) {
+		fprintf(stderr, "bad frame size %ux%u\n", width, height);
+		return false;
+	}
+
+	vcu_tile_format_init(&tf, width, height, depth,
+			     chroma422 ? VCU_TILE_NV16 : VCU_TILE_NV12);
+	if (layout == LAYOUT_TILED) {
+		if (vcu_tile_format_check(&tf)) {
+			fprintf(stderr, "%ux%u does not fit the 64x4 tile grid\n",
+				width, height);
+			return false;
+		}
+		frame_size = vcu_tile_frame_size(&tf);
+		linear.resize(vcu_linear_frame_size(&tf));
+	} else {
+		frame_size = vcu_linear_frame_size(&tf);
+	}
+	if (layout != LAYOUT_PLANAR)
+		planar_chroma.resize(vcu_linear_frame_size(&tf) -
+				     (size_t) width * height * bytes_per_sample(depth));
+
+	fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) < 0) {
+		perror(path.c_str());
+		if (fd >= 0)
+			close(fd);
+		return false;
+	}
+	map_size = st.st_size;
+	if (map_size < frame_size) {
+		fprintf(stderr, "%s: shorter than one %ux%u frame\n",
+			path.c_str(), width, height);
+		close(fd);
+		return false;
+	}
+	map = (const uint8_t *) mmap(NULL, map_size, PROT_READ, MAP_PRIVATE,
+				     fd, 0);
+	close(fd);
+	if (map == MAP_FAILED) {
+		map = NULL;
+		perror(path.c_str());
+		return false;
+	}
+	madvise((void *) map, map_size, MADV_SEQUENTIAL);
+	if (map_size % frame_size)
+		fprintf(stderr, "%s: ignoring %zu trailing bytes\n",
+			path.c_str(), map_size % frame_size);
+	return true;
+}
+
+/* Split interleaved CbCr into Cb then Cr.  */
+static void deinterleave(const uint8_t *src, uint8_t *dst, size_t pairs,
+			 unsigned int bps)
+{
+	uint8_t *u = dst, *v = dst + pairs * bps;
+	size_t i;
+
+	if (bps == 1) {
+		for (i = 0; i < pairs; i++) {
+			u[i] = src[2 * i];
+			v[i] = src[2 * i + 1];
+		}
+	} else {
+		const uint16_t *s = (const uint16_t *) src;
+
+		for (i = 0; i < pairs; i++) {
+			((uint16_t *) u)[i] = s[2 * i];
+			((uint16_t *) v)[i] = s[2 * i + 1];
+		}
+	}
+}
+
+void source::setup_planes(const uint8_t *base, frame &f)
+{
+	unsigned int bps = bytes_per_sample(depth);
+	unsigned int cw = width / 2;
+	unsigned int ch = chroma422 ? height : height / 2;
+	size_t luma = (size_t) width * height * bps;
+	const uint8_t *chroma = base + luma;
+
+	if (layout != LAYOUT_PLANAR) {
+		deinterleave(chroma, &planar_chroma[0], (size_t) cw * ch, bps);
+		chroma = &planar_chroma[0];
+	}
+
+	f.p[0].data = base;
+	f.p[0].stride = (size_t) width * bps;
+	f.p[0].width = width;
+	f.p[0].height = height;
+	f.p[1].data = chroma;
+	f.p[2].data = chroma + (size_t) cw * ch * bps;
+	f.p[1].stride = f.p[2].stride = (size_t) cw * bps;
+	f.p[1].width = f.p[2].width = cw;
+	f.p[1].height = f.p[2].height = ch;
+}
+
+bool source::next(frame &f)
+{
+	const uint8_t *base;
+
+	if (y4m) {
+		char line[256];
+
+		if (!fgets(line, sizeof line, fp))
+			return false;
+		if (strncmp(line, "FRAME", 5)) {
+			fprintf(stderr, "%s: lost FRAME sync\n", path.c_str());
+			return false;
+		}
+		if (fread(&buf[0], 1, frame_size, fp) != frame_size)
+			return false;
+		setup_planes(&buf[0], f);
+		return true;
+	}
+
+	if (pos + frame_size > map_size)
+		return false;
+	base = map + pos;
+	pos += frame_size;
+
+	if (layout == LAYOUT_TILED) {
+		struct vcu_tile_format tf;
+
+		vcu_tile_format_init(&tf, width, height, depth,
+				     chroma422 ? VCU_TILE_NV16 : VCU_TILE_NV12);
+		vcu_detile(&tf, base, &linear[0]);
+		base = &linear[0];
+	}
+	setup_planes(base, f);
+	return true;
+}
+
+string source::describe(void) const
+{
+	char s[64];
+
+	snprintf(s, sizeof s, "%ux%u %s %u-bit", width, height,
+		 chroma422 ? "4:2:2" : "4:2:0", depth);
+	return s;
+}
+
+/* Kernels.  */
+
+struct block_sums {
+	/* Per 4x4 block along a row of blocks.  */
+	vector<int32_t> s1, s2, ss, s12;
+
+	void resize(size_t n)
+	{
+		s1.resize(n);
+		s2.resize(n);
+		ss.resize(n);
+		s12.resize(n);
+	}
+};
+
+template<typename T>
+static void sse_row_c(const uint8_t *a8, const uint8_t *b8, unsigned int n,
+		      uint64_t *sse, unsigned int *max_diff)
+{
+	const T *a = (const T *) a8, *b = (const T *) b8;
+	uint64_t s = 0;
+	unsigned int m = *max_diff;
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		int d = (int) a[i] - (int) b[i];
+		unsigned int ad = d < 0 ? -d : d;
+
+		s += (uint64_t) (d * d);
+		if (ad > m)
+			m = ad;
+	}
+	*sse += s;
+	*max_diff = m;
+}
+
+template<typename T>
+static void block_row_c(const uint8_t *a8, size_t astride,
+			const uint8_t *b8, size_t bstride,
+			unsigned int first, unsigned int nblocks,
+			block_sums &out)
+{
+	unsigned int bx, x, y;
+
+	for (bx = first; bx < nblocks; bx++) {
+		int32_t s1 = 0, s2 = 0, ss = 0, s12 = 0;
+
+		for (y = 0; y < 4; y++) {
+			const T *a = (const T *) (a8 + y * astride) + bx * 4;
+			const T *b = (const T *) (b8 + y * bstride) + bx * 4;
+
+			for (x = 0; x < 4; x++) {
+				s1 += a[x];
+				s2 += b[x];
+				ss += a[x] * a[x] + b[x] * b[x];
+				s12 += a[x] * b[x];
+			}
+		}
+		out.s1[bx] = s1;
+		out.s2[bx] = s2;
+		out.ss[bx] = ss;
+		out.s12[bx] = s12;
+	}
+}
+
+#ifdef COMPARE_X86
+
+__attribute__((target("avx2")))
+static inline uint64_t hsum_epi32(__m256i v)
+{
+	int32_t t[8];
+	uint64_t s = 0;
+	unsigned int i;
+
+	_mm256_storeu_si256((__m256i *) t, v);
+	for (i = 0; i < 8; i++)
+		s += (uint32_t) t[i];
+	return s;
+}
+
+__attribute__((target("avx2")))
+static void sse_row8_avx2(const uint8_t *a, const uint8_t *b, unsigned int n,
+			  uint64_t *sse, unsigned int *max_diff)
+{
+	__m256i acc = _mm256_setzero_si256();
+	__m256i vmax = _mm256_setzero_si256();
+	uint8_t m[32];
+	unsigned int i;
+
+	/* 2 x 255^2 per lane per step, 256 steps stay below 2^31.  */
+	for (i = 0; i + 32 <= n; i += 32) {
+		__m256i va = _mm256_loadu_si256((const __m256i *) (a + i));
+		__m256i vb = _mm256_loadu_si256((const __m256i *) (b + i));
+		__m256i d = _mm256_or_si256(_mm256_subs_epu8(va, vb),
+					    _mm256_subs_epu8(vb, va));
+		__m256i lo = _mm256_unpacklo_epi8(d, _mm256_setzero_si256());
+		__m256i hi = _mm256_unpackhi_epi8(d, _mm256_setzero_si256());
+
+		vmax = _mm256_max_epu8(vmax, d);
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(lo, lo));
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(hi, hi));
+		if ((i / 32) % 256 == 255) {
+			*sse += hsum_epi32(acc);
+			acc = _mm256_setzero_si256();
+		}
+	}
+	*sse += hsum_epi32(acc);
+
+	_mm256_storeu_si256((__m256i *) m, vmax);
+	for (unsigned int j = 0; j < 32; j++)
+		*max_diff = max<unsigned int>(*max_diff, m[j]);
+	sse_row_c<uint8_t>(a + i, b + i, n - i, sse, max_diff);
+}
+
+__attribute__((target("avx2")))
+static void sse_row16_avx2(const uint8_t *a8, const uint8_t *b8,
+			   unsigned int n, uint64_t *sse,
+			   unsigned int *max_diff)
+{
+	const uint16_t *a = (const uint16_t *) a8, *b = (const uint16_t *) b8;
+	__m256i acc = _mm256_setzero_si256();
+	__m256i vmax = _mm256_setzero_si256();
+	uint16_t m[16];
+	unsigned int i;
+
+	/* 2 x 1023^2 per lane per step, 256 steps stay below 2^31.  */
+	for (i = 0; i + 16 <= n; i += 16) {
+		__m256i va = _mm256_loadu_si256((const __m256i *) (a + i));
+		__m256i vb = _mm256_loadu_si256((const __m256i *) (b + i));
+		__m256i d = _mm256_abs_epi16(_mm256_sub_epi16(va, vb));
+
+		vmax = _mm256_max_epu16(vmax, d);
+		acc = _mm256_add_epi32(acc, _mm256_madd_epi16(d, d));
+		if ((i / 16) % 256 == 255) {
+			*sse += hsum_epi32(acc);
+			acc = _mm256_setzero_si256();
+		}
+	}
+	*sse += hsum_epi32(acc);
+
+	_mm256_storeu_si256((__m256i *) m, vmax);
+	for (unsigned int j = 0; j < 16; j++)
+		*max_diff = max<unsigned int>(*max_diff, m[j]);
+	sse_row_c<uint16_t>(a8 + i * 2, b8 + i * 2, n - i, sse, max_diff);
+}
+
+/*
+ * Four 4x4 blocks per step.  madd leaves sums of column pairs in 32 bit
+ * lanes; adding lane pairs gives the block sums.
+ */
+template<unsigned int BPS>
+__attribute__((target("avx2")))
+static inline __m256i load16(const uint8_t *p)
+{
+	if (BPS == 1)
+		return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *) p));
+	return _mm256_loadu_si256((const __m256i *) p);
+}
+
+template<unsigned int BPS>
+__attribute__((target("avx2")))
+static void block_row_avx2(const uint8_t *a, size_t astride,
+			   const uint8_t *b, size_t bstride,
+			   unsigned int first, unsigned int nblocks,
+			   block_sums &out)
+{
+	const __m256i ones = _mm256_set1_epi16(1);
+	int32_t t[4][8];
+	unsigned int bx, y, k;
+
+	for (bx = first; bx + 4 <= nblocks; bx += 4) {
+		__m256i s1 = _mm256_setzero_si256();
+		__m256i s2 = _mm256_setzero_si256();
+		__m256i ss = _mm256_setzero_si256();
+		__m256i s12 = _mm256_setzero_si256();
+
+		for (y = 0; y < 4; y++) {
+			__m256i va = load16<BPS>(a + y * astride + bx * 4 * BPS);
+			__m256i vb = load16<BPS>(b + y * bstride + bx * 4 * BPS);
+
+			s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(va, ones));
+			s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(vb, ones));
+			ss = _mm256_add_epi32(ss, _mm256_madd_epi16(va, va));
+			ss = _mm256_add_epi32(ss, _mm256_madd_epi16(vb, vb));
+			s12 = _mm256_add_epi32(s12, _mm256_madd_epi16(va, vb));
+		}
+		_mm256_storeu_si256((__m256i *) t[0], s1);
+		_mm256_storeu_si256((__m256i *) t[1], s2);
+		_mm256_storeu_si256((__m256i *) t[2], ss);
+		_mm256_storeu_si256((__m256i *) t[3], s12);
+		for (k = 0; k < 4; k++) {
+			out.s1[bx + k] = t[0][2 * k] + t[0][2 * k + 1];
+			out.s2[bx + k] = t[1][2 * k] + t[1][2 * k + 1];
+			out.ss[bx + k] = t[2][2 * k] + t[2][2 * k + 1];
+			out.s12[bx + k] = t[3][2 * k] + t[3][2 * k + 1];
+		}
+	}
+	if (BPS == 1)
+		block_row_c<uint8_t>(a, astride, b, bstride, bx, nblocks, out);
+	else
+		block_row_c<uint16_t>(a, astride, b, bstride, bx, nblocks, out);
+}
+
+#endif /* COMPARE_X86 */
+
+typedef void (*sse_row_fn)(const uint8_t *, const uint8_t *, unsigned int,
+			   uint64_t *, unsigned int *);
+typedef void (*block_row_fn)(const uint8_t *, size_t, const uint8_t *, size_t,
+			     unsigned int, unsigned int, block_sums &);
+
+struct kernels {
+	const char *name;
+	sse_row_fn sse_row;
+	block_row_fn block_row;
+};
+
+static kernels pick_kernels(unsigned int depth, bool scalar)
+{
+	kernels k;
+
+	k.name = "scalar";
+	if (depth == 8) {
+		k.sse_row = sse_row_c<uint8_t>;
+		k.block_row = block_row_c<uint8_t>;
+	} else {
+		k.sse_row = sse_row_c<uint16_t>;
+		k.block_row = block_row_c<uint16_t>;
+	}
+#ifdef COMPARE_X86
+	if (!scalar && __builtin_cpu_supports("avx2")) {
+		k.name = "avx2";
+		if (depth == 8) {
+			k.sse_row = sse_row8_avx2;
+			k.block_row = block_row_avx2<1>;
+		} else {
+			k.sse_row = sse_row16_avx2;
+			k.block_row = block_row_avx2<2>;
+		}
+	}
+#endif
+	return k;
+}
+
+/* s1, s2, ss, s12 summed over an 8x8 window.  */
+static double ssim_window(double s1, double s2, double ss, double s12,
+			  double c1, double c2)
+{
+	double vars = ss * 64 - s1 * s1 - s2 * s2;
+	double covar = s12 * 64 - s1 * s2;
+
+	return (2 * s1 * s2 + c1) * (2 * covar + c2) /
+	       ((s1 * s1 + s2 * s2 + c1) * (vars + c2));
+}
+
+/*
+ * One tile: lines [y0, y1) for the squared error, and the SSIM windows
+ * whose top block row starts in the tile.
+ */
+static void compare_tile(const plane &a, const plane &b, unsigned int y0,
+			 unsigned int y1, unsigned int depth,
+			 const kernels &k, plane_stats &st)
+{
+	double peak = (1 << depth) - 1;
+	double c1 = .01 * .01 * peak * peak * 64;
+	double c2 = .03 * .03 * peak * peak * 64 * 63;
+	unsigned int nbx = a.width / 4, nby = a.height / 4;
+	unsigned int by, bx, y;
+	block_sums rows[2];
+
+	st.sse = 0;
+	st.max_diff = 0;
+	st.ssim_sum = 0;
+	st.ssim_windows = 0;
+
+	for (y = y0; y < y1; y++) {
+		k.sse_row(a.data + y * a.stride, b.data + y * b.stride,
+			  a.width, &st.sse, &st.max_diff);
+	}
+
+	if (nbx < 2 || nby < 2)
+		return;
+	rows[0].resize(nbx);
+	rows[1].resize(nbx);
+	for (by = y0 / 4; by < y1 / 4 && by + 1 < nby; by++) {
+		block_sums &top = rows[by & 1], &bot = rows[(by + 1) & 1];
+
+		if (by == y0 / 4) {
+			k.block_row(a.data + by * 4 * a.stride, a.stride,
+				    b.data + by * 4 * b.stride, b.stride,
+				    0, nbx, top);
+		}
+		k.block_row(a.data + (by + 1) * 4 * a.stride, a.stride,
+			    b.data + (by + 1) * 4 * b.stride, b.stride,
+			    0, nbx, bot);
+
+		for (bx = 0; bx + 1 < nbx; bx++) {
+			st.ssim_sum += ssim_window(
+				(double) top.s1[bx] + top.s1[bx + 1] +
+				bot.s1[bx] + bot.s1[bx + 1],
+				(double) top.s2[bx] + top.s2[bx + 1] +
+				bot.s2[bx] + bot.s2[bx + 1],
+				(double) top.ss[bx] + top.ss[bx + 1] +
+				bot.ss[bx] + bot.ss[bx + 1],
+				(double) top.s12[bx] + top.s12[bx + 1] +
+				bot.s12[bx] + bot.s12[bx + 1], c1, c2);
+		}
+		st.ssim_windows += nbx - 1;
+	}
+}
+
+struct tile_job {
+	unsigned int plane;
+	unsigned int y0, y1;
+	plane_stats st;
+};
+
+static void compare_frame(const frame &a, const frame &b, unsigned int depth,
+			  const kernels &k, unsigned int nthreads,
+			  plane_stats out[3])
+{
+	vector<tile_job> jobs;
+	vector<thread> workers;
+	atomic<unsigned int> next(0);
+	unsigned int p, y, i;
+
+	for (p = 0; p < 3; p++) {
+		for (y = 0; y < a.p[p].height; y += TILE_LINES) {
+			tile_job j;
+
+			j.plane = p;
+			j.y0 = y;
+			j.y1 = min(y + TILE_LINES, a.p[p].height);
+			jobs.push_back(j);
+		}
+	}
+
+	auto work = [&]() {
+		unsigned int n;
+
+		while ((n = next++) < jobs.size()) {
+			tile_job &j = jobs[n];
+
+			compare_tile(a.p[j.plane], b.p[j.plane], j.y0, j.y1,
+				     depth, k, j.st);
+		}
+	};
+	for (i = 1; i < nthreads; i++)
+		workers.push_back(thread(work));
+	work();
+	for (i = 0; i < workers.size(); i++)
+		workers[i].join();
+
+	for (p = 0; p < 3; p++)
+		memset(&out[p], 0, sizeof out[p]);
+	for (i = 0; i < jobs.size(); i++) {
+		plane_stats &o = out[jobs[i].plane];
+
+		o.sse += jobs[i].st.sse;
+		o.max_diff = max(o.max_diff, jobs[i].st.max_diff);
+		o.ssim_sum += jobs[i].st.ssim_sum;
+		o.ssim_windows += jobs[i].st.ssim_windows;
+	}
+}
+
+static double psnr(uint64_t sse, uint64_t samples, unsigned int depth)
+{
+	double peak = (1 << depth) - 1;
+
+	if (sse == 0)
+		return PSNR_CAP;
+	return min(PSNR_CAP, 10 * log10(peak * peak * samples / sse));
+}
+
+static double ssim(const plane_stats &st)
+{
+	return st.ssim_windows ? st.ssim_sum / st.ssim_windows : 1.0;
+}
+
+struct totals {
+	uint64_t sse;
+	uint64_t samples;
+	double psnr_sum, psnr_min;
+	double ssim_sum, ssim_min;
+	unsigned int max_diff;
+};
+
+static void usage(void)
+{
+	fprintf(stderr,
+		"usage: vcu_compare [options] <golden> <test>\n"
+		"  inputs are Y4M files or FMT:path raw files, FMT one of\n"
+		"  i420 i422 nv12 nv16 tnv12 tnv16 (VCU tiled)\n"
+		"  --size WxH         raw frame size\n"
+		"  --depth 8|10       raw bit depth (8)\n"
+		"  --frames N         compare at most N frames\n"
+		"  --skip N           skip N frames of the test sequence\n"
+		"  --threads N        worker threads (all CPUs)\n"
+		"  --min-psnr DB      fail if any plane of any frame is below\n"
+		"  --min-ssim S       fail if any plane of any frame is below\n"
+		"  --max-diff N       fail if any sample differs by more\n"
+		"  --per-frame        print every frame\n"
+		"  --scalar           do not use AVX2\n");
+	exit(2);
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	static const char *names[3] = { "Y", "U", "V" };
+	unsigned int width = 0, height = 0, depth = 8;
+	unsigned int max_frames = ~0U, skip = 0;
+	unsigned int nthreads = thread::hardware_concurrency();
+	double min_psnr = -1, min_ssim = -1;
+	int max_diff = -1;
+	bool per_frame = false, scalar = false;
+	vector<string> files;
+	source golden, test;
+	totals tot[3];
+	unsigned int frames = 0, p;
+	bool pass = true, extra = false;
+	double start, elapsed;
+	frame fa, fb;
+	kernels k;
+	int i;
+
+	for (i = 1; i < argc; i++) {
+		string arg = argv[i];
+
+		if (arg[0] != '-' || arg == "-") {
+			files.push_back(arg);
+			continue;
+		}
+		if (arg == "--per-frame") {
+			per_frame = true;
+			continue;
+		}
+		if (arg == "--scalar") {
+			scalar = true;
+			continue;
+		}
+		if (i + 1 >= argc)
+			usage();
+		if (arg == "--size") {
+			if (sscanf(argv[++i], "%ux%u", &width, &height) != 2)
+				usage();
+		} else if (arg == "--depth") {
+			depth = atoi(argv[++i]);
+		} else if (arg == "--frames") {
+			max_frames = atoi(argv[++i]);
+		} else if (arg == "--skip") {
+			skip = atoi(argv[++i]);
+		} else if (arg == "--threads") {
+			nthreads = atoi(argv[++i]);
+		} else if (arg == "--min-psnr") {
+			min_psnr = atof(argv[++i]);
+		} else if (arg == "--min-ssim") {
+			min_ssim = atof(argv[++i]);
+		} else if (arg == "--max-diff") {
+			max_diff = atoi(argv[++i]);
+		} else {
+			usage();
+		}
+	}
+	if (files.size() != 2)
+		usage();
+	if (nthreads == 0)
+		nthreads = 1;
+
+	if (!golden.open(files[0], width, height, depth) ||
+	    !test.open(files[1], width, height, depth))
+		return 2;
+	if (golden.width != test.width || golden.height != test.height ||
+	    golden.depth != test.depth || golden.chroma422 != test.chroma422) {
+		fprintf(stderr, "format mismatch: golden %s, test %s\n",
+			golden.describe().c_str(), test.describe().c_str());
+		return 2;
+	}
+	k = pick_kernels(golden.depth, scalar);
+
+	while (skip > 0 && test.next(fb))
+		skip--;
+
+	for (p = 0; p < 3; p++) {
+		memset(&tot[p], 0, sizeof tot[p]);
+		tot[p].psnr_min = PSNR_CAP;
+		tot[p].ssim_min = 1.0;
+	}
+
+	start = now();
+	while (frames < max_frames) {
+		bool more_golden = golden.next(fa), more_test = test.next(fb);
+		plane_stats st[3];
+
+		/* Sequences of different lengths are a failure in themselves.  */
+		if (!more_golden || !more_test) {
+			extra = more_golden != more_test;
+			break;
+		}
+
+		compare_frame(fa, fb, golden.depth, k, nthreads, st);
+		if (per_frame)
+			printf("frame %5u:", frames);
+		for (p = 0; p < 3; p++) {
+			uint64_t samples = (uint64_t) fa.p[p].width * fa.p[p].height;
+			double ps = psnr(st[p].sse, samples, golden.depth);
+			double ss = ssim(st[p]);
+
+			tot[p].sse += st[p].sse;
+			tot[p].samples += samples;
+			tot[p].psnr_sum += ps;
+			tot[p].psnr_min = min(tot[p].psnr_min, ps);
+			tot[p].ssim_sum += ss;
+			tot[p].ssim_min = min(tot[p].ssim_min, ss);
+			tot[p].max_diff = max(tot[p].max_diff, st[p].max_diff);
+			if (per_frame)
+				printf("  %s %6.2f dB %.5f %4u", names[p], ps,
+				       ss, st[p].max_diff);
+		}
+		if (per_frame)
+			printf("\n");
+		frames++;
+	}
+	elapsed = now() - start;
+
+	printf("golden %s, test %s, %s, %u frames\n\n",
+	       files[0].c_str(), files[1].c_str(), golden.describe().c_str(),
+	       frames);
+	printf("plane  psnr avg  psnr min  psnr all  ssim avg  ssim min  max diff\n");
+	for (p = 0; p < 3 && frames; p++) {
+		printf("%-5s %9.2f %9.2f %9.2f %9.5f %9.5f %9u\n", names[p],
+		       tot[p].psnr_sum / frames, tot[p].psnr_min,
+		       psnr(tot[p].sse, tot[p].samples, golden.depth),
+		       tot[p].ssim_sum / frames, tot[p].ssim_min,
+		       tot[p].max_diff);
+		if (min_psnr >= 0 && tot[p].psnr_min < min_psnr)
+			pass = false;
+		if (min_ssim >= 0 && tot[p].ssim_min < min_ssim)
+			pass = false;
+		if (max_diff >= 0 && tot[p].max_diff > (unsigned int) max_diff)
+			pass = false;
+	}
+	if (frames == 0) {
+		printf("no frames compared\n");
+		pass = false;
+	}
+	if (extra) {
+		printf("sequence lengths differ\n");
+		pass = false;
+	}
+	printf("\n%s\n", pass ? "PASS" : "FAIL");
+	fprintf(stderr, "%u frames in %.3f s (%.1f fps, %u threads, %s)\n",
+		frames, elapsed, frames / max(elapsed, 1e-9), nthreads, k.name);
+	return pass ? 0 : 1;
+}
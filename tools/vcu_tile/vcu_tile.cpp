@@ -0,0 +1,588 @@
+/*
+ * VCU tiled frame buffer layouts.
+ *
+ * Every conversion is done one plane line at a time: a linear line is
+ * made of one row out of each tile along a band, so a line kernel copies
+ * (or packs/unpacks) n chunks between two strided sequences.  The
+ * kernels only differ in how one chunk is moved.
+ *
+ * The 10 bit kernels pick two bytes per sample with a byte shuffle, then
+ * use a 16 bit multiply by 2^(6 - shift) followed by a right shift of 6
+ * to extract each sample, since there is no variable 16 bit shift below
+ * AVX-512.  Packing goes the other way with a multiply-add of sample
+ * pairs into 20 bit words and a 64 bit merge into 40 bit groups.
+ */
+
+#include <string.h>
+
+#include "vcu_tile.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VCU_TILE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__)
+#define VCU_TILE_NEON 1
+#include <arm_neon.h>
+#endif
+
+/* Byte pairs holding each sample of an 8 sample, 10 byte group.  */
+#define UNPACK10_SHUF \
+	0, 1, 1, 2, 2, 3, 3, 4, 5, 6, 6, 7, 7, 8, 8, 9
+#define PACK10_SHUF \
+	0, 1, 2, 3, 4, 8, 9, 10, 11, 12, -1, -1, -1, -1, -1, -1
+
+typedef void (*line_fn)(const uint8_t *src, size_t src_step,
+			uint8_t *dst, size_t dst_step,
+			unsigned int n, unsigned int samples);
+
+struct line_kernels {
+	line_fn copy8;
+	line_fn unpack10;
+	line_fn pack10;
+};
+
+/* Scalar.  */
+
+static void copy8_c(const uint8_t *src, size_t src_step,
+		    uint8_t *dst, size_t dst_step,
+		    unsigned int n, unsigned int samples)
+{
+	unsigned int i;
+
+	for (i = 0; i < n; i++) {
+		memcpy(dst, src, samples);
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+static inline void unpack10_group_c(const uint8_t *src, uint16_t *dst)
+{
+	uint64_t v;
+
+	v = (uint64_t) src[0] | (uint64_t) src[1] << 8 |
+	    (uint64_t) src[2] << 16 | (uint64_t) src[3] << 24 |
+	    (uint64_t) src[4] << 32;
+	dst[0] = v & 0x3ff;
+	dst[1] = (v >> 10) & 0x3ff;
+	dst[2] = (v >> 20) & 0x3ff;
+	dst[3] = (v >> 30) & 0x3ff;
+}
+
+static inline void pack10_group_c(const uint16_t *src, uint8_t *dst)
+{
+	uint64_t v;
+
+	v = (uint64_t) (src[0] & 0x3ff) |
+	    (uint64_t) (src[1] & 0x3ff) << 10 |
+	    (uint64_t) (src[2] & 0x3ff) << 20 |
+	    (uint64_t) (src[3] & 0x3ff) << 30;
+	dst[0] = v;
+	dst[1] = v >> 8;
+	dst[2] = v >> 16;
+	dst[3] = v >> 24;
+	dst[4] = v >> 32;
+}
+
+static void unpack10_c(const uint8_t *src, size_t src_step,
+		       uint8_t *dst, size_t dst_step,
+		       unsigned int n, unsigned int samples)
+{
+	unsigned int i, j;
+	uint16_t tmp[4];
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < samples; j += 4) {
+			unpack10_group_c(src + j / 4 * 5, tmp);
+			/* dst is not necessarily 16 bit aligned.  */
+			memcpy(dst + j * 2, tmp, sizeof tmp);
+		}
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+static void pack10_c(const uint8_t *src, size_t src_step,
+		     uint8_t *dst, size_t dst_step,
+		     unsigned int n, unsigned int samples)
+{
+	unsigned int i, j;
+	uint16_t tmp[4];
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < samples; j += 4) {
+			memcpy(tmp, src + j * 2, sizeof tmp);
+			pack10_group_c(tmp, dst + j / 4 * 5);
+		}
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+static const struct line_kernels kernels_c = {
+	copy8_c, unpack10_c, pack10_c,
+};
+
+#ifdef VCU_TILE_X86
+
+/*
+ * The SIMD loads of a 10 byte group read 16 bytes, and the stores write
+ * 16.  The overrun stays inside the chunk except for the last group of a
+ * chunk, which goes through a bounce buffer so that neither end of the
+ * frame is touched.
+ */
+
+__attribute__((target("ssse3")))
+static inline __m128i unpack10_ssse3(__m128i v)
+{
+	const __m128i shuf = _mm_setr_epi8(UNPACK10_SHUF);
+	const __m128i mul = _mm_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1);
+
+	v = _mm_shuffle_epi8(v, shuf);
+	v = _mm_mullo_epi16(v, mul);
+	return _mm_srli_epi16(v, 6);
+}
+
+__attribute__((target("ssse3")))
+static inline __m128i pack10_ssse3(__m128i v)
+{
+	const __m128i mask = _mm_set1_epi16(0x3ff);
+	const __m128i mul = _mm_setr_epi16(1, 1024, 1, 1024, 1, 1024, 1, 1024);
+	const __m128i lo32 = _mm_set_epi32(0, -1, 0, -1);
+	const __m128i shuf = _mm_setr_epi8(PACK10_SHUF);
+
+	v = _mm_madd_epi16(_mm_and_si128(v, mask), mul);
+	v = _mm_or_si128(_mm_and_si128(v, lo32),
+			 _mm_slli_epi64(_mm_srli_epi64(v, 32), 20));
+	return _mm_shuffle_epi8(v, shuf);
+}
+
+__attribute__((target("ssse3")))
+static void copy8_ssse3(const uint8_t *src, size_t src_step,
+			uint8_t *dst, size_t dst_step,
+			unsigned int n, unsigned int samples)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < samples; j += 16) {
+			__m128i v;
+
+			v = _mm_loadu_si128((const __m128i *) (src + j));
+			_mm_storeu_si128((__m128i *) (dst + j), v);
+		}
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+__attribute__((target("ssse3")))
+static void unpack10_ssse3_line(const uint8_t *src, size_t src_step,
+				uint8_t *dst, size_t dst_step,
+				unsigned int n, unsigned int samples)
+{
+	uint8_t bounce[16];
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j + 8 < samples; j += 8) {
+			__m128i v;
+
+			v = _mm_loadu_si128((const __m128i *) (src + j / 8 * 10));
+			_mm_storeu_si128((__m128i *) (dst + j * 2),
+					 unpack10_ssse3(v));
+		}
+		memcpy(bounce, src + j / 8 * 10, 10);
+		_mm_storeu_si128((__m128i *) (dst + j * 2),
+				 unpack10_ssse3(_mm_loadu_si128((const __m128i *) bounce)));
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+__attribute__((target("ssse3")))
+static void pack10_ssse3_line(const uint8_t *src, size_t src_step,
+			      uint8_t *dst, size_t dst_step,
+			      unsigned int n, unsigned int samples)
+{
+	uint8_t bounce[16];
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j + 8 < samples; j += 8) {
+			__m128i v;
+
+			v = _mm_loadu_si128((const __m128i *) (src + j * 2));
+			_mm_storeu_si128((__m128i *) (dst + j / 8 * 10),
+					 pack10_ssse3(v));
+		}
+		_mm_storeu_si128((__m128i *) bounce,
+				 pack10_ssse3(_mm_loadu_si128((const __m128i *) (src + j * 2))));
+		memcpy(dst + j / 8 * 10, bounce, 10);
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+static const struct line_kernels kernels_ssse3 = {
+	copy8_ssse3, unpack10_ssse3_line, pack10_ssse3_line,
+};
+
+__attribute__((target("avx2")))
+static inline __m256i unpack10_avx2(const uint8_t *p)
+{
+	const __m256i shuf = _mm256_setr_epi8(UNPACK10_SHUF, UNPACK10_SHUF);
+	const __m256i mul = _mm256_setr_epi16(64, 16, 4, 1, 64, 16, 4, 1,
+					      64, 16, 4, 1, 64, 16, 4, 1);
+	__m256i v;
+
+	/* Two 10 byte groups, one per 128 bit lane.  */
+	v = _mm256_inserti128_si256(
+		_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *) p)),
+		_mm_loadu_si128((const __m128i *) (p + 10)), 1);
+	v = _mm256_shuffle_epi8(v, shuf);
+	v = _mm256_mullo_epi16(v, mul);
+	return _mm256_srli_epi16(v, 6);
+}
+
+__attribute__((target("avx2")))
+static inline void pack10_avx2(__m256i v, uint8_t *p)
+{
+	const __m256i mask = _mm256_set1_epi16(0x3ff);
+	const __m256i mul = _mm256_setr_epi16(1, 1024, 1, 1024, 1, 1024, 1, 1024,
+					      1, 1024, 1, 1024, 1, 1024, 1, 1024);
+	const __m256i lo32 = _mm256_set_epi32(0, -1, 0, -1, 0, -1, 0, -1);
+	const __m256i shuf = _mm256_setr_epi8(PACK10_SHUF, PACK10_SHUF);
+
+	v = _mm256_madd_epi16(_mm256_and_si256(v, mask), mul);
+	v = _mm256_or_si256(_mm256_and_si256(v, lo32),
+			    _mm256_slli_epi64(_mm256_srli_epi64(v, 32), 20));
+	v = _mm256_shuffle_epi8(v, shuf);
+	/* The high lane store overwrites the low lane's padding.  */
+	_mm_storeu_si128((__m128i *) p, _mm256_castsi256_si128(v));
+	_mm_storeu_si128((__m128i *) (p + 10), _mm256_extracti128_si256(v, 1));
+}
+
+__attribute__((target("avx2")))
+static void copy8_avx2(const uint8_t *src, size_t src_step,
+		       uint8_t *dst, size_t dst_step,
+		       unsigned int n, unsigned int samples)
+{
+	unsigned int i, j;
+
+	if (samples % 32) {
+		copy8_ssse3(src, src_step, dst, dst_step, n, samples);
+		return;
+	}
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < samples; j += 32) {
+			__m256i v;
+
+			v = _mm256_loadu_si256((const __m256i *) (src + j));
+			_mm256_storeu_si256((__m256i *) (dst + j), v);
+		}
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+__attribute__((target("avx2")))
+static void unpack10_avx2_line(const uint8_t *src, size_t src_step,
+			       uint8_t *dst, size_t dst_step,
+			       unsigned int n, unsigned int samples)
+{
+	uint8_t bounce[32];
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j + 16 < samples; j += 16) {
+			_mm256_storeu_si256((__m256i *) (dst + j * 2),
+					    unpack10_avx2(src + j / 8 * 10));
+		}
+		memcpy(bounce, src + j / 8 * 10, 20);
+		_mm256_storeu_si256((__m256i *) (dst + j * 2),
+				    unpack10_avx2(bounce));
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+__attribute__((target("avx2")))
+static void pack10_avx2_line(const uint8_t *src, size_t src_step,
+			     uint8_t *dst, size_t dst_step,
+			     unsigned int n, unsigned int samples)
+{
+	uint8_t bounce[32];
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j + 16 < samples; j += 16) {
+			pack10_avx2(_mm256_loadu_si256((const __m256i *) (src + j * 2)),
+				    dst + j / 8 * 10);
+		}
+		pack10_avx2(_mm256_loadu_si256((const __m256i *) (src + j * 2)),
+			    bounce);
+		memcpy(dst + j / 8 * 10, bounce, 20);
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+static const struct line_kernels kernels_avx2 = {
+	copy8_avx2, unpack10_avx2_line, pack10_avx2_line,
+};
+
+#endif /* VCU_TILE_X86 */
+
+#ifdef VCU_TILE_NEON
+
+static void copy8_neon(const uint8_t *src, size_t src_step,
+		       uint8_t *dst, size_t dst_step,
+		       unsigned int n, unsigned int samples)
+{
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < samples; j += 16) {
+			vst1q_u8(dst + j, vld1q_u8(src + j));
+		}
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+static inline uint16x8_t unpack10_neon(const uint8_t *p)
+{
+	static const uint8_t shuf[16] = { UNPACK10_SHUF };
+	static const uint16_t mul[8] = { 64, 16, 4, 1, 64, 16, 4, 1 };
+	uint16x8_t v;
+
+	v = vreinterpretq_u16_u8(vqtbl1q_u8(vld1q_u8(p), vld1q_u8(shuf)));
+	return vshrq_n_u16(vmulq_u16(v, vld1q_u16(mul)), 6);
+}
+
+static void unpack10_neon_line(const uint8_t *src, size_t src_step,
+			       uint8_t *dst, size_t dst_step,
+			       unsigned int n, unsigned int samples)
+{
+	uint8_t bounce[16];
+	unsigned int i, j;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j + 8 < samples; j += 8) {
+			vst1q_u8(dst + j * 2, vreinterpretq_u8_u16(
+				 unpack10_neon(src + j / 8 * 10)));
+		}
+		memcpy(bounce, src + j / 8 * 10, 10);
+		vst1q_u8(dst + j * 2, vreinterpretq_u8_u16(unpack10_neon(bounce)));
+		src += src_step;
+		dst += dst_step;
+	}
+}
+
+/*
+ * Packing is store bound and the scalar 40 bit merge keeps up with the
+ * memory on the A53, so NEON reuses it.
+ */
+static const struct line_kernels kernels_neon = {
+	copy8_neon, unpack10_neon_line, pack10_c,
+};
+
+#endif /* VCU_TILE_NEON */
+
+static const struct line_kernels *kernels;
+
+static int isa_supported(enum vcu_tile_isa isa)
+{
+	switch (isa) {
+	case VCU_TILE_ISA_SCALAR:
+		return 1;
+#ifdef VCU_TILE_X86
+	case VCU_TILE_ISA_SSSE3:
+		return __builtin_cpu_supports("ssse3");
+	case VCU_TILE_ISA_AVX2:
+		return __builtin_cpu_supports("avx2");
+#endif
+#ifdef VCU_TILE_NEON
+	case VCU_TILE_ISA_NEON:
+		return 1;
+#endif
+	default:
+		return 0;
+	}
+}
+
+static enum vcu_tile_isa best_isa(void)
+{
+	static const enum vcu_tile_isa order[] = {
+		VCU_TILE_ISA_AVX2, VCU_TILE_ISA_NEON, VCU_TILE_ISA_SSSE3,
+	};
+	unsigned int i;
+
+	for (i = 0; i < sizeof order / sizeof order[0]; i++) {
+		if (isa_supported(order[i]))
+			return order[i];
+	}
+	return VCU_TILE_ISA_SCALAR;
+}
+
+enum vcu_tile_isa vcu_tile_set_isa(enum vcu_tile_isa isa)
+{
+	if (isa == VCU_TILE_ISA_AUTO || !isa_supported(isa))
+		isa = best_isa();
+
+	switch (isa) {
+#ifdef VCU_TILE_X86
+	case VCU_TILE_ISA_SSSE3:
+		kernels = &kernels_ssse3;
+		break;
+	case VCU_TILE_ISA_AVX2:
+		kernels = &kernels_avx2;
+		break;
+#endif
+#ifdef VCU_TILE_NEON
+	case VCU_TILE_ISA_NEON:
+		kernels = &kernels_neon;
+		break;
+#endif
+	default:
+		kernels = &kernels_c;
+		break;
+	}
+	return isa;
+}
+
+const char *vcu_tile_isa_name(enum vcu_tile_isa isa)
+{
+	switch (isa) {
+	case VCU_TILE_ISA_AUTO:
+		return "auto";
+	case VCU_TILE_ISA_SCALAR:
+		return "scalar";
+	case VCU_TILE_ISA_SSSE3:
+		return "ssse3";
+	case VCU_TILE_ISA_AVX2:
+		return "avx2";
+	case VCU_TILE_ISA_NEON:
+		return "neon";
+	}
+	return "?";
+}
+
+void vcu_tile_format_init(struct vcu_tile_format *fmt, unsigned int width,
+			  unsigned int height, unsigned int bit_depth,
+			  enum vcu_tile_chroma chroma)
+{
+	fmt->width = width;
+	fmt->height = height;
+	fmt->bit_depth = bit_depth;
+	fmt->chroma = chroma;
+	fmt->tile_w = 64;
+	fmt->tile_h = 4;
+}
+
+static unsigned int chroma_lines(const struct vcu_tile_format *fmt)
+{
+	return fmt->chroma == VCU_TILE_NV12 ? fmt->height / 2 : fmt->height;
+}
+
+int vcu_tile_format_check(const struct vcu_tile_format *fmt)
+{
+	if (fmt->bit_depth != 8 && fmt->bit_depth != 10)
+		return -1;
+	/* Whole 16 sample vectors per tile row.  */
+	if (fmt->tile_w == 0 || fmt->tile_w % 16 || fmt->tile_h == 0)
+		return -1;
+	if (fmt->width == 0 || fmt->width % fmt->tile_w)
+		return -1;
+	if (fmt->chroma == VCU_TILE_NV12 && fmt->height % 2)
+		return -1;
+	if (fmt->height == 0 || fmt->height % fmt->tile_h ||
+	    chroma_lines(fmt) % fmt->tile_h)
+		return -1;
+	return 0;
+}
+
+static size_t tiled_line_bytes(const struct vcu_tile_format *fmt)
+{
+	return (size_t) fmt->width * fmt->bit_depth / 8;
+}
+
+static size_t linear_line_bytes(const struct vcu_tile_format *fmt)
+{
+	return (size_t) fmt->width * (fmt->bit_depth == 8 ? 1 : 2);
+}
+
+size_t vcu_tile_frame_size(const struct vcu_tile_format *fmt)
+{
+	return tiled_line_bytes(fmt) * (fmt->height + chroma_lines(fmt));
+}
+
+size_t vcu_linear_frame_size(const struct vcu_tile_format *fmt)
+{
+	return linear_line_bytes(fmt) * (fmt->height + chroma_lines(fmt));
+}
+
+/*
+ * Convert one plane.  Line y of the plane is row (y % tile_h) of every
+ * tile in band (y / tile_h).
+ */
+static void convert_plane(const struct vcu_tile_format *fmt,
+			  uint8_t *tiled, uint8_t *linear,
+			  unsigned int lines, int to_linear)
+{
+	size_t tile_row = (size_t) fmt->tile_w * fmt->bit_depth / 8;
+	size_t tile_bytes = tile_row * fmt->tile_h;
+	size_t chunk = (size_t) fmt->tile_w * (fmt->bit_depth == 8 ? 1 : 2);
+	size_t band = tiled_line_bytes(fmt) * fmt->tile_h;
+	size_t stride = linear_line_bytes(fmt);
+	unsigned int ntiles = fmt->width / fmt->tile_w;
+	unsigned int y;
+	line_fn fn;
+
+	if (fmt->bit_depth == 8)
+		fn = kernels->copy8;
+	else
+		fn = to_linear ? kernels->unpack10 : kernels->pack10;
+
+	for (y = 0; y < lines; y++) {
+		uint8_t *t = tiled + y / fmt->tile_h * band +
+			     y % fmt->tile_h * tile_row;
+		uint8_t *l = linear + y * stride;
+
+		if (to_linear)
+			fn(t, tile_bytes, l, chunk, ntiles, fmt->tile_w);
+		else
+			fn(l, chunk, t, tile_bytes, ntiles, fmt->tile_w);
+	}
+}
+
+/* Only the destination is written to.  */
+static void convert(const struct vcu_tile_format *fmt,
+		    uint8_t *tiled, uint8_t *linear, int to_linear)
+{
+	size_t luma_tiled = tiled_line_bytes(fmt) * fmt->height;
+	size_t luma_linear = linear_line_bytes(fmt) * fmt->height;
+
+	if (!kernels)
+		vcu_tile_set_isa(VCU_TILE_ISA_AUTO);
+
+	convert_plane(fmt, tiled, linear, fmt->height, to_linear);
+	convert_plane(fmt, tiled + luma_tiled, linear + luma_linear,
+		      chroma_lines(fmt), to_linear);
+}
+
+void vcu_detile(const struct vcu_tile_format *fmt, const uint8_t *tiled,
+		uint8_t *linear)
+{
+	convert(fmt, (uint8_t *) tiled, linear, 1);
+}
+
+void vcu_retile(const struct vcu_tile_format *fmt, const uint8_t *linear,
+		uint8_t *tiled)
+{
+	convert(fmt, tiled, (uint8_t *) linear, 0);
+}
@@ -0,0 +1,314 @@
+/*
+ * VCU tiled frame converter.
+ *
+ * Detiles frames dumped from DDR (hardware or the cosim memory model)
+ * into linear NV12/NV16 for viewing and comparison, retiles linear
+ * frames for loading into DDR, and benchmarks the kernels.
+ *
+ * Build: g++ -std=c++11 -O2 -o vcu_tile vcu_tile_main.cpp vcu_tile.cpp
+ * Usage: vcu_tile detile|retile [options] <in> <out>
+ *        vcu_tile bench [options]
+ *
+ *   --size WxH           frame size (3840x2160)
+ *   --format nv12|nv16   chroma layout (nv12)
+ *   --depth 8|10         bit depth (8)
+ *   --tile WxH           tile size (64x4)
+ *   --isa NAME           auto, scalar, ssse3, avx2 or neon (auto)
+ *   --seconds S          bench: time per measurement (0.5)
+ *
+ * detile/retile convert every whole frame in <in>.  bench runs every
+ * layout on 4096x2160 frames (unless --size is given) with every ISA the
+ * CPU supports, checks that each ISA round trips and matches the scalar
+ * kernels, and prints GB/s counting the bytes read plus bytes written.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+#include <vector>
+
+#include "vcu_tile.h"
+
+using namespace std;
+
+static void usage(void)
+{
+	fprintf(stderr,
+		"usage: vcu_tile detile|retile [options] <in> <out>\n"
+		"       vcu_tile bench [options]\n"
+		"  --size WxH           frame size (3840x2160)\n"
+		"  --format nv12|nv16   chroma layout (nv12)\n"
+		"  --depth 8|10         bit depth (8)\n"
+		"  --tile WxH           tile size (64x4)\n"
+		"  --isa NAME           auto, scalar, ssse3, avx2 or neon\n"
+		"  --seconds S          bench: time per measurement (0.5)\n");
+	exit(2);
+}
+
+static int parse_isa(const char *s, enum vcu_tile_isa *isa)
+{
+	static const enum vcu_tile_isa all[] = {
+		VCU_TILE_ISA_AUTO, VCU_TILE_ISA_SCALAR, VCU_TILE_ISA_SSSE3,
+		VCU_TILE_ISA_AVX2, VCU_TILE_ISA_NEON,
+	};
+	unsigned int i;
+
+	for (i = 0; i < sizeof all / sizeof all[0]; i++) {
+		if (!strcmp(s, vcu_tile_isa_name(all[i]))) {
+			*isa = all[i];
+			return 0;
+		}
+	}
+	return -1;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static int convert_file(const struct vcu_tile_format *fmt, int detile,
+			const char *in_name, const char *out_name)
+{
+	size_t in_size, out_size;
+	unsigned int frames = 0;
+	FILE *in, *out;
+	int ret = 0;
+
+	in_size = detile ? vcu_tile_frame_size(fmt) : vcu_linear_frame_size(fmt);
+	out_size = detile ? vcu_linear_frame_size(fmt) : vcu_tile_frame_size(fmt);
+	vector<uint8_t> src(in_size), dst(out_size);
+
+	in = fopen(in_name, "rb");
+	if (!in) {
+		perror(in_name);
+		return 1;
+	}
+	out = fopen(out_name, "wb");
+	if (!out) {
+		perror(out_name);
+		fclose(in);
+		return 1;
+	}
+
+	while (fread(&src[0], 1, in_size, in) == in_size) {
+		if (detile)
+			vcu_detile(fmt, &src[0], &dst[0]);
+		else
+			vcu_retile(fmt, &src[0], &dst[0]);
+		if (fwrite(&dst[0], 1, out_size, out) != out_size) {
+			perror(out_name);
+			ret = 1;
+			break;
+		}
+		frames++;
+	}
+	if (!ferror(in) && !feof(in))
+		ret = 1;
+	if (fclose(out)) {
+		perror(out_name);
+		ret = 1;
+	}
+	fclose(in);
+
+	fprintf(stderr, "%u frame(s), %zu -> %zu bytes each\n",
+		frames, in_size, out_size);
+	if (frames == 0) {
+		fprintf(stderr, "%s: shorter than one frame\n", in_name);
+		ret = 1;
+	}
+	return ret;
+}
+
+/* Returns GB/s, read plus write.  */
+static double bench_one(const struct vcu_tile_format *fmt, int detile,
+			vector<uint8_t> &tiled, vector<uint8_t> &linear,
+			double seconds)
+{
+	unsigned int iters = 0;
+	double start, elapsed;
+
+	start = now();
+	do {
+		if (detile)
+			vcu_detile(fmt, &tiled[0], &linear[0]);
+		else
+			vcu_retile(fmt, &linear[0], &tiled[0]);
+		iters++;
+		elapsed = now() - start;
+	} while (elapsed < seconds);
+
+	return (double) (tiled.size() + linear.size()) * iters / elapsed / 1e9;
+}
+
+static int bench(unsigned int width, unsigned int height,
+		 unsigned int tile_w, unsigned int tile_h,
+		 enum vcu_tile_isa only, double seconds)
+{
+	static const enum vcu_tile_isa isas[] = {
+		VCU_TILE_ISA_SCALAR, VCU_TILE_ISA_SSSE3,
+		VCU_TILE_ISA_AVX2, VCU_TILE_ISA_NEON,
+	};
+	static const enum vcu_tile_chroma chromas[] = {
+		VCU_TILE_NV12, VCU_TILE_NV16,
+	};
+	static const unsigned int depths[] = { 8, 10 };
+	unsigned int c, d, i, j;
+	int ret = 0;
+
+	printf("%ux%u, %ux%u tiles, GB/s = (read + written) / time\n\n",
+	       width, height, tile_w, tile_h);
+	printf("%-12s %-7s %10s %10s %8s %8s\n", "layout", "isa",
+	       "detile", "retile", "det fps", "ret fps");
+
+	for (c = 0; c < 2; c++) {
+		for (d = 0; d < 2; d++) {
+			struct vcu_tile_format fmt;
+			char layout[32];
+
+			vcu_tile_format_init(&fmt, width, height, depths[d],
+					     chromas[c]);
+			fmt.tile_w = tile_w;
+			fmt.tile_h = tile_h;
+			if (vcu_tile_format_check(&fmt)) {
+				fprintf(stderr, "unsupported frame/tile size\n");
+				return 1;
+			}
+			snprintf(layout, sizeof layout, "%s %u-bit",
+				 c ? "NV16" : "NV12", depths[d]);
+
+			vector<uint8_t> tiled(vcu_tile_frame_size(&fmt));
+			vector<uint8_t> linear(vcu_linear_frame_size(&fmt));
+			vector<uint8_t> ref(linear.size()), back(tiled.size());
+
+			/* Random tiled data; 10 bit groups are all valid.  */
+			srand(1);
+			for (j = 0; j < tiled.size(); j++)
+				tiled[j] = rand();
+			vcu_tile_set_isa(VCU_TILE_ISA_SCALAR);
+			vcu_detile(&fmt, &tiled[0], &ref[0]);
+
+			for (i = 0; i < sizeof isas / sizeof isas[0]; i++) {
+				double det_gbs, ret_gbs;
+				int ok;
+
+				if (only != VCU_TILE_ISA_AUTO && isas[i] != only)
+					continue;
+				if (vcu_tile_set_isa(isas[i]) != isas[i])
+					continue;
+
+				memset(&linear[0], 0, linear.size());
+				memset(&back[0], 0, back.size());
+				vcu_detile(&fmt, &tiled[0], &linear[0]);
+				vcu_retile(&fmt, &linear[0], &back[0]);
+				ok = linear == ref && back == tiled;
+
+				det_gbs = bench_one(&fmt, 1, tiled, linear, seconds);
+				ret_gbs = bench_one(&fmt, 0, back, linear, seconds);
+				printf("%-12s %-7s %10.2f %10.2f %8.0f %8.0f%s\n",
+				       layout, vcu_tile_isa_name(isas[i]),
+				       det_gbs, ret_gbs,
+				       det_gbs * 1e9 / (tiled.size() + linear.size()),
+				       ret_gbs * 1e9 / (tiled.size() + linear.size()),
+				       ok ? "" : "  MISMATCH");
+				if (!ok)
+					ret = 1;
+			}
+		}
+	}
+	return ret;
+}
+
+static int parse_size(const char *s, unsigned int *w, unsigned int *h)
+{
+	return sscanf(s, "%ux%u", w, h) == 2 ? 0 : -1;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned int width = 3840, height = 2160, depth = 8;
+	unsigned int tile_w = 64, tile_h = 4;
+	enum vcu_tile_chroma chroma = VCU_TILE_NV12;
+	enum vcu_tile_isa isa = VCU_TILE_ISA_AUTO;
+	bool size_given = false;
+	double seconds = 0.5;
+	vector<const char *> files;
+	struct vcu_tile_format fmt;
+	string cmd;
+	int i;
+
+	if (argc < 2)
+		usage();
+	cmd = argv[1];
+
+	for (i = 2; i < argc; i++) {
+		string arg = argv[i];
+
+		if (arg[0] != '-' || arg == "-") {
+			files.push_back(argv[i]);
+			continue;
+		}
+		if (i + 1 >= argc)
+			usage();
+		if (arg == "--size") {
+			if (parse_size(argv[++i], &width, &height))
+				usage();
+			size_given = true;
+		} else if (arg == "--format") {
+			string f = argv[++i];
+
+			if (f == "nv12")
+				chroma = VCU_TILE_NV12;
+			else if (f == "nv16")
+				chroma = VCU_TILE_NV16;
+			else
+				usage();
+		} else if (arg == "--depth") {
+			depth = atoi(argv[++i]);
+		} else if (arg == "--tile") {
+			if (parse_size(argv[++i], &tile_w, &tile_h))
+				usage();
+		} else if (arg == "--isa") {
+			if (parse_isa(argv[++i], &isa))
+				usage();
+		} else if (arg == "--seconds") {
+			seconds = atof(argv[++i]);
+		} else {
+			usage();
+		}
+	}
+
+	if (cmd == "bench") {
+		if (!files.empty())
+			usage();
+		if (!size_given) {
+			width = 4096;
+			height = 2160;
+		}
+		return bench(width, height, tile_w, tile_h, isa, seconds);
+	}
+	if ((cmd != "detile" && cmd != "retile") || files.size() != 2)
+		usage();
+
+	vcu_tile_format_init(&fmt, width, height, depth, chroma);
+	fmt.tile_w = tile_w;
+	fmt.tile_h = tile_h;
+	if (vcu_tile_format_check(&fmt)) {
+		fprintf(stderr, "unsupported format: width must be a multiple "
+			"of the tile width (itself a multiple of 16), plane "
+			"heights of the tile height, depth 8 or 10\n");
+		return 2;
+	}
+	if (vcu_tile_set_isa(isa) != isa && isa != VCU_TILE_ISA_AUTO)
+		fprintf(stderr, "%s not supported, using %s\n",
+			vcu_tile_isa_name(isa),
+			vcu_tile_isa_name(vcu_tile_set_isa(VCU_TILE_ISA_AUTO)));
+
+	return convert_file(&fmt, cmd == "detile", files[0], files[1]);
+}